@@ -26,26 +26,18 @@
 #include "CanAlertAction.h"
 #include "CanAlertHandlers.h"
 #include "CanBus.h"
-#include "CanPayloadAction.h"
 
-CanAlertAction::CanAlertAction(
-    CanAlertHandlers& handlers,
-    CanBus& can_bus,
-    CanPayloadAction& payload_action) :
-        handlers(handlers),
-        can_bus(can_bus),
-        payload_action(payload_action) {
+CanAlertAction::CanAlertAction(CanBus& can_bus) :
+        handlers(NULL),
+        can_bus(can_bus) {
 }
 
 void CanAlertAction::run(void) {
   uint32_t alerts;
-  while(payload_action.run_stop_flag()) {
-    CanApi& can_api = can_bus.get_can_api();
-    while (payload_action.run_stop_flag()) {
-      if (ESP_OK == can_api.read_alerts(alerts, 20)) {
-        handlers.forward_alerts(alerts, can_bus);
-      }
+  CanApi& can_api = can_bus.get_can_api();
+  while (!cancelled()) {
+    if (ESP_OK == can_api.read_alerts(alerts, ALERT_TIMEOUT_MS)) {
+      handlers->forward_alerts(alerts, can_bus);
     }
   }
-  stop();
 }
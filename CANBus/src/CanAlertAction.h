@@ -35,20 +35,32 @@
 class CanAlertHandlers;
 class CanApi;
 class CanBus;
-class CanPayloadAction;
 
 class CanAlertAction final : public TaskAction {
-  CanAlertHandlers& handlers;
+  CanAlertHandlers *handlers;
   CanBus& can_bus;
-  CanPayloadAction& payload_action;
 
 public:
-  CanAlertAction(
-      CanAlertHandlers& handlers,
-      CanBus& can_bus,
-      CanPayloadAction& payload_action);
+  // Bounds the shut down latency. The TWAI driver's alert wait cannot
+  // be interrupted, so cancellation takes effect when it returns.
+  static const uint32_t ALERT_TIMEOUT_MS = 20;
 
+  CanAlertAction(CanBus& can_bus);
+
+  /*
+   * Forward alerts to the handlers until the containing task is
+   * cancelled. set_handlers() MUST be invoked before the containing
+   * task starts.
+   */
   virtual void run(void) override;
+
+  /*
+   * Binds the handlers that receive alerts. The containing task must
+   * not be running.
+   */
+  inline void set_handlers(CanAlertHandlers& handlers) {
+    this->handlers = &handlers;
+  }
 };
 
 #endif /* LIBRARIES_CANBUS_CANALERTACTION_H_ */
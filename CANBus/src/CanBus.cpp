@@ -28,7 +28,7 @@
 #include "CanPayload.h"
 #include "CanPayloadHandler.h"
 
-#include "MutexLock.h"
+#include <new>
 
 static esp_err_t print_status(esp_err_t status) {
   Serial.printf("Status = %d (%s).\n",
@@ -55,6 +55,31 @@ static void dump_state(CanApi& can_api) {
   }
 }
 
+CanBus::Tasks::Tasks(
+    CanPayloadAction& receive_action, CanAlertAction& alert_action) :
+        stacks(stack_region, sizeof(stack_region)),
+        receive_task(
+            "can-receive",
+            19,
+            &receive_action,
+            stacks,
+            TASK_STACK_SIZE),
+        alert_task(
+            "alert-handling",
+            20,
+            &alert_action,
+            stacks,
+            TASK_STACK_SIZE) {
+  stacks.add_size_class(TASK_STACK_SIZE, 2);
+}
+
+CanBusOpStatus CanBus::allocate_tasks(void) {
+  if (!tasks) {
+    tasks.reset(new (std::nothrow) Tasks(receive_action, alert_action));
+  }
+  return tasks ? CanBusOpStatus::SUCCEEDED : CanBusOpStatus::FAILED;
+}
+
 CanBusOpStatus CanBus::drain_input_queue(void) {
   CanBusOpStatus result = CanBusOpStatus::SUCCEEDED;
   twai_status_info_t status_info;
@@ -77,20 +102,12 @@ CanBusOpStatus CanBus::maybe_start_alert_task(
     result = CanBusMaps::INSTANCE.to_op_status(
         can_api.reconfigure_alerts(active_alerts));
     if (CanBusOpStatus::SUCCEEDED == result) {
-      alert_action = std::make_unique<CanAlertAction>(
-          alert_handlers, *this, *(receive_action.get()));
-      alert_task = std::make_unique<TaskWithActionH>(
-          "alert-handling",
-          20,
-          alert_action.get(),
-          8192);
-      if (alert_task->start()) {
+      alert_action.set_handlers(alert_handlers);
+      if (tasks->alert_task.start()) {
         result = CanBusOpStatus::SUCCEEDED;
         Serial.println("Alert task is running \\o/");
       } else {
         result = CanBusOpStatus::FAILED;
-        alert_task.reset();
-        alert_action.reset();
         Serial.println("Alert task startup failed :-(");
       }
     }
@@ -122,7 +139,10 @@ CanBusDeinitStatus CanBus::really_deinit(void) {
 CanBusOpStatus CanBus::really_start(
     CanPayloadHandler& payload_handler,
     CanAlertHandlers& alert_handlers) {
-  auto result = start_bus();
+  auto result = allocate_tasks();
+  if (CanBusOpStatus::SUCCEEDED == result) {
+    result = start_bus();
+  }
   if (CanBusOpStatus::SUCCEEDED == result) {
     result = start_receive_task(payload_handler);
   }
@@ -144,6 +164,7 @@ CanBusOpStatus CanBus::really_stop(void) {
     result = drain_input_queue();
   }
   if (CanBusOpStatus::SUCCEEDED == result) {
+    shut_down_alert_task();
     shut_down_receive_task();
     result = wait_for_bus_shutdown();
   }
@@ -153,17 +174,28 @@ CanBusOpStatus CanBus::really_stop(void) {
   return result;
 }
 
+void CanBus::shut_down_alert_task(void) {
+  if (tasks) {
+    shut_down_task(tasks->alert_task);
+  }
+}
+
 void CanBus::shut_down_receive_task(void) {
-  if (receive_task) {
-    receive_task->stop();
+  if (tasks) {
+    shut_down_task(tasks->receive_task);
   }
-  receive_task.reset();
-  receive_action.reset();
+}
+
+void CanBus::shut_down_task(BaseTaskWithAction& task) {
+  // Deleting a task that runs on another core defers its clean up to the
+  // idle task, and the next start() would reuse its stack while FreeRTOS
+  // still owns it. Wait as long as it takes instead.
+  task.cancel();
+  task.join();
 }
 
 void CanBus::set_receive_status(CanReceiveStatus receive_status)  {
-  MutexLock lock(status_mutex);
-  this->receive_status = receive_status;
+  this->receive_status.set(receive_status);
 }
 
 CanBusOpStatus CanBus::start_bus(void) {
@@ -176,20 +208,12 @@ CanBusOpStatus CanBus::start_bus(void) {
 CanBusOpStatus CanBus::start_receive_task(CanPayloadHandler& handler) {
   Serial.println("Starting the receive task.");
   CanBusOpStatus result = CanBusOpStatus::FAILED;
-  receive_action = std::make_unique<CanPayloadAction>(
-      *this, handler);
-  receive_task = std::make_unique<TaskWithActionH>(
-      "can-receive",
-      19,
-      receive_action.get(),
-      8192);
-  if (receive_task->start()) {
+  receive_action.set_handler(handler);
+  if (tasks->receive_task.start()) {
     result = CanBusOpStatus::SUCCEEDED;
     Serial.println("Start task is running \\o/");
   }
   if (CanBusOpStatus::SUCCEEDED != result) {
-    receive_task.reset();
-    receive_action.reset();
     Serial.println("Receive task startup failed :-(");
   }
   Serial.printf("CanBus::start_receive_task returns: %s.\n",
@@ -242,8 +266,9 @@ CanBus::CanBus(
             bits_per_second,
             static_cast<uint8_t>(bus_number),
             mode),
-        receive_status(CanReceiveStatus::DOWN) {
-  status_mutex.begin();
+        receive_status(CanReceiveStatus::DOWN),
+        receive_action(*this),
+        alert_action(*this) {
 }
 
 CanBus::~CanBus(void) {
@@ -278,8 +303,7 @@ CanBusDeinitStatus CanBus::deinit(void) {
 }
 
 CanReceiveStatus CanBus::get_receive_status(void) {
-  MutexLock lock(status_mutex);
-  return receive_status;
+  return receive_status();
 }
 
 CanBusOpStatus CanBus::recover_if_bus_off(void) {
@@ -31,16 +31,18 @@
 #ifndef LIBRARIES_CANBUS_SRC_CANBUS_H_
 #define LIBRARIES_CANBUS_SRC_CANBUS_H_
 
+#include "AtomicStateT.h"
 #include "CanAlertHandlers.h"
 #include "CanApi.h"
 #include "CanEnumerations.h"
 #include "CanAlertAction.h"
 #include "CanAlertHandlers.h"
 #include "CanPayloadAction.h"
-#include "MutexH.h"
-#include "TaskWithActionH.h"
+#include "TaskStackArena.h"
+#include "TaskWithArenaStack.h"
 
 #include "driver/twai.h"
+
 #include <memory>
 
 class CanPayloadHandler;
@@ -49,15 +51,34 @@ class CanBus {
 
   friend CanPayloadAction;
 
+  static const size_t TASK_STACK_SIZE = 8192;
+
+  // The receive and alert tasks and the arena that holds their stacks.
+  // The bus allocates them when it first starts and keeps them until it
+  // is destroyed, so a bus that is never started costs no stack memory,
+  // and restarting the bus does not allocate memory.
+  struct Tasks {
+    alignas(TaskStackArena::STACK_ALIGNMENT)
+        uint8_t stack_region[2 * TASK_STACK_SIZE];
+    TaskStackArena stacks;
+    TaskWithArenaStack receive_task;
+    TaskWithArenaStack alert_task;
+
+    Tasks(CanPayloadAction& receive_action, CanAlertAction& alert_action);
+  };
+
   CanApi can_api;
-  CanReceiveStatus receive_status;
+  AtomicStateT<CanReceiveStatus> receive_status;
 
-  std::unique_ptr<CanPayloadAction> receive_action;
-  std::unique_ptr<TaskWithActionH> receive_task;
-  std::unique_ptr<CanAlertAction> alert_action;
-  std::unique_ptr<TaskWithActionH> alert_task;
+  CanPayloadAction receive_action;
+  CanAlertAction alert_action;
+  std::unique_ptr<Tasks> tasks;  // Must follow the actions
 
-  MutexH status_mutex;
+  /*
+   * Allocate the receive and alert tasks if they have not been
+   * allocated already.
+   */
+  CanBusOpStatus allocate_tasks(void);
 
   /*
    * Clear any enqueued incoming messages.
@@ -65,7 +86,7 @@ class CanBus {
   CanBusOpStatus drain_input_queue(void);
 
   /*
-   * Create and start the alert task if the caller provided alert
+   * Start the alert task if the caller provided alert
    * handlers. Otherwise do nothing. Note that the payload handling
    * task MUST be running when this is invoked.
    */
@@ -93,11 +114,23 @@ class CanBus {
       int timeout_ms);
 
   /**
-   * Stop the receive task if it is running, then delete
-   * the receive task and the receive action.
+   * Cancel the alert task if it is running and wait for it to finish.
+   */
+  void shut_down_alert_task(void);
+
+  /**
+   * Cancel the receive task if it is running and wait for it to finish.
    */
   void shut_down_receive_task(void);
 
+  /**
+   * Cancel a task and wait for it to finish. The tasks run on arena
+   * stacks, so they are never deleted while running. The tasks notice
+   * cancellation within their TWAI wait periods, which bounds the wait
+   * unless a handler blocks.
+   */
+  static void shut_down_task(BaseTaskWithAction& task);
+
   CanBusOpStatus start_bus(void);
 
   CanBusOpStatus start_receive_task(CanPayloadHandler& handler);
@@ -26,9 +26,9 @@
 #ifndef LIBRARIES_CANBUS_CANPAYLOADACTION_H_
 #define LIBRARIES_CANBUS_CANPAYLOADACTION_H_
 
+#include "AtomicStateT.h"
 #include "CanPayload.h"
 #include "CanPayloadHandler.h"
-#include "MutexH.h"
 #include "TaskAction.h"
 
 #include "driver/twai.h"
@@ -39,34 +39,36 @@ class CanPayloadAction : public TaskAction {
 public:
   enum class State { CREATED, RUNNING, STOPPED };
 
+  // Bounds the shut down latency; see stop().
+  static const uint32_t RECEIVE_TIMEOUT_MS = 20;
+
 private:
   CanBus& bus;
-  CanPayloadHandler& handler;
-
-  MutexH state_access;  // Must hold this to access the running flag.
-  bool can_run;         // The running flag.
-  State state;
-
-  State get_state(void);
-
-  void set_state(State state);
+  CanPayloadHandler *handler;
 
-  void signal_loop_exit(void);
+  AtomicStateT<State> state;
 
 public:
-  CanPayloadAction(
-      CanBus& bus,
-      CanPayloadHandler& handler);
+  CanPayloadAction(CanBus& bus);
   virtual ~CanPayloadAction();
 
   /*
-   * Run action logic until stop() is invoked. The run logic
-   * polls the bus for input, and forwards received input to the
-   * application-provided CanPayloadHandler that was bound during
-   * construction.
+   * Run action logic until stop() is invoked or the containing task
+   * is cancelled. The run logic polls the bus for input, and forwards
+   * received input to the application-provided CanPayloadHandler that
+   * was bound by set_handler(), which MUST be invoked before the
+   * containing task starts.
    */
   virtual void run(void);
 
+  /*
+   * Binds the handler that receives incoming payloads. The containing
+   * task must not be running.
+   */
+  inline void set_handler(CanPayloadHandler& handler) {
+    this->handler = &handler;
+  }
+
   /*
    * Return true if and only if the handler is running and able to
    * process delivered messages. When the invocation returns false,
@@ -74,58 +76,19 @@ public:
    * containing task could still be running. Does not check the CAN controller
    * state, which can be retrieved by invoking CanBus::get_receive_status().
    * This method is thread-safe.
-   *
-   * Note: Since the handler enters the STOP state immediately BEFORE
-   *       it terminates the containing, there will be a slight delay
-   *       between the time it indicates that it has stopped and
-   *       the task is actually terminated.
-   *       If the invoking method requires actual task termination,
-   *       it is recommended that it wait for a few microseconds to
-   *       ensure that the task completely shuts down. This should not
-   *       be a problem if the containing task has higher priority than
-   *       the invoker.
-   *
    */
   bool running(void);
 
   /*
-   * Returns the run/stop flag. If true, the action is running. If
-   * false, the action is stopping. This can be used to control
-   * another task having the same life cycle.
-   */
-  inline bool run_stop_flag(void) const { return can_run; }
-
-  /*
-   * Signal this action to stop, then wait for it to
-   * do so. This method is thread-safe.
-   *
-   * Note that the loop might be running when can_run
-   * is false. Since run() changes the state to State:STOPPED
-   * after the loop exits, querying the state precisely indicates
-   * the run/stop state.
-   *
-   * Note: This method blocks until the handler stops polling for
-   *       input. If the processor is currently handling a message, the
-   *       loop will stop when processing completes.
-   *       If a the pending input request delivers a message, it will
-   *       be processed before the polling loop exits. Otherwise the
-   *       polling loop will exit when the pending input request
-   *       times out.
-   *
-   *       Since the state changes immediately BEFORE the containing
-   *       task is terminated, it is recommended that the invoker
-   *       wait for a few microseconds to allow the task complexly
-   *       shuts down.
+   * Cancel the containing task, then wait for it to finish. This
+   * method is thread-safe, and must be invoked from another task.
    *
-   * Note: Since the handler enters the STOP state immediately BEFORE
-   *       it terminates the containing, there will be a slight delay
-   *       between the time it indicates that it has stopped and
-   *       the task is actually terminated.
-   *       If the invoking method requires actual task termination,
-   *       it is recommended that it wait for a few microseconds to
-   *       ensure that the task completely shuts down. This should not
-   *       be a problem if the containing task has higher priority than
-   *       the invoker.
+   * Note: the TWAI driver's receive cannot be interrupted, so the
+   *       loop notices the cancellation when the pending receive
+   *       returns, either with a message, which is processed first,
+   *       or when it times out. The latency is therefore at most the
+   *       receive timeout, RECEIVE_TIMEOUT_MS. When this method returns,
+   *       the containing task has finished.
    */
   void stop(void);
 };
@@ -24,8 +24,7 @@
 #include "ServerStatus.h"
 
 ServerStatus::ServerStatus() :
-  state(State::RUNNING),
-  lock(portMUX_INITIALIZER_UNLOCKED) {
+  state(State::RUNNING) {
 }
 
 ServerStatus::~ServerStatus() {
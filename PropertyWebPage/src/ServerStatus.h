@@ -28,7 +28,7 @@
 #ifndef SERVERSTATUS_H_
 #define SERVERSTATUS_H_
 
-#include <freertos/FreeRTOS.h>
+#include "AtomicStateT.h"
 
 class ServerStatus {
 public:
@@ -38,8 +38,7 @@ public:
     FAILURE,  // Operation failed
   };
 private:
-  State state;
-  portMUX_TYPE lock;
+  AtomicStateT<State> state;
 public:
   ServerStatus();
   ServerStatus(ServerStatus&) = delete;
@@ -49,23 +48,15 @@ public:
   virtual ~ServerStatus();
 
   State operator() (void) {
-    State current_state;
-    portENTER_CRITICAL(&lock);
-    current_state = state;
-    portEXIT_CRITICAL(&lock);
-    return current_state;
+    return state();
   }
 
   void failure(void) {
-    portENTER_CRITICAL(&lock);
-    state = State::FAILURE;
-    portEXIT_CRITICAL(&lock);
+    state.set(State::FAILURE);
   }
 
   void success(void) {
-    portENTER_CRITICAL(&lock);
-    state = State::SUCCESS;
-    portEXIT_CRITICAL(&lock);
+    state.set(State::SUCCESS);
   }
 };
 
@@ -0,0 +1,280 @@
+/**
+ * GpioDebounceService.ino
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Checks GpioDebounceService against scripted bounce waveforms. The sketch
+ * replaces the GPIO hardware with a ScriptedGpioEdgeSource and plays
+ * scripts of timed edges on three simulated pins, each with its own
+ * debounce window. After each script, it checks that every pin settled
+ * once per burst of edges, no earlier than its window after the burst's
+ * last edge and no more than SETTLE_TOLERANCE_MICROS later, and prints
+ * PASS or FAIL.
+ *
+ * The scripts cover a clean press, a press that bounces for most of its
+ * window, a press and release, bouncing that outlasts the window,
+ * interleaved bouncing on all three pins, and an edge storm. The sketch
+ * needs nothing but an ESP32 development board; no pins are read or
+ * driven.
+ */
+
+#include "Arduino.h"
+
+#include "GpioDebounceService.h"
+#include "ScriptedGpioEdgeSource.h"
+#include "SettleRecorder.h"
+
+#include "esp_timer.h"
+
+#define SERVICE_PRIORITY 5
+#define PLAYER_PRIORITY 10
+#define SETTLE_TOLERANCE_MICROS 2000
+#define SETTLE_WAIT_MS 50
+#define MAX_SCRIPT_EDGES 64
+
+// Simulated pins, by index
+#define PIN_A 0
+#define PIN_B 1
+#define PIN_C 2
+#define PIN_COUNT 3
+
+struct SimulatedPin {
+  const char *name;
+  uint8_t pin_no;
+  uint32_t window_micros;
+  SettleRecorder recorder;
+  int index;
+};
+
+struct ScriptedEdge {
+  uint32_t offset_micros;
+  uint8_t pin;
+};
+
+struct Script {
+  const char *name;
+  const ScriptedEdge *edges;
+  size_t count;
+};
+
+static SimulatedPin pins[PIN_COUNT] = {
+  {"A", 4, 5000, SettleRecorder(), -1},
+  {"B", 5, 2000, SettleRecorder(), -1},
+  {"C", 18, 10000, SettleRecorder(), -1},
+};
+
+static const ScriptedEdge CLEAN_PRESS[] = {
+  {0, PIN_A},
+};
+
+static const ScriptedEdge BOUNCY_PRESS[] = {
+  {0, PIN_A}, {300, PIN_A}, {700, PIN_A},
+  {1500, PIN_A}, {2600, PIN_A}, {4000, PIN_A},
+};
+
+static const ScriptedEdge PRESS_AND_RELEASE[] = {
+  {0, PIN_A}, {200, PIN_A}, {500, PIN_A},
+  {20000, PIN_A}, {20300, PIN_A}, {20900, PIN_A},
+};
+
+// Every gap is shorter than pin B's 2 ms window, but the bouncing lasts
+// more than twice as long.
+static const ScriptedEdge LONG_BOUNCE[] = {
+  {0, PIN_B}, {1000, PIN_B}, {1900, PIN_B},
+  {2800, PIN_B}, {3500, PIN_B}, {4400, PIN_B},
+};
+
+static const ScriptedEdge INTERLEAVED[] = {
+  {0, PIN_A}, {100, PIN_B}, {300, PIN_C}, {400, PIN_A},
+  {600, PIN_B}, {900, PIN_A}, {1200, PIN_B}, {2000, PIN_C},
+  {5500, PIN_C}, {8000, PIN_B}, {8300, PIN_B}, {9000, PIN_C},
+};
+
+static ScriptedEdge edge_storm[48];
+
+static const Script SCRIPTS[] = {
+  {"Clean press", CLEAN_PRESS, sizeof(CLEAN_PRESS) / sizeof(ScriptedEdge)},
+  {"Bouncy press", BOUNCY_PRESS, sizeof(BOUNCY_PRESS) / sizeof(ScriptedEdge)},
+  {"Press and release",
+      PRESS_AND_RELEASE, sizeof(PRESS_AND_RELEASE) / sizeof(ScriptedEdge)},
+  {"Bounce longer than window",
+      LONG_BOUNCE, sizeof(LONG_BOUNCE) / sizeof(ScriptedEdge)},
+  {"Interleaved pins",
+      INTERLEAVED, sizeof(INTERLEAVED) / sizeof(ScriptedEdge)},
+  {"Edge storm", edge_storm, sizeof(edge_storm) / sizeof(ScriptedEdge)},
+};
+
+static ScriptedGpioEdgeSource simulated_gpio;
+static GpioDebounceService debouncer(
+    "Debouncer", SERVICE_PRIORITY, 4096, simulated_gpio);
+
+static int64_t edge_at_micros[MAX_SCRIPT_EDGES];
+static uint32_t failures = 0;
+
+static void halt(const char *message) {
+  Serial.println(message);
+  for (;;) {
+    vTaskDelay(portMAX_DELAY);
+  }
+}
+
+/*
+ * Plays a script, busy waiting between edges, and records when each
+ * edge was actually delivered.
+ */
+static void play(const Script& script) {
+  int64_t start_micros = esp_timer_get_time() + 1000;
+  for (size_t i = 0; i < script.count; ++i) {
+    const ScriptedEdge& edge = script.edges[i];
+    while (esp_timer_get_time() < start_micros + edge.offset_micros) {
+    }
+    edge_at_micros[i] = esp_timer_get_time();
+    simulated_gpio.edge(pins[edge.pin].pin_no);
+  }
+}
+
+/*
+ * Checks one pin's settles against the edges delivered to it. A burst
+ * ends at an edge that is followed by a quiet window, and must produce
+ * exactly one settle, at least a window after that edge.
+ *
+ * Returns: true if the pin passed, false otherwise.
+ */
+static bool check_pin(
+    const Script& script, uint8_t pin, uint32_t edges_before) {
+  SimulatedPin& simulated_pin = pins[pin];
+  const size_t count = script.count;
+  size_t bursts = 0;
+  size_t edges = 0;
+  bool passed = true;
+
+  for (size_t i = 0; i < count; ++i) {
+    if (script.edges[i].pin != pin) {
+      continue;
+    }
+    ++edges;
+    size_t next = i + 1;
+    while (next < count && script.edges[next].pin != pin) {
+      ++next;
+    }
+    int64_t quiet_until = edge_at_micros[i] + simulated_pin.window_micros;
+    if (next < count && edge_at_micros[next] < quiet_until) {
+      continue;
+    }
+    if (bursts < simulated_pin.recorder.count()
+        && bursts < SettleRecorder::MAX_SETTLES) {
+      int64_t settled_at = simulated_pin.recorder.settled_at(bursts);
+      int64_t late_micros = settled_at - quiet_until;
+      if (late_micros < 0 || SETTLE_TOLERANCE_MICROS < late_micros) {
+        Serial.printf(
+            "    Pin %s settle %u: %lld us from the end of its window.\n",
+            simulated_pin.name,
+            static_cast<unsigned>(bursts),
+            static_cast<long long>(late_micros));
+        passed = false;
+      }
+    }
+    ++bursts;
+  }
+
+  uint32_t edges_seen =
+      debouncer.edge_count(simulated_pin.index) - edges_before;
+  if (edges_seen != edges) {
+    Serial.printf(
+        "    Pin %s: %lu edges played, %lu seen.\n",
+        simulated_pin.name,
+        static_cast<unsigned long>(edges),
+        static_cast<unsigned long>(edges_seen));
+    passed = false;
+  }
+  if (simulated_pin.recorder.count() != bursts) {
+    Serial.printf(
+        "    Pin %s: %u settles expected, %u happened.\n",
+        simulated_pin.name,
+        static_cast<unsigned>(bursts),
+        static_cast<unsigned>(simulated_pin.recorder.count()));
+    passed = false;
+  }
+  return passed;
+}
+
+static void run_script(const Script& script) {
+  uint32_t edges_before[PIN_COUNT];
+  for (uint8_t pin = 0; pin < PIN_COUNT; ++pin) {
+    pins[pin].recorder.clear();
+    edges_before[pin] = debouncer.edge_count(pins[pin].index);
+  }
+
+  play(script);
+  vTaskDelay(pdMS_TO_TICKS(SETTLE_WAIT_MS));
+
+  bool passed = true;
+  for (uint8_t pin = 0; pin < PIN_COUNT; ++pin) {
+    passed = check_pin(script, pin, edges_before[pin]) && passed;
+  }
+  if (!passed) {
+    ++failures;
+  }
+  Serial.printf("  %-28s %s\n", script.name, passed ? "PASS" : "FAIL");
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial.printf(
+      "GpioDebounceService check built on %s at %s.\n",
+      __DATE__,
+      __TIME__);
+
+  // An edge every 150 us on pin C, far inside its 10 ms window.
+  for (size_t i = 0; i < sizeof(edge_storm) / sizeof(ScriptedEdge); ++i) {
+    edge_storm[i].offset_micros = 150 * i;
+    edge_storm[i].pin = PIN_C;
+  }
+
+  for (SimulatedPin& pin : pins) {
+    pin.index = debouncer.add_pin(
+        pin.pin_no, pin.window_micros, &pin.recorder);
+    if (pin.index < 0) {
+      halt("Could not add a pin.");
+    }
+  }
+  if (!debouncer.start()) {
+    halt("GpioDebounceService startup failed.");
+  }
+
+  // Deliver edges on time, even while the service is running.
+  vTaskPrioritySet(NULL, PLAYER_PRIORITY);
+
+  for (const Script& script : SCRIPTS) {
+    run_script(script);
+  }
+
+  debouncer.stop();
+  if (failures) {
+    Serial.printf(
+        "%lu scripts failed.\n", static_cast<unsigned long>(failures));
+  } else {
+    Serial.println("All scripts passed.");
+  }
+}
+
+void loop() {
+  vTaskDelay(portMAX_DELAY);
+}
@@ -0,0 +1,54 @@
+/*
+ * ScriptedGpioEdgeSource.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ScriptedGpioEdgeSource.h"
+
+ScriptedGpioEdgeSource::ScriptedGpioEdgeSource(void) {
+  for (uint8_t i = 0; i < PIN_COUNT; ++i) {
+    on_edge[i] = NULL;
+  }
+}
+
+ScriptedGpioEdgeSource::~ScriptedGpioEdgeSource() {
+}
+
+bool ScriptedGpioEdgeSource::attach(uint8_t pin_no, VoidFunction *on_edge) {
+  if (PIN_COUNT <= pin_no || this->on_edge[pin_no]) {
+    return false;
+  }
+  this->on_edge[pin_no] = on_edge;
+  return true;
+}
+
+void ScriptedGpioEdgeSource::detach(uint8_t pin_no) {
+  if (pin_no < PIN_COUNT) {
+    on_edge[pin_no] = NULL;
+  }
+}
+
+void ScriptedGpioEdgeSource::edge(uint8_t pin_no) {
+  VoidFunction *function = pin_no < PIN_COUNT ? on_edge[pin_no] : NULL;
+  if (function) {
+    function->apply();
+  }
+}
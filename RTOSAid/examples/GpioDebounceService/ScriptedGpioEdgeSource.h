@@ -0,0 +1,58 @@
+/*
+ * ScriptedGpioEdgeSource.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A simulated GpioEdgeSource. Instead of watching GPIO hardware, it
+ * invokes attached functions when the sketch calls edge(), so that the
+ * sketch can play scripted bounce waveforms into a GpioDebounceService.
+ * Edges are delivered from the calling task, not from an interrupt.
+ */
+
+#ifndef SCRIPTEDGPIOEDGESOURCE_H_
+#define SCRIPTEDGPIOEDGESOURCE_H_
+
+#include "Arduino.h"
+
+#include "GpioEdgeSource.h"
+#include "VoidFunction.h"
+
+class ScriptedGpioEdgeSource : public GpioEdgeSource {
+public:
+  static const uint8_t PIN_COUNT = 64;
+
+private:
+  VoidFunction * volatile on_edge[PIN_COUNT];
+
+public:
+  ScriptedGpioEdgeSource(void);
+  virtual ~ScriptedGpioEdgeSource();
+
+  virtual bool attach(uint8_t pin_no, VoidFunction *on_edge);
+
+  virtual void detach(uint8_t pin_no);
+
+  /**
+   * Simulates an edge on a pin, invoking the attached function, if any.
+   */
+  void edge(uint8_t pin_no);
+};
+
+#endif /* SCRIPTEDGPIOEDGESOURCE_H_ */
@@ -0,0 +1,72 @@
+/*
+ * SettleRecorder.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A VoidFunction that a GpioDebounceService invokes when a pin settles.
+ * It records when each settle happened, as returned by
+ * esp_timer_get_time(), so that the sketch can check the settles against
+ * its scripted waveforms.
+ */
+
+#ifndef SETTLERECORDER_H_
+#define SETTLERECORDER_H_
+
+#include "Arduino.h"
+
+#include "VoidFunction.h"
+
+class SettleRecorder : public VoidFunction {
+public:
+  static const size_t MAX_SETTLES = 8;
+
+private:
+  int64_t settled_at_micros[MAX_SETTLES];
+  volatile size_t settles;
+
+public:
+  SettleRecorder(void);
+  virtual ~SettleRecorder();
+
+  virtual void apply(void);
+
+  /**
+   * Forgets all recorded settles.
+   */
+  void clear(void);
+
+  /**
+   * Returns: the number of settles since clear(), which can exceed
+   *          MAX_SETTLES.
+   */
+  inline size_t count(void) const {
+    return settles;
+  }
+
+  /**
+   * Returns: when a settle happened. index must be less than both
+   *          count() and MAX_SETTLES.
+   */
+  inline int64_t settled_at(size_t index) const {
+    return settled_at_micros[index];
+  }
+};
+
+#endif /* SETTLERECORDER_H_ */
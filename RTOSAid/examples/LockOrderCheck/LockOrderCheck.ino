@@ -0,0 +1,108 @@
+/**
+ * LockOrderCheck.ino
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Randomized stress test of the lock order checker. Four tasks, two on
+ * each core, lock random subsets of five named mutexes. Three of them
+ * always lock in a consistent order, which the checker must accept. The
+ * fourth, the rogue, occasionally locks in the opposite order, which the
+ * checker must report, once per new cycle, even though the inversion
+ * rarely deadlocks.
+ *
+ * The checker is a debugging aid that is off by default. Build the
+ * library and the sketch with -DRTOSAID_LOCK_ORDER_CHECKING=1.
+ */
+
+#include "Arduino.h"
+
+#include "LockOrderChecker.h"
+#include "Mutex.h"
+#include "RTOSAidConfig.h"
+#include "RandomLockerAction.h"
+#include "TaskWithActionH.h"
+
+#define MUTEX_COUNT 5
+#define TASK_COUNT 4
+#define ROGUE_INVERSION_ODDS 500
+#define REPORT_INTERVAL_MS 5000
+
+static const char *mutex_names[MUTEX_COUNT] = {
+    "config", "routes", "stats", "flash", "can-tx",
+};
+static Mutex mutexes[MUTEX_COUNT];
+
+static const char *task_names[TASK_COUNT] = {
+    "Locker0", "Locker1", "Locker2", "Rogue",
+};
+static RandomLockerAction *actions[TASK_COUNT];
+static TaskWithActionH *tasks[TASK_COUNT];
+
+void setup() {
+  Serial.begin(115200);
+  Serial.printf(
+      "Lock order checker stress test, built on %s at %s.\n",
+      __DATE__,
+      __TIME__);
+
+#if !RTOSAID_LOCK_ORDER_CHECKING
+  Serial.println(
+      "Lock order checking is off. Rebuild with "
+      "-DRTOSAID_LOCK_ORDER_CHECKING=1.");
+  for (;;) {
+    vTaskDelay(portMAX_DELAY);
+  }
+#endif
+
+  for (size_t i = 0; i < MUTEX_COUNT; ++i) {
+    mutexes[i].set_name(mutex_names[i]);
+    if (!mutexes[i].begin()) {
+      Serial.println("Mutex initialization failed.");
+      for (;;) {
+        vTaskDelay(portMAX_DELAY);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < TASK_COUNT; ++i) {
+    bool rogue = i == TASK_COUNT - 1;
+    actions[i] = new RandomLockerAction(
+        mutexes, MUTEX_COUNT, rogue ? ROGUE_INVERSION_ODDS : 0);
+    tasks[i] = new TaskWithActionH(
+        task_names[i], 2, actions[i], 4096, i % portNUM_PROCESSORS);
+    tasks[i]->start();
+  }
+
+  Serial.println("Setup completed.");
+}
+
+void loop() {
+  vTaskDelay(pdMS_TO_TICKS(REPORT_INTERVAL_MS));
+  uint32_t rounds = 0;
+  for (size_t i = 0; i < TASK_COUNT; ++i) {
+    rounds += actions[i]->round_count();
+  }
+  Serial.printf(
+      "%lu locking rounds, %lu lock order violations, %lu untracked.\n",
+      static_cast<unsigned long>(rounds),
+      static_cast<unsigned long>(LockOrder.violations()),
+      static_cast<unsigned long>(LockOrder.untracked()));
+  LockOrder.print_graph(Serial);
+}
@@ -0,0 +1,74 @@
+/*
+ * RandomLockerAction.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "RandomLockerAction.h"
+
+RandomLockerAction::RandomLockerAction(
+    Mutex *mutexes,
+    size_t mutex_count,
+    uint32_t inversion_odds) :
+        mutexes(mutexes),
+        mutex_count(mutex_count),
+        inversion_odds(inversion_odds),
+        rounds(0) {
+}
+
+RandomLockerAction::~RandomLockerAction() {
+}
+
+void RandomLockerAction::lock_from(
+    const size_t *order, size_t count, size_t index) {
+  if (index == count) {
+    delayMicroseconds(50 + random(200));  // Hold everything briefly
+    return;
+  }
+  // Time out rather than hang, so that an inversion cannot deadlock the
+  // sketch. The checker reports the inversion either way.
+  MutexLock lock(mutexes[order[index]], 20);
+  if (lock.succeeded()) {
+    lock_from(order, count, index + 1);
+  }
+}
+
+void RandomLockerAction::run(void) {
+  size_t order[16];
+  for (;;) {
+    uint32_t chosen = random(1L << mutex_count);
+    size_t count = 0;
+    for (size_t i = 0; i < mutex_count; ++i) {
+      if (chosen & (1UL << i)) {
+        order[count++] = i;
+      }
+    }
+    if (inversion_odds && !random(inversion_odds)) {
+      for (size_t i = 0; i < count / 2; ++i) {
+        size_t swap = order[i];
+        order[i] = order[count - 1 - i];
+        order[count - 1 - i] = swap;
+      }
+    }
+    lock_from(order, count, 0);
+    ++rounds;
+    delay_millis(1 + random(5));
+  }
+}
@@ -0,0 +1,80 @@
+/*
+ * RandomLockerAction.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A TaskAction that repeatedly locks a random subset of a set of named
+ * mutexes, nesting the locks. A well behaved locker always locks in
+ * ascending index order. A rogue locker occasionally locks in
+ * descending order, which the lock order checker must report.
+ */
+
+#ifndef RANDOMLOCKERACTION_H_
+#define RANDOMLOCKERACTION_H_
+
+#include "Arduino.h"
+
+#include "Mutex.h"
+#include "TaskAction.h"
+
+class RandomLockerAction : public TaskAction {
+  Mutex *mutexes;
+  size_t mutex_count;
+  uint32_t inversion_odds;
+  uint32_t rounds;
+
+  /**
+   * Locks order[index] and, while holding it, the rest of the order.
+   */
+  void lock_from(const size_t *order, size_t count, size_t index);
+
+public:
+  /**
+   * Creates an instance
+   *
+   * Parameters:
+   *
+   * Name           Contents
+   * -------------- -----------------------------------------------------------
+   * mutexes        The mutexes to lock, which must be named
+   * mutex_count    The number of mutexes, at most 16
+   * inversion_odds 1 in inversion_odds rounds lock in descending order;
+   *                0 means never
+   */
+  RandomLockerAction(
+      Mutex *mutexes,
+      size_t mutex_count,
+      uint32_t inversion_odds);
+  virtual ~RandomLockerAction();
+
+  /**
+   * Returns: the number of completed locking rounds.
+   */
+  inline uint32_t round_count(void) const {
+    return rounds;
+  }
+
+  /**
+   * The locking loop
+   */
+  virtual void run(void);
+};
+
+#endif /* RANDOMLOCKERACTION_H_ */
@@ -0,0 +1,55 @@
+/*
+ * CpuHogAction.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A TaskAction that keeps a core busy, spinning for a few milliseconds at
+ * a time with a one tick pause between spins, until it is cancelled. Run
+ * above the ESP timer task's priority, it delays task dispatched timers,
+ * but not ISR dispatched ones.
+ */
+
+#ifndef CPUHOGACTION_H_
+#define CPUHOGACTION_H_
+
+#include "Arduino.h"
+
+#include "TaskAction.h"
+
+class CpuHogAction : public TaskAction {
+  const uint32_t spin_micros;
+
+public:
+  /**
+   * Creates the action
+   *
+   * Parameters:
+   *
+   * Name        Contents
+   * ----------- --------------------------------------------------------------
+   * spin_micros How long to spin between pauses, in microseconds
+   */
+  CpuHogAction(uint32_t spin_micros);
+  virtual ~CpuHogAction();
+
+  virtual void run(void);
+};
+
+#endif /* CPUHOGACTION_H_ */
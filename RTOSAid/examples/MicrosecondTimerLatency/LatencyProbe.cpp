@@ -0,0 +1,73 @@
+/*
+ * LatencyProbe.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LatencyProbe.h"
+
+#include "CurrentTaskBlocker.h"
+#include "LatencyHistogram.h"
+
+#include "esp_timer.h"
+
+LatencyProbe::LatencyProbe(
+    LatencyHistogram& lateness_micros, bool from_isr) :
+      lateness_micros(lateness_micros),
+      from_isr(from_isr),
+      on_done(NULL),
+      previous_micros(0),
+      period_micros(0),
+      expected_count(0),
+      sample_count(0) {
+}
+
+LatencyProbe::~LatencyProbe() {
+}
+
+void IRAM_ATTR LatencyProbe::apply(void) {
+  int64_t now = esp_timer_get_time();
+  // A periodic timer keeps firing until the waiting task stops it.
+  if (expected_count <= sample_count) {
+    return;
+  }
+  int64_t error = now - previous_micros - period_micros;
+  lateness_micros.record(static_cast<uint32_t>(error < 0 ? -error : error));
+  previous_micros = now;
+  if (++sample_count == expected_count) {
+    if (from_isr) {
+      on_done->notify_from_isr();
+    } else {
+      on_done->notify();
+    }
+  }
+}
+
+void LatencyProbe::arm(
+    int64_t due_micros,
+    uint32_t period_micros,
+    uint32_t expected_count,
+    CurrentTaskBlocker *on_done) {
+  this->on_done = on_done;
+  previous_micros = due_micros - period_micros;
+  this->period_micros = period_micros;
+  sample_count = 0;
+  this->expected_count = expected_count;
+}
@@ -0,0 +1,92 @@
+/*
+ * LatencyProbe.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A VoidFunction that records how late a MicrosecondTimer fires. For a
+ * one shot timer, the probe records the time between the deadline and the
+ * moment it runs. For a periodic timer, it records how far each interval
+ * between runs strays from the period, in either direction, which also
+ * exposes skipped expirations. The probe notifies a waiting task when it
+ * has recorded the requested number of samples. It works with both
+ * dispatch methods, so it lives in IRAM and uses the ISR notification API
+ * when the timer dispatches from its interrupt.
+ */
+
+#ifndef LATENCYPROBE_H_
+#define LATENCYPROBE_H_
+
+#include "Arduino.h"
+
+#include "VoidFunction.h"
+
+class CurrentTaskBlocker;
+class LatencyHistogram;
+
+class LatencyProbe : public VoidFunction {
+  LatencyHistogram& lateness_micros;
+  const bool from_isr;
+  CurrentTaskBlocker *on_done;
+  // When the probe last ran, initially the first deadline less the period
+  volatile int64_t previous_micros;
+  volatile uint32_t period_micros;
+  volatile uint32_t expected_count;
+  volatile uint32_t sample_count;
+
+public:
+  /**
+   * Creates a probe
+   *
+   * Parameters:
+   *
+   * Name            Contents
+   * --------------- ----------------------------------------------------------
+   * lateness_micros Receives the lateness or interval error of each
+   *                 expiration in microseconds
+   * from_isr        true if the timer invokes the probe from its interrupt,
+   *                 false if the ESP timer task invokes it.
+   */
+  LatencyProbe(LatencyHistogram& lateness_micros, bool from_isr);
+  virtual ~LatencyProbe();
+
+  virtual void IRAM_ATTR apply(void);
+
+  /**
+   * Prepares for an imminent timer start. The caller must start the
+   * timer immediately afterward.
+   *
+   * Parameters:
+   *
+   * Name            Contents
+   * --------------- ----------------------------------------------------------
+   * due_micros      When the first expiration is due, as returned by
+   *                 esp_timer_get_time()
+   * period_micros   The timer period, 0 for a one shot timer
+   * expected_count  The number of samples to record
+   * on_done         Notified when expected_count samples are recorded
+   */
+  void arm(
+      int64_t due_micros,
+      uint32_t period_micros,
+      uint32_t expected_count,
+      CurrentTaskBlocker *on_done);
+};
+
+#endif /* LATENCYPROBE_H_ */
@@ -0,0 +1,154 @@
+/**
+ * MicrosecondTimerLatency.ino
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Compares MicrosecondTimer expiration latency under its two dispatch
+ * methods: TASK, where the ESP timer task invokes the timer's function,
+ * and ISR, where the timer interrupt invokes it directly. For each method,
+ * the sketch measures how late
+ *
+ * 1. One shot timers, started by start(), and
+ * 2. A periodic timer, started by start_periodic(),
+ *
+ * fire, first on an idle system and then while a task running above the
+ * ESP timer task's priority keeps core 0, where the ESP timer task and
+ * interrupt live, busy. It prints the results, including percentiles, to
+ * the serial port.
+ *
+ * ISR dispatch requires CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD. If
+ * the platform was built without it, the ISR timer fails to start and the
+ * sketch halts.
+ */
+
+#include "Arduino.h"
+
+#include "CpuHogAction.h"
+#include "CurrentTaskBlocker.h"
+#include "LatencyHistogram.h"
+#include "LatencyProbe.h"
+#include "MicrosecondTimer.h"
+#include "TaskWithActionH.h"
+
+#include "esp_timer.h"
+
+#define SAMPLE_COUNT 2000
+#define ONE_SHOT_DELAY_MICROS 500
+#define PERIOD_MICROS 1000
+
+// The ESP timer task runs at priority 22, so the hog preempts it.
+#define HOG_PRIORITY 23
+#define HOG_SPIN_MICROS 5000
+
+static LatencyHistogram task_lateness;
+static LatencyProbe task_probe(task_lateness, false);
+static MicrosecondTimer task_timer(
+    "TaskDispatch", &task_probe, MicrosecondTimer::TASK);
+
+static LatencyHistogram isr_lateness;
+static LatencyProbe isr_probe(isr_lateness, true);
+static MicrosecondTimer isr_timer(
+    "IsrDispatch", &isr_probe, MicrosecondTimer::ISR);
+
+static CpuHogAction hog_action(HOG_SPIN_MICROS);
+static TaskWithActionH hog_task(
+    "CpuHog", HOG_PRIORITY, &hog_action, 2048, 0);
+
+static void halt(const char *message) {
+  Serial.println(message);
+  for (;;) {
+    vTaskDelay(portMAX_DELAY);
+  }
+}
+
+static void measure_one_shot(
+    MicrosecondTimer& timer,
+    LatencyProbe& probe,
+    LatencyHistogram& lateness,
+    const char *title) {
+  CurrentTaskBlocker fired;
+  lateness.clear();
+  for (uint32_t i = 0; i < SAMPLE_COUNT; ++i) {
+    probe.arm(
+        esp_timer_get_time() + ONE_SHOT_DELAY_MICROS, 0, 1, &fired);
+    timer.start(ONE_SHOT_DELAY_MICROS);
+    fired.wait();
+  }
+  lateness.print(Serial, title, "us");
+}
+
+static void measure_periodic(
+    MicrosecondTimer& timer,
+    LatencyProbe& probe,
+    LatencyHistogram& lateness,
+    const char *title) {
+  CurrentTaskBlocker done;
+  lateness.clear();
+  probe.arm(
+      esp_timer_get_time() + PERIOD_MICROS,
+      PERIOD_MICROS,
+      SAMPLE_COUNT,
+      &done);
+  timer.start_periodic(PERIOD_MICROS);
+  done.wait();
+  timer.stop();
+  lateness.print(Serial, title, "us");
+}
+
+static void measure_all(void) {
+  measure_one_shot(task_timer, task_probe, task_lateness, "  TASK one shot");
+  measure_one_shot(isr_timer, isr_probe, isr_lateness, "  ISR one shot");
+  measure_periodic(task_timer, task_probe, task_lateness, "  TASK periodic");
+  measure_periodic(isr_timer, isr_probe, isr_lateness, "  ISR periodic");
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial.printf(
+      "MicrosecondTimer latency built on %s at %s, CPU at %lu MHz.\n",
+      __DATE__,
+      __TIME__,
+      static_cast<unsigned long>(getCpuFrequencyMhz()));
+
+  if (!task_timer.begin()) {
+    halt("Task dispatched timer initialization failed.");
+  }
+  if (!isr_timer.begin()) {
+    halt("ISR dispatched timer initialization failed. Is "
+        "CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD set?");
+  }
+
+  Serial.println("Idle system:");
+  measure_all();
+
+  if (!hog_task.start()) {
+    halt("CPU hog startup failed.");
+  }
+  Serial.println("Core 0 busy above the ESP timer task:");
+  measure_all();
+  hog_task.cancel();
+  hog_task.join();
+
+  Serial.println("Benchmark completed.");
+}
+
+void loop() {
+  vTaskDelay(portMAX_DELAY);
+}
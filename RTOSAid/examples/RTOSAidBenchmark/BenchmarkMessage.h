@@ -0,0 +1,37 @@
+/*
+ * BenchmarkMessage.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The message that the queue benchmark sends from the sketch to the
+ * consumer task.
+ */
+
+#ifndef BENCHMARKMESSAGE_H_
+#define BENCHMARKMESSAGE_H_
+
+#include "Arduino.h"
+
+struct BenchmarkMessage {
+  uint32_t sequence;       // Message number, starting at 0
+  int64_t sent_at_micros;  // esp_timer_get_time() just before the send
+};
+
+#endif /* BENCHMARKMESSAGE_H_ */
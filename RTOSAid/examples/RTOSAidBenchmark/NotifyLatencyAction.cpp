@@ -0,0 +1,52 @@
+/*
+ * NotifyLatencyAction.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "NotifyLatencyAction.h"
+
+#include "CurrentTaskBlocker.h"
+#include "LatencyHistogram.h"
+
+#include "esp_timer.h"
+
+NotifyLatencyAction::NotifyLatencyAction(LatencyHistogram& wake_micros) :
+    wake_micros(wake_micros),
+    on_woken(NULL),
+    notified_at_micros(0) {
+}
+
+NotifyLatencyAction::~NotifyLatencyAction() {
+}
+
+void NotifyLatencyAction::arm(CurrentTaskBlocker *on_woken) {
+  this->on_woken = on_woken;
+  notified_at_micros = esp_timer_get_time();
+}
+
+void NotifyLatencyAction::run(void) {
+  for (;;) {
+    wait_for_notification();
+    wake_micros.record(
+        static_cast<uint32_t>(esp_timer_get_time() - notified_at_micros));
+    on_woken->notify();
+  }
+}
@@ -0,0 +1,74 @@
+/*
+ * NotifyLatencyAction.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A TaskAction that measures the time between a task notification and
+ * the moment the notified task resumes.
+ */
+
+#ifndef NOTIFYLATENCYACTION_H_
+#define NOTIFYLATENCYACTION_H_
+
+#include "Arduino.h"
+
+#include "TaskAction.h"
+
+class CurrentTaskBlocker;
+class LatencyHistogram;
+
+class NotifyLatencyAction : public TaskAction {
+  LatencyHistogram& wake_micros;
+  CurrentTaskBlocker *on_woken;
+  volatile int64_t notified_at_micros;
+
+public:
+  /**
+   * Creates an instance that records wake latency
+   *
+   * Parameters:
+   *
+   * Name        Contents
+   * ----------- --------------------------------------------------------------
+   * wake_micros Receives the wake latency of each notification in
+   *             microseconds
+   */
+  NotifyLatencyAction(LatencyHistogram& wake_micros);
+  virtual ~NotifyLatencyAction();
+
+  /**
+   * Time stamps an imminent notification. The caller must notify the
+   * containing task immediately afterward.
+   *
+   * Parameters:
+   *
+   * Name        Contents
+   * ----------- --------------------------------------------------------------
+   * on_woken    Notified after the latency has been recorded
+   */
+  void arm(CurrentTaskBlocker *on_woken);
+
+  /**
+   * Waits for notifications forever, recording the latency of each.
+   */
+  virtual void run(void);
+};
+
+#endif /* NOTIFYLATENCYACTION_H_ */
@@ -0,0 +1,64 @@
+/*
+ * QueueConsumerAction.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "QueueConsumerAction.h"
+
+#include "CurrentTaskBlocker.h"
+#include "LatencyHistogram.h"
+#include "PullQueueT.h"
+
+#include "esp_timer.h"
+
+QueueConsumerAction::QueueConsumerAction(
+    PullQueueT<BenchmarkMessage> *queue,
+    LatencyHistogram& transit_micros) :
+      queue(queue),
+      transit_micros(transit_micros),
+      on_done(NULL),
+      expected_count(0),
+      received_count(0) {
+}
+
+QueueConsumerAction::~QueueConsumerAction() {
+}
+
+void QueueConsumerAction::expect(
+    uint32_t message_count, CurrentTaskBlocker *on_done) {
+  this->on_done = on_done;
+  received_count = 0;
+  transit_micros.clear();
+  expected_count = message_count;
+}
+
+void QueueConsumerAction::run(void) {
+  BenchmarkMessage message;
+  for (;;) {
+    if (queue->pull_message(&message)) {
+      transit_micros.record(
+          static_cast<uint32_t>(esp_timer_get_time() - message.sent_at_micros));
+      if (++received_count == expected_count) {
+        on_done->notify();
+      }
+    }
+  }
+}
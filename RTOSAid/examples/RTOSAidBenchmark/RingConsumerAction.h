@@ -0,0 +1,86 @@
+/*
+ * RingConsumerAction.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A TaskAction that drains the benchmark SpscRingT, recording the time
+ * each message spent in transit.
+ */
+
+#ifndef RINGCONSUMERACTION_H_
+#define RINGCONSUMERACTION_H_
+
+#include "Arduino.h"
+
+#include "BenchmarkMessage.h"
+#include "SpscRingT.h"
+#include "TaskAction.h"
+
+#define BENCHMARK_RING_CAPACITY 64
+
+typedef SpscRingT<BenchmarkMessage, BENCHMARK_RING_CAPACITY> BenchmarkRing;
+
+class CurrentTaskBlocker;
+class LatencyHistogram;
+
+class RingConsumerAction : public TaskAction {
+  BenchmarkRing *ring;
+  LatencyHistogram& transit_micros;
+  CurrentTaskBlocker *on_done;
+  volatile uint32_t expected_count;
+  uint32_t received_count;
+
+public:
+  /**
+   * Creates a consumer bound to the specified ring
+   *
+   * Parameters:
+   *
+   * Name           Contents
+   * -------------- ----------------------------------------------------------
+   * ring           The ring to drain
+   * transit_micros Receives the time between send and receipt of each
+   *                message in microseconds
+   */
+  RingConsumerAction(
+      BenchmarkRing *ring,
+      LatencyHistogram& transit_micros);
+  virtual ~RingConsumerAction();
+
+  /**
+   * Prepares for a benchmark run. Invoke before sending the first message.
+   *
+   * Parameters:
+   *
+   * Name           Contents
+   * -------------- ----------------------------------------------------------
+   * message_count  The number of messages that the run will send
+   * on_done        Notified when the last message arrives
+   */
+  void expect(uint32_t message_count, CurrentTaskBlocker *on_done);
+
+  /**
+   * Pulls messages forever, notifying on_done when the expected number
+   * of messages has arrived.
+   */
+  virtual void run(void);
+};
+
+#endif /* RINGCONSUMERACTION_H_ */
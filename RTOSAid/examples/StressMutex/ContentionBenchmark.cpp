@@ -0,0 +1,148 @@
+/*
+ * ContentionBenchmark.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ContentionBenchmark.h"
+
+#include "ContentionReaderAction.h"
+#include "MutexLock.h"
+#include "TaskWithActionH.h"
+
+ContentionBenchmark::ContentionBenchmark() {
+  fill_table(0);
+}
+
+ContentionBenchmark::~ContentionBenchmark() {
+}
+
+bool ContentionBenchmark::begin(void) {
+  return mutex.begin() && read_write_mutex.begin();
+}
+
+void ContentionBenchmark::fill_table(uint32_t value) {
+  for (size_t i = 0; i < TABLE_SIZE; ++i) {
+    table[i] = value;
+  }
+}
+
+uint32_t ContentionBenchmark::measure(
+    BenchmarkLock lock, uint32_t *torn_reads) {
+  ContentionReaderAction *actions[READER_COUNT];
+  TaskWithActionH *tasks[READER_COUNT];
+  bool started = true;
+
+  for (size_t i = 0; i < READER_COUNT; ++i) {
+    actions[i] = new ContentionReaderAction(*this, lock);
+    tasks[i] = new TaskWithActionH(
+        "Reader",
+        READER_PRIORITY,
+        actions[i],
+        READER_STACK_SIZE,
+        i % portNUM_PROCESSORS);
+    started = tasks[i]->start() && started;
+  }
+
+  // Update the table periodically while the readers run.
+  uint32_t value = 0;
+  for (uint32_t elapsed = 0;
+      started && elapsed < RUN_MILLIS;
+      elapsed += WRITE_INTERVAL_MILLIS) {
+    write_table(lock, ++value);
+    vTaskDelay(pdMS_TO_TICKS(WRITE_INTERVAL_MILLIS));
+  }
+
+  uint32_t reads = 0;
+  *torn_reads = 0;
+  for (size_t i = 0; i < READER_COUNT; ++i) {
+    tasks[i]->cancel();
+    tasks[i]->join();
+    reads += actions[i]->read_count();
+    *torn_reads += actions[i]->torn_read_count();
+    delete tasks[i];
+    delete actions[i];
+  }
+  return started ? reads : 0;
+}
+
+bool ContentionBenchmark::read_table(BenchmarkLock lock) {
+  bool consistent = false;
+  if (lock == BenchmarkLock::MUTEX) {
+    MutexLock guard(mutex);
+    consistent = scan_table();
+  } else {
+    ReadLock guard(read_write_mutex);
+    consistent = scan_table();
+  }
+  return consistent;
+}
+
+void ContentionBenchmark::run(void) {
+  // The benchmark must outrank the readers, or they would keep it from
+  // writing the table and from stopping them on time.
+  UBaseType_t original_priority = uxTaskPriorityGet(NULL);
+  vTaskPrioritySet(NULL, READER_PRIORITY + 1);
+
+  uint32_t mutex_torn_reads = 0;
+  uint32_t mutex_reads = measure(BenchmarkLock::MUTEX, &mutex_torn_reads);
+  uint32_t read_write_torn_reads = 0;
+  uint32_t read_write_reads =
+      measure(BenchmarkLock::READ_WRITE_MUTEX, &read_write_torn_reads);
+
+  vTaskPrioritySet(NULL, original_priority);
+
+  Serial.printf(
+      "Contention benchmark, %u readers for %lu ms:\n",
+      static_cast<unsigned>(READER_COUNT),
+      static_cast<unsigned long>(RUN_MILLIS));
+  Serial.printf(
+      "  Mutex:          %lu reads/s, %lu torn.\n",
+      static_cast<unsigned long>(mutex_reads * 1000ULL / RUN_MILLIS),
+      static_cast<unsigned long>(mutex_torn_reads));
+  Serial.printf(
+      "  ReadWriteMutex: %lu reads/s, %lu torn.\n",
+      static_cast<unsigned long>(read_write_reads * 1000ULL / RUN_MILLIS),
+      static_cast<unsigned long>(read_write_torn_reads));
+  if (mutex_reads) {
+    Serial.printf(
+        "  Speedup:        %.2f\n",
+        static_cast<double>(read_write_reads) / mutex_reads);
+  }
+}
+
+bool ContentionBenchmark::scan_table(void) {
+  uint32_t first = table[0];
+  bool consistent = true;
+  for (size_t i = 1; i < TABLE_SIZE; ++i) {
+    consistent = (table[i] == first) && consistent;
+  }
+  return consistent;
+}
+
+void ContentionBenchmark::write_table(BenchmarkLock lock, uint32_t value) {
+  if (lock == BenchmarkLock::MUTEX) {
+    MutexLock guard(mutex);
+    fill_table(value);
+  } else {
+    WriteLock guard(read_write_mutex);
+    fill_table(value);
+  }
+}
@@ -0,0 +1,128 @@
+/*
+ * ContentionBenchmark.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Measures read throughput of a table that many tasks read and one task
+ * occasionally writes, first with the table guarded by a Mutex and then
+ * by a ReadWriteMutex.
+ *
+ * READER_COUNT reader tasks, spread across both cores, read the table
+ * as fast as they can while the task running the benchmark rewrites it
+ * every WRITE_INTERVAL_MILLIS. A Mutex serializes the readers; a
+ * ReadWriteMutex lets them read concurrently, so its read count should
+ * be considerably higher.
+ *
+ * The readers never block under the ReadWriteMutex, so they starve the
+ * idle tasks while the benchmark runs. Keep RUN_MILLIS well below the
+ * task watchdog timeout.
+ */
+
+#ifndef CONTENTIONBENCHMARK_H_
+#define CONTENTIONBENCHMARK_H_
+
+#include "Arduino.h"
+
+#include "Mutex.h"
+#include "ReadWriteMutex.h"
+
+enum class BenchmarkLock {
+  MUTEX,
+  READ_WRITE_MUTEX,
+};
+
+class ContentionBenchmark {
+public:
+  static const size_t READER_COUNT = 4;
+  static const UBaseType_t READER_PRIORITY = 1;
+  static const uint32_t RUN_MILLIS = 2000;
+  static const uint32_t WRITE_INTERVAL_MILLIS = 20;
+
+private:
+  static const size_t TABLE_SIZE = 256;
+  static const size_t READER_STACK_SIZE = 2048;
+
+  /**
+   * The writer sets every entry to the same value, so a reader that
+   * finds differing entries has seen a partial write.
+   */
+  volatile uint32_t table[TABLE_SIZE];
+  Mutex mutex;
+  ReadWriteMutex read_write_mutex;
+
+  /**
+   * Runs the readers against the specified lock for RUN_MILLIS.
+   *
+   * Parameters:
+   *
+   * Name       Contents
+   * ---------- ---------------------------------------------------------------
+   * lock       The lock that guards the table
+   * torn_reads Receives the number of inconsistent reads, which should
+   *            be 0.
+   *
+   * Returns: the total number of reads, or 0 if a reader failed to start.
+   */
+  uint32_t measure(BenchmarkLock lock, uint32_t *torn_reads);
+
+  /**
+   * Reads the table without locking.
+   *
+   * Returns: true if every entry had the same value.
+   */
+  bool scan_table(void);
+
+  /**
+   * Writes the table without locking.
+   */
+  void fill_table(uint32_t value);
+
+public:
+  ContentionBenchmark();
+  virtual ~ContentionBenchmark();
+
+  /**
+   * Initializes the locks.
+   *
+   * Returns: true if both locks are ready, false otherwise.
+   */
+  bool begin(void);
+
+  /**
+   * Reads the table under the specified lock.
+   *
+   * Returns: true if the read was consistent, false if it saw a partial
+   *          write.
+   */
+  bool read_table(BenchmarkLock lock);
+
+  /**
+   * Runs the benchmark with each lock in turn and prints the results to
+   * Serial. The invoking task must not hold either lock.
+   */
+  void run(void);
+
+  /**
+   * Writes the table under the specified lock.
+   */
+  void write_table(BenchmarkLock lock, uint32_t value);
+};
+
+#endif /* CONTENTIONBENCHMARK_H_ */
@@ -0,0 +1,47 @@
+/*
+ * ContentionReaderAction.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ContentionReaderAction.h"
+
+#include "ContentionBenchmark.h"
+
+ContentionReaderAction::ContentionReaderAction(
+    ContentionBenchmark& benchmark,
+    BenchmarkLock lock) :
+        benchmark(benchmark),
+        lock(lock),
+        reads(0),
+        torn_reads(0) {
+}
+
+ContentionReaderAction::~ContentionReaderAction() {
+}
+
+void ContentionReaderAction::run(void) {
+  while (!cancelled()) {
+    if (!benchmark.read_table(lock)) {
+      ++torn_reads;
+    }
+    ++reads;
+  }
+}
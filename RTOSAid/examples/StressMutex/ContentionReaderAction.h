@@ -0,0 +1,78 @@
+/*
+ * ContentionReaderAction.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A TaskAction that reads the ContentionBenchmark table as fast as it
+ * can until it is cancelled, counting the reads.
+ */
+
+#ifndef CONTENTIONREADERACTION_H_
+#define CONTENTIONREADERACTION_H_
+
+#include "Arduino.h"
+#include "TaskAction.h"
+
+class ContentionBenchmark;
+enum class BenchmarkLock;
+
+class ContentionReaderAction : public TaskAction {
+  ContentionBenchmark& benchmark;
+  const BenchmarkLock lock;
+  uint32_t reads;
+  uint32_t torn_reads;
+
+public:
+  /**
+   * Creates an instance that reads the benchmark's table
+   *
+   * Parameters:
+   *
+   * Name      Contents
+   * --------- ----------------------------------------------------------------
+   * benchmark The benchmark that owns the table
+   * lock      Which of the benchmark's locks guards the reads
+   */
+  ContentionReaderAction(ContentionBenchmark& benchmark, BenchmarkLock lock);
+  virtual ~ContentionReaderAction();
+
+  /**
+   * Returns: the number of completed reads. Only meaningful once the task
+   *          running the action has been joined.
+   */
+  inline uint32_t read_count(void) const {
+    return reads;
+  }
+
+  /**
+   * Returns: the number of reads that saw a partially written table.
+   *          Anything other than 0 means that the lock failed.
+   */
+  inline uint32_t torn_read_count(void) const {
+    return torn_reads;
+  }
+
+  /**
+   * Reads the table until cancelled.
+   */
+  virtual void run(void);
+};
+
+#endif /* CONTENTIONREADERACTION_H_ */
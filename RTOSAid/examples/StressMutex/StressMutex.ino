@@ -39,12 +39,17 @@
  *
  * Note that the task briefly illuminates all LEDS when it starts to
  * ensure that the LEDs are connected correctly.
+ *
+ * Before starting the stress test, the sketch runs a contention benchmark
+ * that compares Mutex and ReadWriteMutex read throughput and prints the
+ * results.
  */
 
 #include <StressTestBlinkAction.h>
 
 #include "Arduino.h"
 #include "AssailantAction.h"
+#include "ContentionBenchmark.h"
 #include "TargetClass.h"
 
 #define RED_LED_PIN 13
@@ -63,6 +68,8 @@ static TaskWithAction blink_task(
 
 static TargetClass target;
 
+static ContentionBenchmark benchmark;
+
 /**
  * The low priority assailant, which illuminates the yellow LED when it
  * holds the semaphore
@@ -113,13 +120,15 @@ void setup() {
   digitalWrite(GREEN_LED_PIN, LOW);
   digitalWrite(BLUE_LED_PIN, LOW);
 
-  if (!target.begin()) {
+  if (!target.begin() || !benchmark.begin()) {
     Serial.println("Mutex initialization failed.");
     for (;;) {
       vTaskDelay(portMAX_DELAY);
     }
   }
 
+  benchmark.run();
+
   blink_task.start();
   low_priority_task.start();
   high_priority_task.start();
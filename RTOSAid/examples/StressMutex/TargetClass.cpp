@@ -32,6 +32,7 @@ TargetClass::~TargetClass() {
 }
 
 bool TargetClass::begin(void) {
+  mutex.set_name("target");
   return mutex.begin();
 }
 
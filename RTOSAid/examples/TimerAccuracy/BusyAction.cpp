@@ -0,0 +1,42 @@
+/*
+ * BusyAction.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "BusyAction.h"
+
+#include "esp_timer.h"
+
+BusyAction::BusyAction(uint32_t spin_micros) :
+    spin_micros(spin_micros) {
+}
+
+BusyAction::~BusyAction() {
+}
+
+void BusyAction::run(void) {
+  while (!cancelled()) {
+    int64_t spin_until = esp_timer_get_time() + spin_micros;
+    while (esp_timer_get_time() < spin_until) {
+    }
+    vTaskDelay(1);
+  }
+}
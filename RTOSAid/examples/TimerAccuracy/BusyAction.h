@@ -0,0 +1,55 @@
+/*
+ * BusyAction.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Background CPU load: a TaskAction that spins for a configurable time,
+ * pauses for one tick, and repeats until it is cancelled. The pause lets
+ * lower priority tasks, including the FreeRTOS timer service and the idle
+ * tasks, run now and then.
+ */
+
+#ifndef BUSYACTION_H_
+#define BUSYACTION_H_
+
+#include "Arduino.h"
+
+#include "TaskAction.h"
+
+class BusyAction : public TaskAction {
+  const uint32_t spin_micros;
+
+public:
+  /**
+   * Creates the action
+   *
+   * Parameters:
+   *
+   * Name        Contents
+   * ----------- --------------------------------------------------------------
+   * spin_micros How long to spin between pauses, in microseconds
+   */
+  BusyAction(uint32_t spin_micros);
+  virtual ~BusyAction();
+
+  virtual void run(void);
+};
+
+#endif /* BUSYACTION_H_ */
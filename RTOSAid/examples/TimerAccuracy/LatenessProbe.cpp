@@ -0,0 +1,59 @@
+/*
+ * LatenessProbe.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LatenessProbe.h"
+
+#include "LatenessRecorder.h"
+
+#include "esp_timer.h"
+
+LatenessProbe::LatenessProbe(LatenessRecorder& recorder) :
+    recorder(recorder),
+    deadline_micros(0),
+    period_micros(0),
+    remaining_count(0) {
+}
+
+LatenessProbe::~LatenessProbe() {
+}
+
+void IRAM_ATTR LatenessProbe::apply(void) {
+  int64_t now = esp_timer_get_time();
+  if (!remaining_count) {
+    return;
+  }
+  recorder.record(now - deadline_micros);
+  deadline_micros = deadline_micros + period_micros;
+  if (--remaining_count == 0) {
+    recorder.probe_finished();
+  }
+}
+
+void LatenessProbe::arm(
+    int64_t deadline_micros,
+    uint32_t period_micros,
+    uint32_t expirations) {
+  this->deadline_micros = deadline_micros;
+  this->period_micros = period_micros;
+  remaining_count = expirations;
+}
@@ -0,0 +1,70 @@
+/*
+ * LatenessProbe.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A VoidFunction, bound to a single timer, that knows when the timer is
+ * due to fire and reports how late each expiration is to a
+ * LatenessRecorder. A probe can follow a one shot timer, which expires
+ * once, or a free running timer, whose deadlines are a period apart.
+ * Expirations beyond the expected number are ignored.
+ */
+
+#ifndef LATENESSPROBE_H_
+#define LATENESSPROBE_H_
+
+#include "Arduino.h"
+
+#include "VoidFunction.h"
+
+class LatenessRecorder;
+
+class LatenessProbe : public VoidFunction {
+  LatenessRecorder& recorder;
+  volatile int64_t deadline_micros;
+  volatile uint32_t period_micros;
+  volatile uint32_t remaining_count;
+
+public:
+  LatenessProbe(LatenessRecorder& recorder);
+  virtual ~LatenessProbe();
+
+  virtual void IRAM_ATTR apply(void);
+
+  /**
+   * Prepares for an imminent timer start. The caller must start the
+   * timer immediately afterward.
+   *
+   * Parameters:
+   *
+   * Name            Contents
+   * --------------- ----------------------------------------------------------
+   * deadline_micros When the first expiration is due, as returned by
+   *                 esp_timer_get_time()
+   * period_micros   The time between expirations, 0 for a one shot timer
+   * expirations     The number of expirations to record
+   */
+  void arm(
+      int64_t deadline_micros,
+      uint32_t period_micros = 0,
+      uint32_t expirations = 1);
+};
+
+#endif /* LATENESSPROBE_H_ */
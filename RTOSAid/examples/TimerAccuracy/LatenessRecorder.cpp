@@ -0,0 +1,78 @@
+/*
+ * LatenessRecorder.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LatenessRecorder.h"
+
+#include "CurrentTaskBlocker.h"
+
+LatenessRecorder::LatenessRecorder(const char *title, bool from_isr) :
+    title(title),
+    from_isr(from_isr),
+    on_done(NULL),
+    active_probes(0),
+    early_count(0) {
+}
+
+LatenessRecorder::~LatenessRecorder() {
+}
+
+void LatenessRecorder::clear(void) {
+  lateness_micros.clear();
+  early_count = 0;
+}
+
+void LatenessRecorder::expect(
+    uint32_t probe_count, CurrentTaskBlocker *on_done) {
+  this->on_done = on_done;
+  active_probes = probe_count;
+}
+
+void LatenessRecorder::print(Print& out) const {
+  out.printf(
+      "  %-26s %6lu samples, p50 %6lu us, p99 %6lu us, max %6lu us, "
+      "%lu early.\n",
+      title,
+      static_cast<unsigned long>(lateness_micros.count()),
+      static_cast<unsigned long>(lateness_micros.percentile(50)),
+      static_cast<unsigned long>(lateness_micros.percentile(99)),
+      static_cast<unsigned long>(lateness_micros.maximum()),
+      static_cast<unsigned long>(early_count));
+}
+
+void IRAM_ATTR LatenessRecorder::probe_finished(void) {
+  if (--active_probes == 0) {
+    if (from_isr) {
+      on_done->notify_from_isr();
+    } else {
+      on_done->notify();
+    }
+  }
+}
+
+void IRAM_ATTR LatenessRecorder::record(int64_t lateness) {
+  if (lateness < 0) {
+    ++early_count;
+    lateness = 0;
+  }
+  lateness_micros.record(static_cast<uint32_t>(lateness));
+}
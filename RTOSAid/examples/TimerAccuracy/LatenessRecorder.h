@@ -0,0 +1,105 @@
+/*
+ * LatenessRecorder.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Collects firing lateness for one timer class. Every timer of the class
+ * is bound to a LatenessProbe that reports here. Timers of a class fire
+ * from a single context, the FreeRTOS timer service task, the ESP timer
+ * task, or the timer interrupt, so the recorder needs no lock. A round of
+ * measurements ends when every probe has seen all of its expirations, at
+ * which point the recorder notifies the task that armed the timers.
+ */
+
+#ifndef LATENESSRECORDER_H_
+#define LATENESSRECORDER_H_
+
+#include "Arduino.h"
+
+#include "LatencyHistogram.h"
+
+class CurrentTaskBlocker;
+
+class LatenessRecorder {
+  const char *title;
+  const bool from_isr;
+  LatencyHistogram lateness_micros;
+  CurrentTaskBlocker *on_done;
+  volatile uint32_t active_probes;
+  volatile uint32_t early_count;
+
+public:
+  /**
+   * Creates a recorder
+   *
+   * Parameters:
+   *
+   * Name        Contents
+   * ----------- --------------------------------------------------------------
+   * title       Heads the recorder's output, usually the timer class name
+   * from_isr    true if the timers fire from an interrupt, false if they
+   *             fire from a task.
+   */
+  LatenessRecorder(const char *title, bool from_isr = false);
+  virtual ~LatenessRecorder();
+
+  /**
+   * Discards all samples.
+   */
+  void clear(void);
+
+  /**
+   * Starts a round
+   *
+   * Parameters:
+   *
+   * Name        Contents
+   * ----------- --------------------------------------------------------------
+   * probe_count The number of probes armed for the round
+   * on_done     Notified when every probe has finished
+   */
+  void expect(uint32_t probe_count, CurrentTaskBlocker *on_done);
+
+  /**
+   * Prints the sample count, the 50th and 99th percentiles, the maximum,
+   * and the number of early expirations on a single line.
+   */
+  void print(Print& out) const;
+
+  /**
+   * Invoked by a probe that has seen all of its expirations
+   */
+  void IRAM_ATTR probe_finished(void);
+
+  /**
+   * Records one expiration
+   *
+   * Parameters:
+   *
+   * Name           Contents
+   * -------------- -----------------------------------------------------------
+   * lateness       Time from the deadline to the expiration, in
+   *                microseconds. Early expirations, which are negative,
+   *                are counted and recorded as 0.
+   */
+  void IRAM_ATTR record(int64_t lateness);
+};
+
+#endif /* LATENESSRECORDER_H_ */
@@ -0,0 +1,344 @@
+/**
+ * TimerAccuracy.ino
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Measures how late RTOSAid timers fire, with and without background
+ * load. For each timer class, OneShotTimerH, FreeRunningTimerH, and
+ * MicrosecondTimer with task and with ISR dispatch, the sketch arms
+ * TIMERS_PER_CLASS timers with known deadlines, ROUNDS times, and records
+ * how late each expiration is. It does this four times:
+ *
+ * 1. On an otherwise idle system,
+ * 2. While BUSY_TASK_COUNT tasks keep the cores busy,
+ * 3. While TRAFFIC_PAIR_COUNT producer and consumer task pairs pass
+ *    messages through queues as fast as they can, and
+ * 4. Under both loads at once.
+ *
+ * For each timer class, it prints the sample count, the 50th and 99th
+ * percentile lateness, the maximum lateness, and the number of
+ * expirations that came early, which should be 0. Adjust the #defines
+ * below to change the timers and the load.
+ *
+ * FreeRTOS timers count time in scheduler ticks, so the sketch arms them
+ * immediately after a tick begins and measures their deadlines from that
+ * moment. The arming task runs at ARMING_PRIORITY, above the load, so
+ * that load delays the timers and not the measurement.
+ */
+
+#include "Arduino.h"
+
+#include "BusyAction.h"
+#include "CurrentTaskBlocker.h"
+#include "FreeRunningTimerH.h"
+#include "LatenessProbe.h"
+#include "LatenessRecorder.h"
+#include "MicrosecondTimer.h"
+#include "OneShotTimerH.h"
+#include "PullQueueT.h"
+#include "TaskWithActionH.h"
+#include "TrafficConsumerAction.h"
+#include "TrafficProducerAction.h"
+
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/timers.h"
+
+// Timers
+#define TIMERS_PER_CLASS 16
+#define ROUNDS 25
+#define MAX_TICKS 20               // Longest tick timer duration
+#define MIN_MICROS 100             // Shortest MicrosecondTimer duration
+#define MAX_MICROS 20000           // Longest MicrosecondTimer duration
+#define FREE_RUNNING_EXPIRATIONS 4 // Per free running timer per round
+#define ARMING_PRIORITY 20
+
+// Load
+#define BUSY_TASK_COUNT 2
+#define BUSY_PRIORITY 5
+#define BUSY_SPIN_MICROS 3000
+#define TRAFFIC_PAIR_COUNT 2
+#define TRAFFIC_PRIORITY 4
+#define TRAFFIC_QUEUE_LENGTH 8
+
+#define LOAD_BUSY 1
+#define LOAD_TRAFFIC 2
+
+static const int64_t TICK_MICROS = portTICK_PERIOD_MS * 1000;
+
+static LatenessRecorder one_shot_recorder("OneShotTimerH");
+static LatenessProbe *one_shot_probes[TIMERS_PER_CLASS];
+static OneShotTimerH *one_shot_timers[TIMERS_PER_CLASS];
+
+static LatenessRecorder free_running_recorder("FreeRunningTimerH");
+static LatenessProbe *free_running_probes[TIMERS_PER_CLASS];
+static FreeRunningTimerH *free_running_timers[TIMERS_PER_CLASS];
+
+static LatenessRecorder task_timer_recorder("MicrosecondTimer (TASK)");
+static LatenessProbe *task_timer_probes[TIMERS_PER_CLASS];
+static MicrosecondTimer *task_timers[TIMERS_PER_CLASS];
+
+static LatenessRecorder isr_timer_recorder("MicrosecondTimer (ISR)", true);
+static LatenessProbe *isr_timer_probes[TIMERS_PER_CLASS];
+static MicrosecondTimer *isr_timers[TIMERS_PER_CLASS];
+static bool isr_dispatch_available = true;
+
+static TaskWithActionH *busy_tasks[BUSY_TASK_COUNT];
+
+static uint32_t traffic_storage[TRAFFIC_PAIR_COUNT][TRAFFIC_QUEUE_LENGTH];
+static TaskWithActionH *traffic_tasks[2 * TRAFFIC_PAIR_COUNT];
+
+static void halt(const char *message) {
+  Serial.println(message);
+  for (;;) {
+    vTaskDelay(portMAX_DELAY);
+  }
+}
+
+static void notify_blocker(void *blocker, uint32_t) {
+  static_cast<CurrentTaskBlocker *>(blocker)->notify();
+}
+
+/*
+ * Waits until the timer service has processed every command sent
+ * before the call.
+ */
+static void drain_timer_commands(void) {
+  CurrentTaskBlocker drained;
+  xTimerPendFunctionCall(notify_blocker, &drained, 0, portMAX_DELAY);
+  drained.wait();
+}
+
+/*
+ * Waits for the start of the next scheduler tick.
+ *
+ * Returns: the time the tick started, as nearly as the arming task,
+ * which preempts the load, can tell.
+ */
+static int64_t next_tick_micros(void) {
+  vTaskDelay(1);
+  return esp_timer_get_time();
+}
+
+static void create_timers(void) {
+  for (uint32_t i = 0; i < TIMERS_PER_CLASS; ++i) {
+    one_shot_probes[i] = new LatenessProbe(one_shot_recorder);
+    one_shot_timers[i] =
+        new OneShotTimerH("OneShot", *one_shot_probes[i], portMAX_DELAY);
+
+    // Cycle times of 1 to 8 ticks
+    free_running_probes[i] = new LatenessProbe(free_running_recorder);
+    free_running_timers[i] = new FreeRunningTimerH(
+        "FreeRunning", *free_running_probes[i], 1 + i % 8, portMAX_DELAY);
+
+    task_timer_probes[i] = new LatenessProbe(task_timer_recorder);
+    task_timers[i] = new MicrosecondTimer(
+        "TaskDispatch", task_timer_probes[i], MicrosecondTimer::TASK);
+
+    isr_timer_probes[i] = new LatenessProbe(isr_timer_recorder);
+    isr_timers[i] = new MicrosecondTimer(
+        "IsrDispatch", isr_timer_probes[i], MicrosecondTimer::ISR);
+
+    if (!one_shot_timers[i]->begin()
+        || !free_running_timers[i]->begin()
+        || !task_timers[i]->begin()) {
+      halt("Timer initialization failed.");
+    }
+    isr_dispatch_available = isr_dispatch_available && isr_timers[i]->begin();
+  }
+}
+
+static void create_load(void) {
+  for (uint32_t i = 0; i < BUSY_TASK_COUNT; ++i) {
+    // Each task needs its own action, which binds to the task.
+    busy_tasks[i] = new TaskWithActionH(
+        "Busy",
+        BUSY_PRIORITY,
+        new BusyAction(BUSY_SPIN_MICROS),
+        2048,
+        i % 2);
+  }
+  for (uint32_t i = 0; i < TRAFFIC_PAIR_COUNT; ++i) {
+    PullQueueT<uint32_t> *queue = new PullQueueT<uint32_t>(
+        traffic_storage[i], TRAFFIC_QUEUE_LENGTH);
+    if (!queue->begin()) {
+      halt("Traffic queue initialization failed.");
+    }
+    traffic_tasks[2 * i] = new TaskWithActionH(
+        "Producer",
+        TRAFFIC_PRIORITY,
+        new TrafficProducerAction(*queue),
+        2048);
+    traffic_tasks[2 * i + 1] = new TaskWithActionH(
+        "Consumer",
+        TRAFFIC_PRIORITY,
+        new TrafficConsumerAction(*queue),
+        2048);
+  }
+}
+
+static void start_load(uint32_t load) {
+  if (load & LOAD_BUSY) {
+    for (TaskWithActionH *task : busy_tasks) {
+      if (!task->start()) {
+        halt("Busy task startup failed.");
+      }
+    }
+  }
+  if (load & LOAD_TRAFFIC) {
+    for (TaskWithActionH *task : traffic_tasks) {
+      if (!task->start()) {
+        halt("Traffic task startup failed.");
+      }
+    }
+  }
+}
+
+static void stop_load(uint32_t load) {
+  if (load & LOAD_BUSY) {
+    for (TaskWithActionH *task : busy_tasks) {
+      task->cancel();
+    }
+    for (TaskWithActionH *task : busy_tasks) {
+      task->join();
+    }
+  }
+  if (load & LOAD_TRAFFIC) {
+    for (TaskWithActionH *task : traffic_tasks) {
+      task->cancel();
+    }
+    for (TaskWithActionH *task : traffic_tasks) {
+      task->join();
+    }
+  }
+}
+
+static void measure_one_shot_timers(void) {
+  CurrentTaskBlocker done;
+  for (uint32_t round = 0; round < ROUNDS; ++round) {
+    one_shot_recorder.expect(TIMERS_PER_CLASS, &done);
+    int64_t tick_micros = next_tick_micros();
+    for (uint32_t i = 0; i < TIMERS_PER_CLASS; ++i) {
+      TickType_t ticks = random(1, MAX_TICKS + 1);
+      one_shot_probes[i]->arm(tick_micros + ticks * TICK_MICROS);
+      one_shot_timers[i]->start_ticks(ticks, portMAX_DELAY);
+    }
+    done.wait();
+  }
+}
+
+static void measure_free_running_timers(void) {
+  CurrentTaskBlocker done;
+  for (uint32_t round = 0; round < ROUNDS; ++round) {
+    free_running_recorder.expect(TIMERS_PER_CLASS, &done);
+    int64_t tick_micros = next_tick_micros();
+    for (uint32_t i = 0; i < TIMERS_PER_CLASS; ++i) {
+      uint32_t period_micros = (1 + i % 8) * TICK_MICROS;
+      free_running_probes[i]->arm(
+          tick_micros + period_micros,
+          period_micros,
+          FREE_RUNNING_EXPIRATIONS);
+      free_running_timers[i]->start(portMAX_DELAY);
+    }
+    done.wait();
+    for (FreeRunningTimerH *timer : free_running_timers) {
+      timer->stop(portMAX_DELAY);
+    }
+    // Keep a stopping timer's last expiration out of the next round.
+    drain_timer_commands();
+  }
+}
+
+static void measure_microsecond_timers(
+    LatenessRecorder& recorder,
+    LatenessProbe **probes,
+    MicrosecondTimer **timers) {
+  CurrentTaskBlocker done;
+  for (uint32_t round = 0; round < ROUNDS; ++round) {
+    recorder.expect(TIMERS_PER_CLASS, &done);
+    for (uint32_t i = 0; i < TIMERS_PER_CLASS; ++i) {
+      uint32_t micros = random(MIN_MICROS, MAX_MICROS + 1);
+      probes[i]->arm(esp_timer_get_time() + micros);
+      timers[i]->start(micros);
+    }
+    done.wait();
+  }
+}
+
+static void measure(uint32_t load, const char *description) {
+  Serial.println(description);
+  one_shot_recorder.clear();
+  free_running_recorder.clear();
+  task_timer_recorder.clear();
+  isr_timer_recorder.clear();
+
+  start_load(load);
+  measure_one_shot_timers();
+  measure_free_running_timers();
+  measure_microsecond_timers(
+      task_timer_recorder, task_timer_probes, task_timers);
+  if (isr_dispatch_available) {
+    measure_microsecond_timers(
+        isr_timer_recorder, isr_timer_probes, isr_timers);
+  }
+  stop_load(load);
+
+  one_shot_recorder.print(Serial);
+  free_running_recorder.print(Serial);
+  task_timer_recorder.print(Serial);
+  if (isr_dispatch_available) {
+    isr_timer_recorder.print(Serial);
+  } else {
+    Serial.println("  MicrosecondTimer (ISR)     not available.");
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial.printf(
+      "Timer accuracy built on %s at %s, CPU at %lu MHz.\n",
+      __DATE__,
+      __TIME__,
+      static_cast<unsigned long>(getCpuFrequencyMhz()));
+  Serial.printf(
+      "%lu timers per class, %lu rounds, %lu busy tasks, "
+      "%lu queue pairs.\n",
+      static_cast<unsigned long>(TIMERS_PER_CLASS),
+      static_cast<unsigned long>(ROUNDS),
+      static_cast<unsigned long>(BUSY_TASK_COUNT),
+      static_cast<unsigned long>(TRAFFIC_PAIR_COUNT));
+
+  // Arm timers promptly, whatever the load.
+  vTaskPrioritySet(NULL, ARMING_PRIORITY);
+
+  create_timers();
+  create_load();
+
+  measure(0, "Idle:");
+  measure(LOAD_BUSY, "Busy tasks:");
+  measure(LOAD_TRAFFIC, "Queue traffic:");
+  measure(LOAD_BUSY | LOAD_TRAFFIC, "Busy tasks and queue traffic:");
+
+  Serial.println("Benchmark completed.");
+}
+
+void loop() {
+  vTaskDelay(portMAX_DELAY);
+}
@@ -0,0 +1,45 @@
+/*
+ * TrafficConsumerAction.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Background queue load: a TaskAction that pulls messages from a queue
+ * and discards them until it is cancelled.
+ */
+
+#ifndef TRAFFICCONSUMERACTION_H_
+#define TRAFFICCONSUMERACTION_H_
+
+#include "Arduino.h"
+
+#include "PullQueueT.h"
+#include "TaskAction.h"
+
+class TrafficConsumerAction : public TaskAction {
+  PullQueueT<uint32_t>& queue;
+
+public:
+  TrafficConsumerAction(PullQueueT<uint32_t>& queue);
+  virtual ~TrafficConsumerAction();
+
+  virtual void run(void);
+};
+
+#endif /* TRAFFICCONSUMERACTION_H_ */
@@ -0,0 +1,46 @@
+/*
+ * TrafficProducerAction.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Background queue load: a TaskAction that sends messages to a queue as
+ * fast as the queue accepts them until it is cancelled. Paired with a
+ * TrafficConsumerAction, it keeps both tasks switching in and out.
+ */
+
+#ifndef TRAFFICPRODUCERACTION_H_
+#define TRAFFICPRODUCERACTION_H_
+
+#include "Arduino.h"
+
+#include "PullQueueT.h"
+#include "TaskAction.h"
+
+class TrafficProducerAction : public TaskAction {
+  PullQueueT<uint32_t>& queue;
+
+public:
+  TrafficProducerAction(PullQueueT<uint32_t>& queue);
+  virtual ~TrafficProducerAction();
+
+  virtual void run(void);
+};
+
+#endif /* TRAFFICPRODUCERACTION_H_ */
@@ -0,0 +1,60 @@
+/*
+ * CountingFunction.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "CountingFunction.h"
+
+#include "CurrentTaskBlocker.h"
+
+#include "esp_timer.h"
+
+CountingFunction::CountingFunction() :
+    on_done(NULL),
+    expected_count(0),
+    count(0),
+    first_micros(0),
+    last_micros(0) {
+}
+
+CountingFunction::~CountingFunction() {
+}
+
+void CountingFunction::apply(void) {
+  // Only the timer service invokes the function, so the increment
+  // does not race.
+  last_micros = esp_timer_get_time();
+  if (!count) {
+    first_micros = last_micros;
+  }
+  if (++count == expected_count && on_done) {
+    on_done->notify();
+  }
+}
+
+void CountingFunction::expect(
+    uint32_t expected_count, CurrentTaskBlocker *on_done) {
+  this->on_done = on_done;
+  count = 0;
+  first_micros = 0;
+  last_micros = 0;
+  this->expected_count = expected_count;
+}
@@ -0,0 +1,79 @@
+/*
+ * CountingFunction.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A VoidFunction that counts its invocations, time stamps the first and
+ * the last, and notifies a waiting task when the count reaches an
+ * expected value.
+ */
+
+#ifndef COUNTINGFUNCTION_H_
+#define COUNTINGFUNCTION_H_
+
+#include "Arduino.h"
+
+#include "VoidFunction.h"
+
+class CurrentTaskBlocker;
+
+class CountingFunction : public VoidFunction {
+  CurrentTaskBlocker *on_done;
+  volatile uint32_t expected_count;
+  volatile uint32_t count;
+  int64_t first_micros;
+  int64_t last_micros;
+
+public:
+  CountingFunction();
+  virtual ~CountingFunction();
+
+  virtual void apply(void);
+
+  /**
+   * Returns: the time between the first and the most recent invocation
+   *          since the most recent expect(), in microseconds.
+   */
+  inline int64_t elapsed_micros(void) const {
+    return last_micros - first_micros;
+  }
+
+  /**
+   * Returns: the number of invocations since the most recent expect().
+   */
+  inline uint32_t invocations(void) const {
+    return count;
+  }
+
+  /**
+   * Zeros the count and arms notification.
+   *
+   * Parameters:
+   *
+   * Name           Contents
+   * -------------- -----------------------------------------------------------
+   * expected_count The count at which to notify
+   * on_done        Notified when the count reaches expected_count, NULL
+   *                to skip notification.
+   */
+  void expect(uint32_t expected_count, CurrentTaskBlocker *on_done);
+};
+
+#endif /* COUNTINGFUNCTION_H_ */
@@ -0,0 +1,248 @@
+/**
+ * TimingWheelBenchmark.ino
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Compares a TimingWheel with FreeRTOS software timers, the mechanism
+ * behind BaseTimerH, OneShotTimerH, and FreeRunningTimerH. For 1,000,
+ * 10,000, and 100,000 timers, the sketch measures the cost of
+ *
+ * 1. Starting every timer with a random duration,
+ * 2. Restarting every timer,
+ * 3. Stopping every timer, and
+ * 4. Firing every timer, with all timers due on the same tick.
+ *
+ * and prints the cost per timer in nanoseconds to the serial port.
+ *
+ * FreeRTOS timers do their work on the timer service (i.e. daemon) task,
+ * which receives commands through a short queue. Their costs run from the
+ * first command until the daemon has processed the last, so they include
+ * the daemon's work. The sketch drives the wheel itself, one advance()
+ * per tick, so no task switching is involved.
+ *
+ * The sketch creates as many FreeRTOS timers as memory allows, and
+ * reports how many it created. Counts whose timer arrays do not fit in
+ * memory are skipped. 100,000 timers need PSRAM.
+ */
+
+#include "Arduino.h"
+
+#include "CountingFunction.h"
+#include "CurrentTaskBlocker.h"
+#include "OneShotTimerH.h"
+#include "TimingWheel.h"
+#include "WheelTimer.h"
+
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/timers.h"
+
+#include <new>
+
+// Stop creating FreeRTOS timers when free heap falls below this, so
+// the sketch can keep printing.
+#define HEAP_RESERVE 16384
+
+// Start durations are chosen at random from 1 to this many ticks, long
+// enough that no timer fires while the benchmark runs.
+#define MAX_DURATION_TICKS 60000
+
+static const uint32_t TIMER_COUNTS[] = {1000, 10000, 100000};
+
+static CountingFunction counter;
+
+// The sketch advances the wheel itself, so it never runs in a task.
+static TimingWheel wheel(1);
+
+static uint32_t nanos_per_timer(int64_t elapsed_micros, uint32_t count) {
+  return count
+      ? static_cast<uint32_t>((elapsed_micros * 1000) / count)
+      : 0;
+}
+
+static TickType_t random_duration(void) {
+  return static_cast<TickType_t>(random(1, MAX_DURATION_TICKS + 1));
+}
+
+static void notify_blocker(void *blocker, uint32_t) {
+  static_cast<CurrentTaskBlocker *>(blocker)->notify();
+}
+
+/*
+ * Waits until the timer service has processed every command sent
+ * before the call. Commands are processed in order, so the wait ends
+ * when the daemon reaches the function call that the wait sends last.
+ */
+static void drain_timer_commands(void) {
+  CurrentTaskBlocker drained;
+  xTimerPendFunctionCall(notify_blocker, &drained, 0, portMAX_DELAY);
+  drained.wait();
+}
+
+static void benchmark_wheel(uint32_t count) {
+  WheelTimer *timers =
+      static_cast<WheelTimer *>(malloc(count * sizeof(WheelTimer)));
+  if (!timers) {
+    Serial.println("  TimingWheel:    skipped, out of memory.");
+    return;
+  }
+  for (uint32_t i = 0; i < count; ++i) {
+    new (&timers[i]) WheelTimer(counter);
+  }
+
+  int64_t start_micros = esp_timer_get_time();
+  for (uint32_t i = 0; i < count; ++i) {
+    wheel.start_ticks(timers[i], random_duration());
+  }
+  int64_t start_elapsed = esp_timer_get_time() - start_micros;
+
+  start_micros = esp_timer_get_time();
+  for (uint32_t i = 0; i < count; ++i) {
+    wheel.reset(timers[i]);
+  }
+  int64_t restart_elapsed = esp_timer_get_time() - start_micros;
+
+  start_micros = esp_timer_get_time();
+  for (uint32_t i = 0; i < count; ++i) {
+    wheel.stop(timers[i]);
+  }
+  int64_t stop_elapsed = esp_timer_get_time() - start_micros;
+
+  for (uint32_t i = 0; i < count; ++i) {
+    wheel.start_ticks(timers[i], 0);
+  }
+  counter.expect(count, NULL);
+  start_micros = esp_timer_get_time();
+  wheel.advance();
+  int64_t fire_elapsed = esp_timer_get_time() - start_micros;
+
+  Serial.printf(
+      "  TimingWheel:    start %lu ns, restart %lu ns, stop %lu ns, "
+      "fire %lu ns, %lu fired.\n",
+      static_cast<unsigned long>(nanos_per_timer(start_elapsed, count)),
+      static_cast<unsigned long>(nanos_per_timer(restart_elapsed, count)),
+      static_cast<unsigned long>(nanos_per_timer(stop_elapsed, count)),
+      static_cast<unsigned long>(nanos_per_timer(fire_elapsed, count)),
+      static_cast<unsigned long>(counter.invocations()));
+
+  for (uint32_t i = 0; i < count; ++i) {
+    timers[i].~WheelTimer();
+  }
+  free(timers);
+}
+
+static void benchmark_software_timers(uint32_t count) {
+  OneShotTimerH **timers =
+      static_cast<OneShotTimerH **>(malloc(count * sizeof(OneShotTimerH *)));
+  if (!timers) {
+    Serial.println("  FreeRTOS timer: skipped, out of memory.");
+    return;
+  }
+  uint32_t created = 0;
+  while (created < count && HEAP_RESERVE < ESP.getFreeHeap()) {
+    OneShotTimerH *timer =
+        new (std::nothrow) OneShotTimerH("Bench", counter, portMAX_DELAY);
+    if (!timer) {
+      break;
+    }
+    if (!timer->begin()) {
+      delete timer;
+      break;
+    }
+    timers[created++] = timer;
+  }
+
+  int64_t start_micros = esp_timer_get_time();
+  for (uint32_t i = 0; i < created; ++i) {
+    timers[i]->start_ticks(random_duration(), portMAX_DELAY);
+  }
+  drain_timer_commands();
+  int64_t start_elapsed = esp_timer_get_time() - start_micros;
+
+  // OneShotTimerH restarts when started again.
+  start_micros = esp_timer_get_time();
+  for (uint32_t i = 0; i < created; ++i) {
+    timers[i]->start_ticks(random_duration(), portMAX_DELAY);
+  }
+  drain_timer_commands();
+  int64_t restart_elapsed = esp_timer_get_time() - start_micros;
+
+  start_micros = esp_timer_get_time();
+  for (uint32_t i = 0; i < created; ++i) {
+    timers[i]->stop(portMAX_DELAY);
+  }
+  drain_timer_commands();
+  int64_t stop_elapsed = esp_timer_get_time() - start_micros;
+
+  // Give every timer the same deadline, far enough out that all
+  // start commands are processed first, then time from the first
+  // expiration to the last.
+  CurrentTaskBlocker fired;
+  TickType_t deadline =
+      xTaskGetTickCount() + pdMS_TO_TICKS(start_elapsed / 500) + 10;
+  counter.expect(created, &fired);
+  for (uint32_t i = 0; i < created; ++i) {
+    timers[i]->start_ticks(deadline - xTaskGetTickCount(), portMAX_DELAY);
+  }
+  if (created) {
+    fired.wait();
+  }
+  int64_t fire_elapsed = counter.elapsed_micros();
+
+  Serial.printf(
+      "  FreeRTOS timer: start %lu ns, restart %lu ns, stop %lu ns, "
+      "fire %lu ns, %lu fired, %lu of %lu created.\n",
+      static_cast<unsigned long>(nanos_per_timer(start_elapsed, created)),
+      static_cast<unsigned long>(nanos_per_timer(restart_elapsed, created)),
+      static_cast<unsigned long>(nanos_per_timer(stop_elapsed, created)),
+      static_cast<unsigned long>(nanos_per_timer(fire_elapsed, created)),
+      static_cast<unsigned long>(counter.invocations()),
+      static_cast<unsigned long>(created),
+      static_cast<unsigned long>(count));
+
+  for (uint32_t i = 0; i < created; ++i) {
+    delete timers[i];
+  }
+  drain_timer_commands();
+  free(timers);
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial.printf(
+      "TimingWheel benchmark built on %s at %s, CPU at %lu MHz, "
+      "%lu bytes free.\n",
+      __DATE__,
+      __TIME__,
+      static_cast<unsigned long>(getCpuFrequencyMhz()),
+      static_cast<unsigned long>(ESP.getFreeHeap()));
+
+  for (uint32_t count : TIMER_COUNTS) {
+    Serial.printf("%lu timers:\n", static_cast<unsigned long>(count));
+    benchmark_wheel(count);
+    benchmark_software_timers(count);
+  }
+
+  Serial.println("Benchmark completed.");
+}
+
+void loop() {
+  vTaskDelay(portMAX_DELAY);
+}
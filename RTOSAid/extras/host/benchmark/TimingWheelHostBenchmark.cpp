@@ -0,0 +1,147 @@
+/*
+ * TimingWheelHostBenchmark.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Measures the TimingWheel's own bookkeeping on the host, with the same
+ * steps as the TimingWheelBenchmark sketch: for 1,000, 10,000, and
+ * 100,000 timers, the cost of starting, restarting, and stopping every
+ * timer, firing every timer on one tick, and cascading every timer down
+ * from level 2. It prints the cost per timer in nanoseconds.
+ *
+ * The host build has no FreeRTOS software timers, so the comparison with
+ * BaseTimerH runs only on a board. Host critical sections exclude
+ * nothing, so these figures leave out the cost of the lock; use them to
+ * see how the wheel scales and to compare changes to it.
+ */
+
+#include "TimingWheel.h"
+#include "WheelTimer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <new>
+
+static const uint32_t TIMER_COUNTS[] = {1000, 10000, 100000};
+
+// Start durations are chosen at random from 1 to this many ticks.
+static const uint32_t MAX_DURATION_TICKS = 60000;
+
+// Timers started for this long all land in one level 2 slot.
+static const uint32_t CASCADE_TICKS = 5000;
+
+class CountingFunction : public VoidFunction {
+public:
+  uint32_t invocations;
+
+  CountingFunction(void) :
+      invocations(0) {
+  }
+
+  virtual void apply(void) {
+    ++invocations;
+  }
+};
+
+static uint64_t now_nanos(void) {
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+}
+
+static unsigned long nanos_per_timer(uint64_t elapsed_nanos, uint32_t count) {
+  return static_cast<unsigned long>(elapsed_nanos / count);
+}
+
+static void benchmark_wheel(uint32_t count) {
+  CountingFunction counter;
+  TimingWheel wheel(1);
+  WheelTimer *timers =
+      static_cast<WheelTimer *>(malloc(count * sizeof(WheelTimer)));
+  for (uint32_t i = 0; i < count; ++i) {
+    new (&timers[i]) WheelTimer(counter);
+  }
+
+  uint64_t started_at = now_nanos();
+  for (uint32_t i = 0; i < count; ++i) {
+    wheel.start_ticks(timers[i], 1 + rand() % MAX_DURATION_TICKS);
+  }
+  uint64_t start_elapsed = now_nanos() - started_at;
+
+  started_at = now_nanos();
+  for (uint32_t i = 0; i < count; ++i) {
+    wheel.reset(timers[i]);
+  }
+  uint64_t restart_elapsed = now_nanos() - started_at;
+
+  started_at = now_nanos();
+  for (uint32_t i = 0; i < count; ++i) {
+    wheel.stop(timers[i]);
+  }
+  uint64_t stop_elapsed = now_nanos() - started_at;
+
+  for (uint32_t i = 0; i < count; ++i) {
+    wheel.start_ticks(timers[i], 0);
+  }
+  started_at = now_nanos();
+  wheel.advance();
+  uint64_t fire_elapsed = now_nanos() - started_at;
+
+  // Advance to just before a level 2 slot comes due, so that only the
+  // cascades are timed.
+  for (uint32_t i = 0; i < count; ++i) {
+    wheel.start_ticks(timers[i], CASCADE_TICKS + rand() % 64);
+  }
+  while (wheel.now() & ((1 << (2 * TimingWheel::SLOT_BITS)) - 1)) {
+    wheel.advance();
+  }
+  started_at = now_nanos();
+  wheel.advance();
+  uint64_t cascade_elapsed = now_nanos() - started_at;
+  while (wheel.pending()) {
+    wheel.advance();
+  }
+
+  printf(
+      "  start %lu ns, restart %lu ns, stop %lu ns, fire %lu ns, "
+      "cascade %lu ns, %lu fired.\n",
+      nanos_per_timer(start_elapsed, count),
+      nanos_per_timer(restart_elapsed, count),
+      nanos_per_timer(stop_elapsed, count),
+      nanos_per_timer(fire_elapsed, count),
+      nanos_per_timer(cascade_elapsed, count),
+      static_cast<unsigned long>(counter.invocations));
+
+  for (uint32_t i = 0; i < count; ++i) {
+    timers[i].~WheelTimer();
+  }
+  free(timers);
+}
+
+int main(void) {
+  srand(1);
+  for (uint32_t count : TIMER_COUNTS) {
+    printf("%lu timers:\n", static_cast<unsigned long>(count));
+    benchmark_wheel(count);
+  }
+  return 0;
+}
@@ -0,0 +1,79 @@
+/*
+ * Arduino.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Host build stand-in for the ESP32 Arduino core. It provides Print, a
+ * Serial that writes to standard output, and the time functions, and,
+ * like the real header, pulls in the FreeRTOS and GPIO declarations.
+ */
+
+#ifndef HOST_ARDUINO_H_
+#define HOST_ARDUINO_H_
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "driver/gpio.h"
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#define IRAM_ATTR
+
+class Print {
+public:
+  virtual ~Print();
+
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size);
+
+  size_t print(const char *text);
+  size_t print(long value);
+  size_t print(unsigned long value);
+  size_t printf(const char *format, ...)
+      __attribute__ ((format (printf, 2, 3)));
+  size_t println(const char *text = "");
+  size_t println(long value);
+  size_t println(unsigned long value);
+};
+
+/**
+ * Writes to standard output. begin() does nothing.
+ */
+class HostSerial : public Print {
+public:
+  void begin(unsigned long baud);
+  virtual size_t write(uint8_t c);
+  virtual size_t write(const uint8_t *buffer, size_t size);
+};
+
+extern HostSerial Serial;
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(uint32_t ms);
+
+#endif /* HOST_ARDUINO_H_ */
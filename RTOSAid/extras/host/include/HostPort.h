@@ -0,0 +1,95 @@
+/*
+ * HostPort.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Controls for the simulated kernel behind the host build. The host port
+ * runs everything on the test's own thread:
+ *
+ * 1. Time stands still until the test advances it. Advancing it fires
+ *    every esp_timer that falls due, in deadline order. The FreeRTOS
+ *    tick count is derived from the same clock.
+ * 2. Tasks are created but never run. The current task is whichever
+ *    the test last selected, initially a task named "main".
+ * 3. Waits never block. A wait that finds nothing pending times out,
+ *    advancing the clock by its timeout unless the timeout is
+ *    portMAX_DELAY, in which case it fails at once.
+ * 4. Critical sections exclude nothing, as there is one simulated core,
+ *    but their depth is tracked.
+ *
+ * This is enough to run the library's pure logic, such as histograms,
+ * timer wheels and the lock order checker, under test.
+ */
+
+#ifndef HOST_HOSTPORT_H_
+#define HOST_HOSTPORT_H_
+
+#include "Arduino.h"
+
+#include "driver/gpio.h"
+#include "esp_timer.h"
+
+/**
+ * Advances the simulated clock, firing every esp_timer that falls due.
+ */
+void host_advance_micros(uint64_t micros);
+
+/**
+ * Returns: the depth of critical section nesting, 0 outside of any.
+ */
+uint32_t host_critical_depth(void);
+
+/**
+ * Returns: the argument of the interrupt handler on a pin, or NULL if it
+ *          has none.
+ */
+void *host_gpio_handler_arg(gpio_num_t gpio_num);
+
+/**
+ * Invokes the interrupt handler on a pin, if it has one, in simulated
+ * interrupt context.
+ *
+ * Returns: true if the pin had a handler.
+ */
+bool host_gpio_interrupt(gpio_num_t gpio_num);
+
+/**
+ * Returns: the number of times gpio_isr_handler_remove() has been
+ *          invoked on a pin that had no handler.
+ */
+uint32_t host_gpio_stray_removals(void);
+
+/**
+ * Returns: the task that runs the test.
+ */
+TaskHandle_t host_main_task(void);
+
+/**
+ * Makes the specified task current, which xTaskGetCurrentTaskHandle()
+ * then returns and which notification waits apply to.
+ */
+void host_set_current_task(TaskHandle_t task);
+
+/**
+ * Returns: the pending notification value of a task.
+ */
+uint32_t host_task_notification_value(TaskHandle_t task);
+
+#endif /* HOST_HOSTPORT_H_ */
@@ -0,0 +1,85 @@
+/*
+ * FreeRTOS.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Host build stand-in for the ESP-IDF FreeRTOS configuration and port
+ * definitions. It declares just enough of the kernel for the library's
+ * pure logic to compile on Linux. The simulated kernel lives in
+ * HostPort.cpp; see HostPort.h.
+ */
+
+#ifndef HOST_FREERTOS_FREERTOS_H_
+#define HOST_FREERTOS_FREERTOS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint8_t StackType_t;
+
+#define pdFALSE ((BaseType_t) 0)
+#define pdTRUE ((BaseType_t) 1)
+#define pdFAIL pdFALSE
+#define pdPASS pdTRUE
+
+#define configTICK_RATE_HZ 1000
+#define configMAX_PRIORITIES 25
+#define configGENERATE_RUN_TIME_STATS 0
+#define portMAX_DELAY ((TickType_t) 0xffffffffUL)
+#define portTICK_PERIOD_MS ((TickType_t) 1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms) \
+    ((TickType_t) (((uint64_t) (ms) * configTICK_RATE_HZ) / 1000U))
+
+#define tskNO_AFFINITY ((BaseType_t) 0x7fffffff)
+
+struct HostTaskControlBlock;
+typedef HostTaskControlBlock *TaskHandle_t;
+
+struct StaticTask_t {
+  void *reserved[8];
+};
+
+// Critical sections nest, and the host port counts the depth so that
+// tests can check what runs inside them. There is one simulated core,
+// so a critical section excludes nothing.
+struct portMUX_TYPE {
+  uint32_t owner;
+  uint32_t count;
+};
+
+#define portMUX_INITIALIZER_UNLOCKED { 0, 0 }
+
+void host_enter_critical(portMUX_TYPE *mux);
+void host_exit_critical(portMUX_TYPE *mux);
+BaseType_t xPortInIsrContext(void);
+
+#define portENTER_CRITICAL(mux) host_enter_critical(mux)
+#define portEXIT_CRITICAL(mux) host_exit_critical(mux)
+#define portENTER_CRITICAL_ISR(mux) host_enter_critical(mux)
+#define portEXIT_CRITICAL_ISR(mux) host_exit_critical(mux)
+#define portENTER_CRITICAL_SAFE(mux) host_enter_critical(mux)
+#define portEXIT_CRITICAL_SAFE(mux) host_exit_critical(mux)
+#define portYIELD_FROM_ISR() do { } while (0)
+#define taskYIELD() do { } while (0)
+
+#endif /* HOST_FREERTOS_FREERTOS_H_ */
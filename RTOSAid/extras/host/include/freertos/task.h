@@ -0,0 +1,102 @@
+/*
+ * task.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Host build stand-in for the FreeRTOS task API. Tasks are created but
+ * never run; tests drive actions directly and switch the simulated
+ * current task with host_set_current_task(). Waits never block: they
+ * return at once with whatever is pending.
+ */
+
+#ifndef HOST_FREERTOS_TASK_H_
+#define HOST_FREERTOS_TASK_H_
+
+#include "freertos/FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void *);
+
+typedef enum {
+  eNoAction = 0,
+  eSetBits,
+  eIncrement,
+  eSetValueWithOverwrite,
+  eSetValueWithoutOverwrite
+} eNotifyAction;
+
+typedef enum {
+  eRunning = 0,
+  eReady,
+  eBlocked,
+  eSuspended,
+  eDeleted,
+  eInvalid
+} eTaskState;
+
+BaseType_t xTaskCreatePinnedToCore(
+    TaskFunction_t function,
+    const char *name,
+    uint32_t stack_depth,
+    void *parameters,
+    UBaseType_t priority,
+    TaskHandle_t *created_task,
+    BaseType_t core_id);
+
+TaskHandle_t xTaskCreateStaticPinnedToCore(
+    TaskFunction_t function,
+    const char *name,
+    uint32_t stack_depth,
+    void *parameters,
+    UBaseType_t priority,
+    StackType_t *stack_buffer,
+    StaticTask_t *task_buffer,
+    BaseType_t core_id);
+
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+BaseType_t xTaskDelayUntil(TickType_t *previous_wake, TickType_t increment);
+void vTaskDelayUntil(TickType_t *previous_wake, TickType_t increment);
+void vTaskSuspend(TaskHandle_t task);
+void vTaskResume(TaskHandle_t task);
+eTaskState eTaskGetState(TaskHandle_t task);
+
+TickType_t xTaskGetTickCount(void);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+TaskHandle_t xTaskGetHandle(const char *name);
+char *pcTaskGetName(TaskHandle_t task);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+uint32_t ulTaskGetRunTimeCounter(TaskHandle_t task);
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action);
+BaseType_t xTaskNotifyFromISR(
+    TaskHandle_t task,
+    uint32_t value,
+    eNotifyAction action,
+    BaseType_t *higher_priority_task_woken);
+BaseType_t xTaskNotifyWait(
+    uint32_t bits_to_clear_on_entry,
+    uint32_t bits_to_clear_on_exit,
+    uint32_t *notification_value,
+    TickType_t ticks_to_wait);
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait);
+void vTaskNotifyGiveFromISR(
+    TaskHandle_t task, BaseType_t *higher_priority_task_woken);
+
+#endif /* HOST_FREERTOS_TASK_H_ */
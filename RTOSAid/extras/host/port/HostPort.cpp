@@ -0,0 +1,558 @@
+/*
+ * HostPort.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "HostPort.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+struct HostTaskControlBlock {
+  char name[16];
+  UBaseType_t priority;
+  uint32_t notification_value;
+  bool notification_pending;
+  eTaskState state;
+};
+
+struct HostEspTimer {
+  esp_timer_cb_t callback;
+  void *arg;
+  bool armed;
+  int64_t deadline;
+  uint64_t period;  // 0 for a one shot
+};
+
+struct HostGpioHandler {
+  gpio_isr_t handler;
+  void *arg;
+};
+
+HostSerial Serial;
+
+static HostTaskControlBlock main_task = {
+    "main", 1, 0, false, eRunning };
+static TaskHandle_t current_task = &main_task;
+static int64_t now_micros = 0;
+static uint32_t critical_depth = 0;
+static bool in_isr = false;
+static std::vector<HostEspTimer *> esp_timers;
+static std::map<gpio_num_t, HostGpioHandler> gpio_handlers;
+static uint32_t gpio_stray_removals = 0;
+static std::vector<TaskHandle_t> created_tasks;
+
+static TaskHandle_t create_task(const char *name, UBaseType_t priority) {
+  HostTaskControlBlock *task = new HostTaskControlBlock;
+  memset(task, 0, sizeof(*task));
+  strncpy(task->name, name, sizeof(task->name) - 1);
+  task->priority = priority;
+  task->state = eReady;
+  created_tasks.push_back(task);
+  return task;
+}
+
+// Wakes the current task if a notification is pending. Otherwise the
+// wait times out, which takes its full timeout.
+static bool wait_for_notification(TickType_t ticks_to_wait) {
+  if (current_task->notification_pending) {
+    current_task->notification_pending = false;
+    return true;
+  }
+  if (ticks_to_wait != portMAX_DELAY) {
+    host_advance_micros(
+        static_cast<uint64_t>(ticks_to_wait) * portTICK_PERIOD_MS * 1000);
+  }
+  return false;
+}
+
+// ---------------------------------------------------------------- Controls
+
+void host_advance_micros(uint64_t micros) {
+  int64_t target = now_micros + static_cast<int64_t>(micros);
+  for (;;) {
+    HostEspTimer *next = NULL;
+    for (HostEspTimer *timer : esp_timers) {
+      if (timer->armed && timer->deadline <= target
+          && (!next || timer->deadline < next->deadline)) {
+        next = timer;
+      }
+    }
+    if (!next) {
+      break;
+    }
+    now_micros = std::max(now_micros, next->deadline);
+    if (next->period) {
+      next->deadline += next->period;
+    } else {
+      next->armed = false;
+    }
+    next->callback(next->arg);
+  }
+  now_micros = std::max(now_micros, target);
+}
+
+uint32_t host_critical_depth(void) {
+  return critical_depth;
+}
+
+void *host_gpio_handler_arg(gpio_num_t gpio_num) {
+  auto found = gpio_handlers.find(gpio_num);
+  return found == gpio_handlers.end() ? NULL : found->second.arg;
+}
+
+bool host_gpio_interrupt(gpio_num_t gpio_num) {
+  auto found = gpio_handlers.find(gpio_num);
+  if (found == gpio_handlers.end()) {
+    return false;
+  }
+  in_isr = true;
+  found->second.handler(found->second.arg);
+  in_isr = false;
+  return true;
+}
+
+uint32_t host_gpio_stray_removals(void) {
+  return gpio_stray_removals;
+}
+
+TaskHandle_t host_main_task(void) {
+  return &main_task;
+}
+
+void host_set_current_task(TaskHandle_t task) {
+  current_task = task;
+}
+
+uint32_t host_task_notification_value(TaskHandle_t task) {
+  return task->notification_value;
+}
+
+// ------------------------------------------------------------------- Port
+
+void host_enter_critical(portMUX_TYPE *mux) {
+  ++mux->count;
+  ++critical_depth;
+}
+
+void host_exit_critical(portMUX_TYPE *mux) {
+  --mux->count;
+  --critical_depth;
+}
+
+BaseType_t xPortInIsrContext(void) {
+  return in_isr;
+}
+
+// ------------------------------------------------------------------ Tasks
+
+BaseType_t xTaskCreatePinnedToCore(
+    TaskFunction_t function,
+    const char *name,
+    uint32_t stack_depth,
+    void *parameters,
+    UBaseType_t priority,
+    TaskHandle_t *created_task,
+    BaseType_t core_id) {
+  *created_task = create_task(name, priority);
+  return pdPASS;
+}
+
+TaskHandle_t xTaskCreateStaticPinnedToCore(
+    TaskFunction_t function,
+    const char *name,
+    uint32_t stack_depth,
+    void *parameters,
+    UBaseType_t priority,
+    StackType_t *stack_buffer,
+    StaticTask_t *task_buffer,
+    BaseType_t core_id) {
+  return create_task(name, priority);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+  if (!task) {
+    task = current_task;
+  }
+  if (task == current_task) {
+    current_task = &main_task;
+  }
+  if (task != &main_task) {
+    created_tasks.erase(
+        std::find(created_tasks.begin(), created_tasks.end(), task));
+    delete task;
+  }
+}
+
+void vTaskDelay(TickType_t ticks) {
+  host_advance_micros(static_cast<uint64_t>(ticks) * portTICK_PERIOD_MS * 1000);
+}
+
+BaseType_t xTaskDelayUntil(TickType_t *previous_wake, TickType_t increment) {
+  TickType_t wake = *previous_wake + increment;
+  TickType_t now = xTaskGetTickCount();
+  bool delayed = static_cast<int32_t>(wake - now) > 0;
+  if (delayed) {
+    vTaskDelay(wake - now);
+  }
+  *previous_wake = wake;
+  return delayed;
+}
+
+void vTaskDelayUntil(TickType_t *previous_wake, TickType_t increment) {
+  xTaskDelayUntil(previous_wake, increment);
+}
+
+void vTaskSuspend(TaskHandle_t task) {
+  (task ? task : current_task)->state = eSuspended;
+}
+
+void vTaskResume(TaskHandle_t task) {
+  task->state = eReady;
+}
+
+eTaskState eTaskGetState(TaskHandle_t task) {
+  return task == current_task ? eRunning : task->state;
+}
+
+TickType_t xTaskGetTickCount(void) {
+  return static_cast<TickType_t>(now_micros / (portTICK_PERIOD_MS * 1000));
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+  return current_task;
+}
+
+// Tasks never run, so a cancelled task never deletes itself. Prefer the
+// newest task with the name, which is the one that is running.
+TaskHandle_t xTaskGetHandle(const char *name) {
+  for (auto task = created_tasks.rbegin(); task != created_tasks.rend();
+      ++task) {
+    if (!strcmp((*task)->name, name)) {
+      return *task;
+    }
+  }
+  return strcmp(main_task.name, name) ? NULL : &main_task;
+}
+
+char *pcTaskGetName(TaskHandle_t task) {
+  return (task ? task : current_task)->name;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+  return 0;
+}
+
+uint32_t ulTaskGetRunTimeCounter(TaskHandle_t task) {
+  return 0;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action) {
+  BaseType_t result = pdPASS;
+  switch (action) {
+    case eNoAction:
+      break;
+    case eSetBits:
+      task->notification_value |= value;
+      break;
+    case eIncrement:
+      ++task->notification_value;
+      break;
+    case eSetValueWithOverwrite:
+      task->notification_value = value;
+      break;
+    case eSetValueWithoutOverwrite:
+      if (task->notification_pending) {
+        result = pdFAIL;
+      } else {
+        task->notification_value = value;
+      }
+      break;
+  }
+  task->notification_pending = true;
+  return result;
+}
+
+BaseType_t xTaskNotifyFromISR(
+    TaskHandle_t task,
+    uint32_t value,
+    eNotifyAction action,
+    BaseType_t *higher_priority_task_woken) {
+  if (higher_priority_task_woken) {
+    *higher_priority_task_woken = pdFALSE;
+  }
+  return xTaskNotify(task, value, action);
+}
+
+BaseType_t xTaskNotifyWait(
+    uint32_t bits_to_clear_on_entry,
+    uint32_t bits_to_clear_on_exit,
+    uint32_t *notification_value,
+    TickType_t ticks_to_wait) {
+  if (!current_task->notification_pending) {
+    current_task->notification_value &= ~bits_to_clear_on_entry;
+  }
+  bool notified = wait_for_notification(ticks_to_wait);
+  if (notification_value) {
+    *notification_value = current_task->notification_value;
+  }
+  if (notified) {
+    current_task->notification_value &= ~bits_to_clear_on_exit;
+  }
+  return notified ? pdTRUE : pdFALSE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear_on_exit, TickType_t ticks_to_wait) {
+  if (!current_task->notification_value) {
+    current_task->notification_pending = false;
+    wait_for_notification(ticks_to_wait);
+  }
+  current_task->notification_pending = false;
+  uint32_t value = current_task->notification_value;
+  if (value) {
+    current_task->notification_value = clear_on_exit ? 0 : value - 1;
+  }
+  return value;
+}
+
+void vTaskNotifyGiveFromISR(
+    TaskHandle_t task, BaseType_t *higher_priority_task_woken) {
+  xTaskNotifyFromISR(task, 0, eIncrement, higher_priority_task_woken);
+}
+
+// ------------------------------------------------------------- Semaphores
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *buffer) {
+  buffer->count = 0;
+  return buffer;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t *buffer) {
+  buffer->count = 1;
+  return buffer;
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutexStatic(
+    StaticSemaphore_t *buffer) {
+  buffer->count = 0;  // Nesting depth
+  return buffer;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+  if (semaphore->count) {
+    return pdFALSE;
+  }
+  semaphore->count = 1;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+  if (!semaphore->count) {
+    return pdFALSE;
+  }
+  semaphore->count = 0;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t mutex) {
+  if (!mutex->count) {
+    return pdFALSE;
+  }
+  --mutex->count;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t mutex, TickType_t ticks) {
+  ++mutex->count;
+  return pdTRUE;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+}
+
+// ------------------------------------------------------------- esp_timer
+
+esp_err_t esp_timer_create(
+    const esp_timer_create_args_t *create_args,
+    esp_timer_handle_t *out_handle) {
+  HostEspTimer *timer = new HostEspTimer;
+  timer->callback = create_args->callback;
+  timer->arg = create_args->arg;
+  timer->armed = false;
+  timer->deadline = 0;
+  timer->period = 0;
+  esp_timers.push_back(timer);
+  *out_handle = timer;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+  if (!timer) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (timer->armed) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  esp_timers.erase(
+      std::find(esp_timers.begin(), esp_timers.end(), timer));
+  delete timer;
+  return ESP_OK;
+}
+
+int64_t esp_timer_get_time(void) {
+  return now_micros;
+}
+
+static esp_err_t start_timer(
+    esp_timer_handle_t timer, uint64_t timeout_us, uint64_t period) {
+  if (!timer) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (timer->armed) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  timer->armed = true;
+  timer->deadline = now_micros + static_cast<int64_t>(timeout_us);
+  timer->period = period;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us) {
+  return start_timer(timer, timeout_us, 0);
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period) {
+  return start_timer(timer, period, period);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+  if (!timer) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (!timer->armed) {
+    return ESP_ERR_INVALID_STATE;
+  }
+  timer->armed = false;
+  return ESP_OK;
+}
+
+// ------------------------------------------------------------------- GPIO
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags) {
+  return ESP_OK;
+}
+
+void gpio_uninstall_isr_service(void) {
+  gpio_handlers.clear();
+}
+
+esp_err_t gpio_isr_handler_add(
+    gpio_num_t gpio_num, gpio_isr_t isr_handler, void *args) {
+  gpio_handlers[gpio_num] = HostGpioHandler { isr_handler, args };
+  return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num) {
+  if (!gpio_handlers.erase(gpio_num)) {
+    ++gpio_stray_removals;
+  }
+  return ESP_OK;
+}
+
+esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type) {
+  return ESP_OK;
+}
+
+// ---------------------------------------------------------------- Arduino
+
+Print::~Print() {
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t written = 0;
+  while (size--) {
+    written += write(*buffer++);
+  }
+  return written;
+}
+
+size_t Print::print(const char *text) {
+  return write(reinterpret_cast<const uint8_t *>(text), strlen(text));
+}
+
+size_t Print::print(long value) {
+  return printf("%ld", value);
+}
+
+size_t Print::print(unsigned long value) {
+  return printf("%lu", value);
+}
+
+size_t Print::printf(const char *format, ...) {
+  char buffer[256];
+  va_list arguments;
+  va_start(arguments, format);
+  int length = vsnprintf(buffer, sizeof(buffer), format, arguments);
+  va_end(arguments);
+  if (length < 0) {
+    return 0;
+  }
+  if (sizeof(buffer) <= static_cast<size_t>(length)) {
+    length = sizeof(buffer) - 1;
+  }
+  return write(reinterpret_cast<const uint8_t *>(buffer), length);
+}
+
+size_t Print::println(const char *text) {
+  return print(text) + print("\n");
+}
+
+size_t Print::println(long value) {
+  return print(value) + print("\n");
+}
+
+size_t Print::println(unsigned long value) {
+  return print(value) + print("\n");
+}
+
+void HostSerial::begin(unsigned long baud) {
+}
+
+size_t HostSerial::write(uint8_t c) {
+  return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HostSerial::write(const uint8_t *buffer, size_t size) {
+  return fwrite(buffer, 1, size, stdout);
+}
+
+unsigned long millis(void) {
+  return static_cast<unsigned long>(now_micros / 1000);
+}
+
+unsigned long micros(void) {
+  return static_cast<unsigned long>(now_micros);
+}
+
+void delay(uint32_t ms) {
+  vTaskDelay(pdMS_TO_TICKS(ms));
+}
@@ -0,0 +1,234 @@
+/*
+ * GpioDebounceServiceTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Tests when the debounce service settles pins, against random bursts of
+ * edges, and that it detaches only the pins it attached. The test plays
+ * the service task, running settle() whenever the task is notified.
+ */
+
+#include "GpioDebounceService.h"
+
+#include "HostPort.h"
+#include "HostTest.h"
+
+#include <stdlib.h>
+
+static const char *SERVICE_NAME = "Debounce";
+static const size_t PIN_COUNT = 3;
+static const uint8_t PIN_NUMBERS[PIN_COUNT] = { 4, 5, 18 };
+static const uint32_t WINDOWS[PIN_COUNT] = { 1000, 5000, 20000 };
+static const uint32_t STEP_MICROS = 100;
+
+// Plays edges on demand and counts detaches of pins that are not
+// attached.
+class ScriptedEdges : public GpioEdgeSource {
+  VoidFunction *on_edge[256];
+
+public:
+  int failing_pin;
+  uint32_t detaches;
+  uint32_t stray_detaches;
+
+  ScriptedEdges(void) :
+      failing_pin(-1),
+      detaches(0),
+      stray_detaches(0) {
+    memset(on_edge, 0, sizeof(on_edge));
+  }
+
+  virtual bool attach(uint8_t pin_no, VoidFunction *on_edge) {
+    if (pin_no == failing_pin) {
+      return false;
+    }
+    this->on_edge[pin_no] = on_edge;
+    return true;
+  }
+
+  virtual void detach(uint8_t pin_no) {
+    ++detaches;
+    if (!on_edge[pin_no]) {
+      ++stray_detaches;
+    }
+    on_edge[pin_no] = NULL;
+  }
+
+  bool attached(uint8_t pin_no) const {
+    return on_edge[pin_no];
+  }
+
+  void edge(uint8_t pin_no) {
+    on_edge[pin_no]->apply();
+  }
+};
+
+// Records when a pin settled.
+class RecordSettle : public VoidFunction {
+public:
+  uint32_t count;
+  int64_t settled_at;
+
+  RecordSettle(void) :
+      count(0),
+      settled_at(0) {
+  }
+
+  virtual void apply(void) {
+    ++count;
+    settled_at = esp_timer_get_time();
+  }
+};
+
+class TestService : public GpioDebounceService {
+public:
+  TestService(GpioEdgeSource& edges) :
+      GpioDebounceService(SERVICE_NAME, 5, 4096, edges) {
+  }
+
+  // Does what the service task would do with its pending notifications.
+  void serve(void) {
+    host_set_current_task(xTaskGetHandle(SERVICE_NAME));
+    while (ulTaskNotifyTake(pdTRUE, 0)) {
+      settle();
+    }
+    host_set_current_task(host_main_task());
+  }
+};
+
+static void add_pins(TestService& service, RecordSettle *recorders) {
+  for (size_t i = 0; i < PIN_COUNT; ++i) {
+    CHECK_EQUAL(
+        i, service.add_pin(PIN_NUMBERS[i], WINDOWS[i], &recorders[i]));
+  }
+}
+
+// Pins bounce in random bursts. Each must settle once per burst, when
+// the timer wakes the service after its window has passed.
+static void test_random_bounces(unsigned seed) {
+  srand(seed);
+  ScriptedEdges edges;
+  RecordSettle recorders[PIN_COUNT];
+  TestService service(edges);
+  add_pins(service, recorders);
+  CHECK(service.start());
+
+  int64_t last_edge[PIN_COUNT] = {};
+  bool bouncing[PIN_COUNT] = {};
+  uint32_t burst_steps[PIN_COUNT] = {};
+  uint32_t expected_settles[PIN_COUNT] = {};
+  uint32_t expected_edges[PIN_COUNT] = {};
+
+  for (int step = 0; step < 20000; ++step) {
+    host_advance_micros(STEP_MICROS);
+    service.serve();
+    int64_t now = esp_timer_get_time();
+    for (size_t i = 0; i < PIN_COUNT; ++i) {
+      if (bouncing[i] && WINDOWS[i] <= now - last_edge[i]) {
+        bouncing[i] = false;
+        ++expected_settles[i];
+        CHECK(WINDOWS[i] <= recorders[i].settled_at - last_edge[i]);
+        CHECK(recorders[i].settled_at - last_edge[i]
+            < WINDOWS[i] + STEP_MICROS);
+      }
+      CHECK_EQUAL(expected_settles[i], recorders[i].count);
+    }
+
+    for (size_t i = 0; i < PIN_COUNT; ++i) {
+      if (!burst_steps[i] && rand() % 400 == 0) {
+        burst_steps[i] = 1 + rand() % 200;
+      }
+      if (burst_steps[i]) {
+        --burst_steps[i];
+        if (rand() % 8 == 0) {
+          edges.edge(PIN_NUMBERS[i]);
+          last_edge[i] = now;
+          bouncing[i] = true;
+          ++expected_edges[i];
+        }
+      }
+    }
+    service.serve();
+  }
+
+  for (size_t i = 0; i < PIN_COUNT; ++i) {
+    CHECK_EQUAL(expected_edges[i], service.edge_count(i));
+    CHECK_EQUAL(expected_settles[i], service.settle_count(i));
+    CHECK(expected_settles[i]);
+  }
+  service.stop();
+  CHECK_EQUAL(PIN_COUNT, edges.detaches);
+  CHECK_EQUAL(0, edges.stray_detaches);
+}
+
+static void test_never_started(void) {
+  ScriptedEdges edges;
+  RecordSettle recorders[PIN_COUNT];
+  {
+    TestService service(edges);
+    add_pins(service, recorders);
+    service.stop();
+  }
+  CHECK_EQUAL(0, edges.detaches);
+}
+
+static void test_attach_failure(void) {
+  ScriptedEdges edges;
+  RecordSettle recorders[PIN_COUNT];
+  edges.failing_pin = PIN_NUMBERS[2];
+  {
+    TestService service(edges);
+    add_pins(service, recorders);
+    CHECK(!service.start());
+    CHECK(!edges.attached(PIN_NUMBERS[0]));
+    CHECK(!edges.attached(PIN_NUMBERS[1]));
+    CHECK_EQUAL(2, edges.detaches);
+  }
+  CHECK_EQUAL(2, edges.detaches);
+  CHECK_EQUAL(0, edges.stray_detaches);
+}
+
+static void test_restart(void) {
+  ScriptedEdges edges;
+  RecordSettle recorders[PIN_COUNT];
+  TestService service(edges);
+  add_pins(service, recorders);
+  CHECK(service.start());
+  service.stop();
+  service.stop();
+  CHECK_EQUAL(PIN_COUNT, edges.detaches);
+  CHECK(service.start());
+  for (size_t i = 0; i < PIN_COUNT; ++i) {
+    CHECK(edges.attached(PIN_NUMBERS[i]));
+  }
+  service.stop();
+  CHECK_EQUAL(2 * PIN_COUNT, edges.detaches);
+  CHECK_EQUAL(0, edges.stray_detaches);
+}
+
+int main(void) {
+  test_never_started();
+  test_attach_failure();
+  test_restart();
+  for (unsigned seed = 1; seed <= 10; ++seed) {
+    test_random_bounces(seed);
+  }
+  return test_result();
+}
@@ -0,0 +1,79 @@
+/*
+ * HostTest.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A minimal test harness for the host build. Each test program checks
+ * its expectations with CHECK() and CHECK_EQUAL(), which report
+ * failures and carry on, and returns test_result() from main(), which
+ * ctest reads as pass or fail.
+ */
+
+#ifndef HOST_TEST_HOSTTEST_H_
+#define HOST_TEST_HOSTTEST_H_
+
+#include <stdio.h>
+
+inline unsigned& test_failure_count(void) {
+  static unsigned failures = 0;
+  return failures;
+}
+
+inline bool test_check(
+    bool passed, const char *expression, const char *file, int line) {
+  if (!passed) {
+    ++test_failure_count();
+    fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expression);
+  }
+  return passed;
+}
+
+inline bool test_check_equal(
+    unsigned long long expected,
+    unsigned long long actual,
+    const char *expression,
+    const char *file,
+    int line) {
+  if (expected != actual) {
+    ++test_failure_count();
+    fprintf(stderr, "%s:%d: %s is %llu, expected %llu\n",
+        file, line, expression, actual, expected);
+  }
+  return expected == actual;
+}
+
+/**
+ * Returns: the process exit status, 0 if every check passed.
+ */
+inline int test_result(void) {
+  if (test_failure_count()) {
+    fprintf(stderr, "%u checks failed.\n", test_failure_count());
+    return 1;
+  }
+  return 0;
+}
+
+#define CHECK(condition) \
+    test_check((condition), #condition, __FILE__, __LINE__)
+
+#define CHECK_EQUAL(expected, actual) \
+    test_check_equal((expected), (actual), #actual, __FILE__, __LINE__)
+
+#endif /* HOST_TEST_HOSTTEST_H_ */
@@ -0,0 +1,160 @@
+/*
+ * InstrumentationRegistryTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "InstrumentationRegistryT.h"
+
+#include "HostTest.h"
+
+#include <string.h>
+
+struct FakeStatistics {
+  int id;
+  uint32_t count;
+};
+
+// A minimal instrumentation class that meets InstrumentationRegistryT's
+// requirements and records how the registry used it.
+class FakeInstrumentation final {
+  template <class I, class S> friend class InstrumentationRegistryT;
+
+  FakeInstrumentation *next;
+  bool registered;
+
+  void copy_statistics(FakeStatistics *snapshot) {
+    snapshot->id = id;
+    snapshot->count = count;
+  }
+
+  static void print_statistics(Print& out, const FakeStatistics& snapshot) {
+    out.printf("%d:%lu ",
+        snapshot.id, static_cast<unsigned long>(snapshot.count));
+  }
+
+public:
+  int id;
+  uint32_t count;
+
+  FakeInstrumentation(int id) :
+      next(NULL),
+      registered(false),
+      id(id),
+      count(0) {
+  }
+
+  void reset(void) {
+    count = 0;
+  }
+};
+
+typedef InstrumentationRegistryT<FakeInstrumentation, FakeStatistics>
+    FakeRegistry;
+
+// Captures printed output.
+class StringPrint : public Print {
+public:
+  char text[128];
+  size_t length;
+
+  StringPrint(void) : length(0) {
+    text[0] = '\0';
+  }
+
+  virtual size_t write(uint8_t c) {
+    if (length + 1 < sizeof(text)) {
+      text[length++] = static_cast<char>(c);
+      text[length] = '\0';
+    }
+    return 1;
+  }
+};
+
+static void test_add_and_remove(void) {
+  FakeRegistry registry;
+  FakeInstrumentation first(1);
+  FakeInstrumentation second(2);
+  FakeInstrumentation third(3);
+  CHECK_EQUAL(0, registry.count());
+
+  registry.add(&first);
+  registry.add(&second);
+  registry.add(&third);
+  registry.add(&second);  // Adding twice must not corrupt the list
+  CHECK_EQUAL(3, registry.count());
+
+  // Newest first
+  FakeStatistics statistics;
+  CHECK(registry.snapshot(0, &statistics));
+  CHECK_EQUAL(3, statistics.id);
+  CHECK(registry.snapshot(2, &statistics));
+  CHECK_EQUAL(1, statistics.id);
+  CHECK(!registry.snapshot(3, &statistics));
+
+  registry.remove(&second);
+  registry.remove(&second);  // Removing twice is harmless
+  CHECK_EQUAL(2, registry.count());
+  CHECK(registry.snapshot(1, &statistics));
+  CHECK_EQUAL(1, statistics.id);
+
+  registry.remove(&first);
+  registry.remove(&third);
+  CHECK_EQUAL(0, registry.count());
+  CHECK(!registry.snapshot(0, &statistics));
+
+  // A removed instance can be registered again.
+  registry.add(&second);
+  CHECK_EQUAL(1, registry.count());
+}
+
+static void test_reset_all_and_print(void) {
+  FakeRegistry registry;
+  FakeInstrumentation first(1);
+  FakeInstrumentation second(2);
+  first.count = 10;
+  second.count = 20;
+  registry.add(&first);
+  registry.add(&second);
+
+  StringPrint out;
+  registry.print(out);
+  CHECK(!strcmp("2:20 1:10 ", out.text));
+
+  registry.reset_all();
+  CHECK_EQUAL(0, first.count);
+  CHECK_EQUAL(0, second.count);
+}
+
+static void test_lock_is_recursive(void) {
+  FakeRegistry registry;
+  FakeInstrumentation instrumentation(1);
+  registry.lock();
+  registry.add(&instrumentation);
+  CHECK_EQUAL(1, registry.count());
+  registry.unlock();
+}
+
+int main(void) {
+  test_add_and_remove();
+  test_reset_all_and_print();
+  test_lock_is_recursive();
+  return test_result();
+}
@@ -0,0 +1,132 @@
+/*
+ * LatencyHistogramTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LatencyHistogram.h"
+
+#include "HostTest.h"
+
+static void test_empty(void) {
+  LatencyHistogram histogram;
+  CHECK_EQUAL(0, histogram.count());
+  CHECK_EQUAL(0, histogram.minimum());
+  CHECK_EQUAL(0, histogram.maximum());
+  CHECK_EQUAL(0, histogram.mean());
+  CHECK_EQUAL(0, histogram.percentile(50.0f));
+}
+
+static void test_buckets(void) {
+  CHECK_EQUAL(0, LatencyHistogram::bucket_index(0));
+  CHECK_EQUAL(1, LatencyHistogram::bucket_index(1));
+  CHECK_EQUAL(2, LatencyHistogram::bucket_index(2));
+  CHECK_EQUAL(2, LatencyHistogram::bucket_index(3));
+  CHECK_EQUAL(11, LatencyHistogram::bucket_index(1024));
+  CHECK_EQUAL(32, LatencyHistogram::bucket_index(UINT32_MAX));
+  CHECK_EQUAL(0, LatencyHistogram::bucket_floor(0));
+  CHECK_EQUAL(1, LatencyHistogram::bucket_floor(1));
+  CHECK_EQUAL(1024, LatencyHistogram::bucket_floor(11));
+  CHECK_EQUAL(0x80000000UL, LatencyHistogram::bucket_floor(32));
+}
+
+static void test_exact_statistics(void) {
+  LatencyHistogram histogram;
+  for (uint32_t sample = 1; sample <= 100; ++sample) {
+    histogram.record(sample);
+  }
+  CHECK_EQUAL(100, histogram.count());
+  CHECK_EQUAL(1, histogram.minimum());
+  CHECK_EQUAL(100, histogram.maximum());
+  CHECK_EQUAL(5050, histogram.total());
+  CHECK_EQUAL(50, histogram.mean());
+  CHECK_EQUAL(1, histogram.percentile(0.0f));
+  CHECK_EQUAL(100, histogram.percentile(100.0f));
+}
+
+static void test_percentiles_stay_in_their_bucket(void) {
+  LatencyHistogram histogram;
+  for (uint32_t sample = 1; sample <= 1000; ++sample) {
+    histogram.record(sample);
+  }
+  const float percents[] = { 1.0f, 10.0f, 50.0f, 90.0f, 99.0f, 99.9f };
+  for (float percent : percents) {
+    uint32_t exact = static_cast<uint32_t>(percent * 10.0f + 0.5f);
+    uint32_t estimate = histogram.percentile(percent);
+    size_t bucket = LatencyHistogram::bucket_index(exact);
+    CHECK(LatencyHistogram::bucket_floor(bucket) <= estimate);
+    CHECK(estimate <= 2ULL * LatencyHistogram::bucket_floor(bucket));
+  }
+  uint32_t previous = 0;
+  for (float percent = 0.0f; percent <= 100.0f; percent += 0.5f) {
+    uint32_t estimate = histogram.percentile(percent);
+    CHECK(previous <= estimate);
+    previous = estimate;
+  }
+}
+
+static void test_top_bucket_does_not_wrap(void) {
+  LatencyHistogram histogram;
+  histogram.record(10);
+  histogram.record(0xfffffff0UL);
+  histogram.record(UINT32_MAX);
+  CHECK_EQUAL(UINT32_MAX, histogram.percentile(99.0f));
+  CHECK_EQUAL(UINT32_MAX, histogram.maximum());
+  CHECK(10 <= histogram.percentile(1.0f));
+  CHECK(histogram.percentile(1.0f) <= 16);
+
+  LatencyHistogram top_only;
+  top_only.record(0x80000000UL);
+  top_only.record(0xc0000000UL);
+  uint32_t p99 = top_only.percentile(99.0f);
+  CHECK(0x80000000UL <= p99);
+  CHECK(p99 <= 0xc0000000UL);
+}
+
+static void test_merge(void) {
+  LatencyHistogram low;
+  LatencyHistogram high;
+  LatencyHistogram empty;
+  for (uint32_t sample = 10; sample < 20; ++sample) {
+    low.record(sample);
+    high.record(sample * 100);
+  }
+  low.merge(empty);
+  CHECK_EQUAL(10, low.count());
+  low.merge(high);
+  CHECK_EQUAL(20, low.count());
+  CHECK_EQUAL(10, low.minimum());
+  CHECK_EQUAL(1900, low.maximum());
+  empty.merge(high);
+  CHECK_EQUAL(1000, empty.minimum());
+  low.clear();
+  CHECK_EQUAL(0, low.count());
+  CHECK_EQUAL(0, low.bucket(LatencyHistogram::bucket_index(15)));
+}
+
+int main(void) {
+  test_empty();
+  test_buckets();
+  test_exact_statistics();
+  test_percentiles_stay_in_their_bucket();
+  test_top_bucket_does_not_wrap();
+  test_merge();
+  return test_result();
+}
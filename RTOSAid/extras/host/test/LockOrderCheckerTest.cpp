@@ -0,0 +1,258 @@
+/*
+ * LockOrderCheckerTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LockOrderChecker.h"
+
+#include "HostPort.h"
+#include "HostTest.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const size_t CLASS_COUNT = 6;
+static const size_t TASK_COUNT = 4;
+static const size_t MAX_DEPTH = 3;
+
+static const char *CLASS_NAMES[CLASS_COUNT] = {
+    "A", "B", "C", "D", "E", "F" };
+
+static TaskHandle_t create_task(const char *name) {
+  TaskHandle_t task = NULL;
+  xTaskCreatePinnedToCore(NULL, name, 2048, NULL, 1, &task, tskNO_AFFINITY);
+  return task;
+}
+
+static void lock(LockOrderChecker& checker, LockOrderKey& key) {
+  checker.acquiring(key);
+  checker.acquired(key);
+}
+
+static void test_two_lock_inversion(void) {
+  LockOrderChecker checker;
+  checker.set_output(NULL);
+  LockOrderKey a;
+  LockOrderKey b;
+  a.set_name("A");
+  b.set_name("B");
+
+  lock(checker, a);
+  lock(checker, b);
+  checker.released(b);
+  checker.released(a);
+  CHECK_EQUAL(0, checker.violations());
+
+  lock(checker, b);
+  lock(checker, a);
+  checker.released(a);
+  checker.released(b);
+  CHECK_EQUAL(1, checker.violations());
+
+  LockOrderChecker::Violation violation;
+  CHECK(checker.most_recent_violation(&violation));
+  CHECK_EQUAL(3, violation.cycle_length);
+  CHECK(!strcmp("B", violation.cycle[0]));
+  CHECK(!strcmp("A", violation.cycle[1]));
+  CHECK(!strcmp("B", violation.cycle[2]));
+
+  // The edge is known now, so the inversion is reported only once.
+  lock(checker, b);
+  lock(checker, a);
+  checker.released(a);
+  checker.released(b);
+  CHECK_EQUAL(1, checker.violations());
+  CHECK_EQUAL(2, checker.lock_class_count());
+  CHECK_EQUAL(0, checker.untracked());
+}
+
+static void test_same_class_twice(void) {
+  LockOrderChecker checker;
+  checker.set_output(NULL);
+  LockOrderKey first;
+  LockOrderKey second;
+  LockOrderKey unnamed;
+  first.set_name("Account");
+  second.set_name("Account");
+
+  lock(checker, first);
+  lock(checker, unnamed);  // Unnamed locks are not checked
+  lock(checker, second);
+  CHECK_EQUAL(1, checker.violations());
+  LockOrderChecker::Violation violation;
+  CHECK(checker.most_recent_violation(&violation));
+  CHECK_EQUAL(2, violation.cycle_length);
+  checker.released(second);
+  checker.released(unnamed);
+  checker.released(first);
+}
+
+// The model of the lock graph that the checker should build.
+struct ReferenceGraph {
+  bool edges[CLASS_COUNT][CLASS_COUNT];
+
+  void clear(void) {
+    memset(edges, 0, sizeof(edges));
+  }
+
+  bool reachable(size_t from, size_t to) {
+    bool visited[CLASS_COUNT] = {};
+    size_t stack[CLASS_COUNT];
+    size_t depth = 0;
+    stack[depth++] = from;
+    visited[from] = true;
+    while (depth) {
+      size_t current = stack[--depth];
+      if (current == to) {
+        return true;
+      }
+      for (size_t next = 0; next < CLASS_COUNT; ++next) {
+        if (edges[current][next] && !visited[next]) {
+          visited[next] = true;
+          stack[depth++] = next;
+        }
+      }
+    }
+    return false;
+  }
+
+  // Records the edges from every held class to lock_class, in the order
+  // that the checker records them.
+  // Returns: true if a new edge closes a cycle.
+  bool acquire(const size_t *held, size_t held_count, size_t lock_class) {
+    bool violated = false;
+    for (size_t i = 0; i < held_count; ++i) {
+      size_t from = held[i];
+      if (edges[from][lock_class]) {
+        continue;
+      }
+      if (!violated) {
+        violated = from == lock_class || reachable(lock_class, from);
+      }
+      edges[from][lock_class] = true;
+    }
+    return violated;
+  }
+};
+
+static int class_index(const char *name) {
+  for (size_t i = 0; i < CLASS_COUNT; ++i) {
+    if (!strcmp(CLASS_NAMES[i], name)) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+// A reported cycle must start with the held lock and the lock being
+// locked, follow recorded edges, and end where it started.
+static bool is_cycle(
+    const LockOrderChecker::Violation& violation, ReferenceGraph& graph) {
+  if (violation.cycle_length < 2
+      || strcmp(violation.cycle[0],
+          violation.cycle[violation.cycle_length - 1])) {
+    return false;
+  }
+  for (size_t i = 0; i + 1 < violation.cycle_length; ++i) {
+    int from = class_index(violation.cycle[i]);
+    int to = class_index(violation.cycle[i + 1]);
+    if (from < 0 || to < 0 || !graph.edges[from][to]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Drives the checker with random locking from several tasks and checks
+// every report against the reference graph.
+static void test_random_locking(unsigned seed) {
+  srand(seed);
+  LockOrderChecker checker;
+  checker.set_output(NULL);
+  LockOrderKey keys[CLASS_COUNT];
+  for (size_t i = 0; i < CLASS_COUNT; ++i) {
+    keys[i].set_name(CLASS_NAMES[i]);
+  }
+  TaskHandle_t tasks[TASK_COUNT];
+  size_t held[TASK_COUNT][MAX_DEPTH];
+  size_t held_count[TASK_COUNT] = {};
+  for (size_t i = 0; i < TASK_COUNT; ++i) {
+    tasks[i] = create_task("Locker");
+  }
+  ReferenceGraph graph;
+  graph.clear();
+  uint32_t expected_violations = 0;
+
+  for (int step = 0; step < 2000; ++step) {
+    size_t task = rand() % TASK_COUNT;
+    host_set_current_task(tasks[task]);
+    size_t count = held_count[task];
+    if (count < MAX_DEPTH && (!count || rand() % 3)) {
+      // Mostly distinct classes, occasionally one that is already held.
+      size_t lock_class = rand() % CLASS_COUNT;
+      if (graph.acquire(held[task], count, lock_class)) {
+        ++expected_violations;
+      }
+      uint32_t violations_before = checker.violations();
+      lock(checker, keys[lock_class]);
+      held[task][held_count[task]++] = lock_class;
+      if (checker.violations() != violations_before) {
+        LockOrderChecker::Violation violation;
+        CHECK(checker.most_recent_violation(&violation));
+        CHECK(is_cycle(violation, graph));
+        CHECK(!strcmp(CLASS_NAMES[lock_class], violation.cycle[1]));
+      }
+    } else {
+      // Release a random held lock, usually the most recent one.
+      size_t index = rand() % 4 ? count - 1 : rand() % count;
+      checker.released(keys[held[task][index]]);
+      memmove(held[task] + index, held[task] + index + 1,
+          (count - index - 1) * sizeof(held[task][0]));
+      --held_count[task];
+    }
+    CHECK_EQUAL(expected_violations, checker.violations());
+
+    if (step % 500 == 499) {
+      checker.reset();
+      graph.clear();
+      expected_violations = 0;
+    }
+  }
+  CHECK_EQUAL(0, checker.untracked());
+
+  for (size_t task = 0; task < TASK_COUNT; ++task) {
+    host_set_current_task(tasks[task]);
+    while (held_count[task]) {
+      checker.released(keys[held[task][--held_count[task]]]);
+    }
+    vTaskDelete(tasks[task]);
+  }
+  host_set_current_task(host_main_task());
+}
+
+int main(void) {
+  test_two_lock_inversion();
+  test_same_class_twice();
+  for (unsigned seed = 1; seed <= 20; ++seed) {
+    test_random_locking(seed);
+  }
+  return test_result();
+}
@@ -0,0 +1,158 @@
+/*
+ * StackProfilerTest.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "StackProfiler.h"
+
+#include "HostTest.h"
+
+#include <string.h>
+
+static const size_t STACK_SIZE = 2048;
+
+static TaskHandle_t create_task(
+    const char *name, uint8_t *stack, StaticTask_t *task_buffer) {
+  return xTaskCreateStaticPinnedToCore(
+      NULL, name, STACK_SIZE, NULL, 1, stack, task_buffer, tskNO_AFFINITY);
+}
+
+// Simulates a task that used the top used_bytes of its stack. Stacks grow
+// down, so the deepest point is used_bytes below the top.
+static void use_stack(uint8_t *stack, size_t used_bytes) {
+  memset(stack + STACK_SIZE - used_bytes, 0, used_bytes);
+}
+
+static void test_paint_and_measure(void) {
+  static uint8_t stack[STACK_SIZE];
+  memset(stack, 0, sizeof(stack));
+  CHECK_EQUAL(0, StackProfiler::unused_bytes(stack, STACK_SIZE));
+  StackProfiler::paint(stack, STACK_SIZE);
+  CHECK_EQUAL(STACK_SIZE, StackProfiler::unused_bytes(stack, STACK_SIZE));
+  use_stack(stack, 100);
+  CHECK_EQUAL(STACK_SIZE - 100, StackProfiler::unused_bytes(stack, STACK_SIZE));
+  use_stack(stack, STACK_SIZE);
+  CHECK_EQUAL(0, StackProfiler::unused_bytes(stack, STACK_SIZE));
+}
+
+static void test_peak_across_restarts(void) {
+  StackProfiler profiler;
+  static uint8_t stack[STACK_SIZE];
+  StaticTask_t task_buffer;
+  StackProfile profile;
+  bool armed = true;
+
+  StackProfiler::paint(stack, STACK_SIZE);
+  TaskHandle_t task = create_task("Worker", stack, &task_buffer);
+  profiler.task_started("Worker", STACK_SIZE, task, stack, &armed);
+  use_stack(stack, 300);
+  CHECK(profiler.profile(0, &profile));
+  CHECK_EQUAL(300, profile.peak_used);
+  use_stack(stack, 500);
+  profiler.task_stopping(task, &armed);
+  CHECK(!armed);
+
+  // The restarted task reuses its profile and keeps the peak.
+  armed = true;
+  StackProfiler::paint(stack, STACK_SIZE);
+  profiler.task_started("Worker", STACK_SIZE, task, stack, &armed);
+  use_stack(stack, 200);
+  profiler.task_stopping(task, &armed);
+  CHECK_EQUAL(1, profiler.count());
+  CHECK(profiler.profile(0, &profile));
+  CHECK_EQUAL(500, profile.peak_used);
+  CHECK_EQUAL(2, profile.start_count);
+  CHECK_EQUAL(STACK_SIZE, profile.stack_size);
+  CHECK(!profiler.profile(1, &profile));
+  vTaskDelete(task);
+}
+
+static void test_stopped_before_it_ran(void) {
+  StackProfiler profiler;
+  static uint8_t stack[STACK_SIZE];
+  StaticTask_t task_buffer;
+  bool armed = true;
+
+  // The task is stopped before it gets to register. When it registers
+  // late, it must be ignored, since its handle is about to dangle.
+  TaskHandle_t task = create_task("Late", stack, &task_buffer);
+  profiler.task_stopping(task, &armed);
+  profiler.task_started("Late", STACK_SIZE, task, stack, &armed);
+  CHECK_EQUAL(0, profiler.count());
+  vTaskDelete(task);
+}
+
+static void test_tasks_that_share_a_name(void) {
+  StackProfiler profiler;
+  static uint8_t first_stack[STACK_SIZE];
+  static uint8_t second_stack[STACK_SIZE];
+  StaticTask_t first_buffer;
+  StaticTask_t second_buffer;
+  StackProfile profile;
+  bool first_armed = true;
+  bool second_armed = true;
+
+  StackProfiler::paint(first_stack, STACK_SIZE);
+  StackProfiler::paint(second_stack, STACK_SIZE);
+  TaskHandle_t first = create_task("Twin", first_stack, &first_buffer);
+  TaskHandle_t second = create_task("Twin", second_stack, &second_buffer);
+  profiler.task_started("Twin", STACK_SIZE, first, first_stack, &first_armed);
+  profiler.task_started(
+      "Twin", STACK_SIZE, second, second_stack, &second_armed);
+  CHECK_EQUAL(2, profiler.count());
+
+  // Stopping the second task must not end the first one's profile.
+  use_stack(first_stack, 700);
+  use_stack(second_stack, 400);
+  profiler.task_stopping(second, &second_armed);
+  CHECK(first_armed);
+  use_stack(first_stack, 900);
+  CHECK(profiler.profile(0, &profile));
+  CHECK_EQUAL(900, profile.peak_used);
+  CHECK(profiler.profile(1, &profile));
+  CHECK_EQUAL(400, profile.peak_used);
+
+  // A reset keeps only the running task.
+  profiler.reset();
+  CHECK_EQUAL(1, profiler.count());
+  CHECK(profiler.profile(0, &profile));
+  CHECK_EQUAL(900, profile.peak_used);
+  profiler.task_stopping(first, &first_armed);
+  vTaskDelete(first);
+  vTaskDelete(second);
+}
+
+static void test_recommendations(void) {
+  StackProfile profile = { "Task", 4096, 1000, 1 };
+  CHECK_EQUAL(1280, StackProfiler::recommended_stack_size(profile, 25));
+  CHECK_EQUAL(1024, StackProfiler::recommended_stack_size(profile, 0));
+  profile.peak_used = 0;
+  CHECK_EQUAL(0, StackProfiler::recommended_stack_size(profile, 25));
+}
+
+int main(void) {
+  test_paint_and_measure();
+  test_peak_across_restarts();
+  test_stopped_before_it_ran();
+  test_tasks_that_share_a_name();
+  test_recommendations();
+  return test_result();
+}
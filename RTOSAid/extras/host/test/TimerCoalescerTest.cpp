@@ -0,0 +1,196 @@
+/*
+ * TimerCoalescerTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Tests the ticks that the timer coalescer chooses against random
+ * starts, including across the tick counter's wrap.
+ */
+
+#include "TimerCoalescer.h"
+
+#include "HostPort.h"
+#include "HostTest.h"
+
+#include <stdlib.h>
+
+static const uint64_t MICROS_PER_TICK = portTICK_PERIOD_MS * 1000;
+
+static void advance_ticks(uint64_t ticks) {
+  host_advance_micros(ticks * MICROS_PER_TICK);
+}
+
+static TickType_t largest_power_of_two(TickType_t limit) {
+  TickType_t power = 1;
+  while (power <= limit / 2) {
+    power *= 2;
+  }
+  return power;
+}
+
+// The upcoming wakeups that the coalescer should remember.
+struct ReferenceWakeups {
+  TickType_t wakeups[TimerCoalescer::MAX_WAKEUPS];
+  size_t count;
+
+  void prune(TickType_t now) {
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i) {
+      if (0 < static_cast<int32_t>(wakeups[i] - now)) {
+        wakeups[kept++] = wakeups[i];
+      }
+    }
+    count = kept;
+  }
+
+  // Returns: true if a remembered wakeup lies in the window, and the
+  //          soonest such in *soonest.
+  bool soonest_in(
+      TickType_t now, TickType_t earliest, TickType_t slack,
+      TickType_t *soonest) {
+    bool found = false;
+    for (size_t i = 0; i < count; ++i) {
+      if (static_cast<TickType_t>(wakeups[i] - earliest) <= slack
+          && (!found || static_cast<TickType_t>(wakeups[i] - now)
+              < static_cast<TickType_t>(*soonest - now))) {
+        *soonest = wakeups[i];
+        found = true;
+      }
+    }
+    return found;
+  }
+
+  void add(TickType_t now, TickType_t wakeup) {
+    if (count < TimerCoalescer::MAX_WAKEUPS) {
+      wakeups[count++] = wakeup;
+      return;
+    }
+    size_t furthest = 0;
+    for (size_t i = 1; i < count; ++i) {
+      if (static_cast<TickType_t>(wakeups[furthest] - now)
+          < static_cast<TickType_t>(wakeups[i] - now)) {
+        furthest = i;
+      }
+    }
+    wakeups[furthest] = wakeup;
+  }
+};
+
+static void test_same_window_coalesces(void) {
+  TimerCoalescer coalescer;
+  TickType_t first = coalescer.coalesce(100, 15);
+  TickType_t now = xTaskGetTickCount();
+  CHECK(100 <= first && first <= 115);
+  CHECK_EQUAL(0, (now + first) % 16);
+  CHECK_EQUAL(first, coalescer.coalesce(100, 15));
+  CHECK_EQUAL(first, coalescer.coalesce(105, 10));
+  TimerCoalescingStatistics statistics;
+  coalescer.snapshot(&statistics);
+  CHECK_EQUAL(1, statistics.aligned_starts);
+  CHECK_EQUAL(2, statistics.coalesced_starts);
+}
+
+// The shared coalescer exists only once something uses it.
+static void test_shared_on_first_use(void) {
+  CHECK(!TimerCoalescer::shared_if_constructed());
+  TimerCoalescer& shared = TimerCoalescer::shared();
+  CHECK_EQUAL(
+      reinterpret_cast<uintptr_t>(&shared),
+      reinterpret_cast<uintptr_t>(TimerCoalescer::shared_if_constructed()));
+  CHECK_EQUAL(
+      reinterpret_cast<uintptr_t>(&shared),
+      reinterpret_cast<uintptr_t>(&TimerCoalescer::shared()));
+}
+
+static void test_expiration_counts(void) {
+  TimerCoalescer coalescer;
+  coalescer.record_expiration();
+  coalescer.record_expiration();
+  advance_ticks(1);
+  coalescer.record_expiration();
+  TimerCoalescingStatistics statistics;
+  coalescer.snapshot(&statistics);
+  CHECK_EQUAL(3, statistics.expirations);
+  CHECK_EQUAL(2, statistics.wakeups);
+  CHECK_EQUAL(1, statistics.wakeups_saved());
+  coalescer.reset();
+  coalescer.snapshot(&statistics);
+  CHECK_EQUAL(0, statistics.expirations);
+}
+
+// Starts timers with random timeouts and slack, checks each chosen tick
+// against the window and the reference, and lets time pass between
+// starts so that wakeups are forgotten.
+static void test_random_starts(unsigned seed, uint64_t start_tick) {
+  srand(seed);
+  TickType_t now = xTaskGetTickCount();
+  advance_ticks(static_cast<TickType_t>(start_tick - now));
+  TimerCoalescer coalescer;
+  ReferenceWakeups reference;
+  reference.count = 0;
+  uint32_t expected_coalesced = 0;
+  uint32_t expected_aligned = 0;
+
+  for (int step = 0; step < 5000; ++step) {
+    if (rand() % 3 == 0) {
+      advance_ticks(rand() % 20);
+    }
+    TickType_t timeout = rand() % 200;
+    TickType_t slack = rand() % 4 ? rand() % 40 : rand() % 1000;
+    now = xTaskGetTickCount();
+    TickType_t earliest = now + timeout;
+    reference.prune(now);
+
+    TickType_t chosen = coalescer.coalesce(timeout, slack);
+    CHECK(timeout <= chosen);
+    CHECK(chosen - timeout <= slack);
+
+    TickType_t expected;
+    if (reference.soonest_in(now, earliest, slack, &expected)) {
+      ++expected_coalesced;
+    } else {
+      // The last multiple of the alignment in the window.
+      TickType_t alignment = largest_power_of_two(slack + 1);
+      expected = (earliest + slack) & ~(alignment - 1);
+      CHECK_EQUAL(0, (now + chosen) % alignment);
+      reference.add(now, expected);
+      ++expected_aligned;
+    }
+    CHECK_EQUAL(expected, now + chosen);
+  }
+
+  TimerCoalescingStatistics statistics;
+  coalescer.snapshot(&statistics);
+  CHECK_EQUAL(expected_coalesced, statistics.coalesced_starts);
+  CHECK_EQUAL(expected_aligned, statistics.aligned_starts);
+  CHECK(expected_coalesced);
+}
+
+int main(void) {
+  test_shared_on_first_use();
+  test_same_window_coalesces();
+  test_expiration_counts();
+  for (unsigned seed = 1; seed <= 10; ++seed) {
+    test_random_starts(seed, xTaskGetTickCount() + 1000);
+  }
+  // Cross the tick counter's wrap.
+  test_random_starts(11, 0xffffffffULL - 5000);
+  return test_result();
+}
@@ -0,0 +1,320 @@
+/*
+ * TimingWheelTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Tests the timing wheel's insertion and cascading against a model that
+ * knows when every timer is due, and the lifetimes of timers and wheels.
+ */
+
+#include "TimingWheel.h"
+
+#include "HostPort.h"
+#include "HostTest.h"
+
+#include <stdlib.h>
+
+static const size_t TIMER_COUNT = 64;
+static const uint32_t NOT_PENDING = 0xffffffffUL;
+
+// Records the wheel tick on which it fires.
+class RecordTick : public VoidFunction {
+  TimingWheel& wheel;
+
+public:
+  uint32_t fire_count;
+  uint32_t fired_at;
+
+  RecordTick(TimingWheel& wheel) :
+      wheel(wheel),
+      fire_count(0),
+      fired_at(0) {
+  }
+
+  virtual void apply(void) {
+    ++fire_count;
+    fired_at = wheel.now() - 1;
+  }
+};
+
+// Deletes its timer when it fires.
+class DeleteTimer : public VoidFunction {
+public:
+  WheelTimer *timer;
+
+  DeleteTimer() :
+      timer(NULL) {
+  }
+
+  virtual void apply(void) {
+    delete timer;
+    timer = NULL;
+  }
+};
+
+// Restarts its timer when it fires, like a periodic timer.
+class Restart : public VoidFunction {
+public:
+  TimingWheel *wheel;
+  WheelTimer *timer;
+  uint32_t fire_count;
+
+  Restart() :
+      wheel(NULL),
+      timer(NULL),
+      fire_count(0) {
+  }
+
+  virtual void apply(void) {
+    ++fire_count;
+    wheel->reset(*timer);
+  }
+};
+
+// Mostly short durations, which stay on level 0, some that cascade once
+// or twice, and a few that cascade from level 3.
+static uint32_t random_duration(void) {
+  switch (rand() % 10) {
+  case 0:
+    return rand() % 300000;
+  case 1:
+  case 2:
+  case 3:
+    return rand() % 4096;
+  default:
+    return rand() % 64;
+  }
+}
+
+static void test_random_timers(unsigned seed) {
+  srand(seed);
+  TimingWheel wheel;
+  RecordTick *functions[TIMER_COUNT];
+  WheelTimer *timers[TIMER_COUNT];
+  uint32_t due[TIMER_COUNT];
+  uint32_t durations[TIMER_COUNT];
+  uint32_t expected_fired = 0;
+  for (size_t i = 0; i < TIMER_COUNT; ++i) {
+    functions[i] = new RecordTick(wheel);
+    timers[i] = new WheelTimer(*functions[i]);
+    due[i] = NOT_PENDING;
+    durations[i] = NOT_PENDING;
+  }
+
+  for (uint32_t step = 0; step < 20000; ++step) {
+    if (rand() % 4 == 0) {
+      size_t i = rand() % TIMER_COUNT;
+      bool was_pending = due[i] != NOT_PENDING;
+      switch (rand() % 4) {
+      case 0:
+        CHECK_EQUAL(was_pending, wheel.stop(*timers[i]));
+        due[i] = NOT_PENDING;
+        break;
+      case 1:
+        CHECK_EQUAL(was_pending, wheel.reset(*timers[i]));
+        if (durations[i] != NOT_PENDING) {
+          due[i] = wheel.now() + durations[i];
+        }
+        break;
+      default:
+        durations[i] = random_duration();
+        CHECK_EQUAL(was_pending, wheel.start_ticks(*timers[i], durations[i]));
+        due[i] = wheel.now() + durations[i];
+        break;
+      }
+      CHECK_EQUAL(due[i] != NOT_PENDING, timers[i]->pending());
+    }
+
+    uint32_t processing = wheel.now();
+    uint32_t fire_counts[TIMER_COUNT];
+    for (size_t i = 0; i < TIMER_COUNT; ++i) {
+      fire_counts[i] = functions[i]->fire_count;
+    }
+    wheel.advance();
+    for (size_t i = 0; i < TIMER_COUNT; ++i) {
+      bool fired = functions[i]->fire_count != fire_counts[i];
+      CHECK_EQUAL(due[i] == processing, fired);
+      if (fired) {
+        CHECK_EQUAL(processing, functions[i]->fired_at);
+        due[i] = NOT_PENDING;
+        ++expected_fired;
+      }
+    }
+  }
+
+  // Let everything that is still pending fire.
+  uint32_t pending = 0;
+  for (size_t i = 0; i < TIMER_COUNT; ++i) {
+    pending += due[i] != NOT_PENDING;
+  }
+  CHECK_EQUAL(pending, wheel.pending());
+  while (wheel.pending()) {
+    wheel.advance();
+  }
+  for (size_t i = 0; i < TIMER_COUNT; ++i) {
+    if (due[i] != NOT_PENDING) {
+      CHECK_EQUAL(due[i], functions[i]->fired_at);
+      ++expected_fired;
+    }
+  }
+  CHECK_EQUAL(expected_fired, wheel.fired());
+
+  for (size_t i = 0; i < TIMER_COUNT; ++i) {
+    delete timers[i];
+    delete functions[i];
+  }
+}
+
+// Timers beyond the wheel's span are parked at the top level until they
+// come in range.
+static void test_beyond_span(void) {
+  TimingWheel wheel;
+  RecordTick first(wheel);
+  RecordTick second(wheel);
+  WheelTimer first_timer(first);
+  WheelTimer second_timer(second);
+  wheel.start_ticks(first_timer, TimingWheel::SPAN + 100);
+  wheel.start_ticks(second_timer, 2 * TimingWheel::SPAN + 5);
+  while (wheel.pending()) {
+    wheel.advance();
+  }
+  CHECK_EQUAL(1, first.fire_count);
+  CHECK_EQUAL(TimingWheel::SPAN + 100, first.fired_at);
+  CHECK_EQUAL(1, second.fire_count);
+  CHECK_EQUAL(2 * TimingWheel::SPAN + 5, second.fired_at);
+}
+
+// A slot holding many more timers than are redistributed per critical
+// section cascades them all, to the right ticks.
+static void test_crowded_cascade(void) {
+  const size_t count = 1000;
+  TimingWheel wheel;
+  RecordTick *functions[count];
+  WheelTimer *timers[count];
+  for (size_t i = 0; i < count; ++i) {
+    functions[i] = new RecordTick(wheel);
+    timers[i] = new WheelTimer(*functions[i]);
+    // Every timer lands in the same level 2 slot.
+    wheel.start_ticks(*timers[i], 5000 + i % 64);
+  }
+  while (wheel.pending()) {
+    wheel.advance();
+  }
+  CHECK_EQUAL(count, wheel.fired());
+  for (size_t i = 0; i < count; ++i) {
+    CHECK_EQUAL(1, functions[i]->fire_count);
+    CHECK_EQUAL(5000 + i % 64, functions[i]->fired_at);
+    delete timers[i];
+    delete functions[i];
+  }
+}
+
+static void test_reset_never_started(void) {
+  TimingWheel wheel;
+  RecordTick function(wheel);
+  WheelTimer timer(function);
+  CHECK(!wheel.reset(timer));
+  CHECK(!timer.pending());
+  CHECK_EQUAL(0, wheel.pending());
+
+  // A duration of 0 is a duration, so reset() restarts it.
+  wheel.start_ticks(timer, 0);
+  wheel.advance();
+  CHECK_EQUAL(1, function.fire_count);
+  CHECK(!wheel.reset(timer));
+  CHECK(timer.pending());
+  wheel.advance();
+  CHECK_EQUAL(2, function.fire_count);
+}
+
+static void test_restart_from_callback(void) {
+  TimingWheel wheel;
+  Restart function;
+  WheelTimer timer(function);
+  function.wheel = &wheel;
+  function.timer = &timer;
+  wheel.start_ticks(timer, 9);
+  for (int i = 0; i < 100; ++i) {
+    wheel.advance();
+  }
+  CHECK_EQUAL(10, function.fire_count);
+  CHECK(timer.pending());
+  CHECK_EQUAL(1, wheel.pending());
+}
+
+// A timer may be destroyed while pending, or by its own callback, after
+// which the wheel must not touch it.
+static void test_destroy_timer(void) {
+  TimingWheel wheel;
+  RecordTick function(wheel);
+  WheelTimer *pending = new WheelTimer(function);
+  wheel.start_ticks(*pending, 10);
+  CHECK_EQUAL(1, wheel.pending());
+  delete pending;
+  CHECK_EQUAL(0, wheel.pending());
+
+  DeleteTimer deleter;
+  RecordTick neighbor_function(wheel);
+  WheelTimer neighbor(neighbor_function);
+  deleter.timer = new WheelTimer(deleter);
+  wheel.start_ticks(neighbor, 3);
+  wheel.start_ticks(*deleter.timer, 3);
+  for (int i = 0; i < 20; ++i) {
+    wheel.advance();
+  }
+  CHECK(!deleter.timer);
+  CHECK_EQUAL(1, neighbor_function.fire_count);
+  CHECK_EQUAL(0, function.fire_count);
+  CHECK_EQUAL(0, wheel.pending());
+  CHECK_EQUAL(2, wheel.fired());
+}
+
+// A wheel may be destroyed before the timers that were started on it,
+// whether they are pending or not.
+static void test_destroy_wheel(void) {
+  TimingWheel *wheel = new TimingWheel();
+  RecordTick function(*wheel);
+  WheelTimer fired(function);
+  WheelTimer stopped(function);
+  WheelTimer pending(function);
+  wheel->start_ticks(fired, 0);
+  wheel->start_ticks(stopped, 5);
+  wheel->start_ticks(pending, 5000);
+  wheel->stop(stopped);
+  wheel->advance();
+  CHECK_EQUAL(1, function.fire_count);
+  delete wheel;
+  CHECK(!fired.pending());
+  CHECK(!stopped.pending());
+  CHECK(!pending.pending());
+}
+
+int main(void) {
+  test_reset_never_started();
+  test_restart_from_callback();
+  test_destroy_timer();
+  test_destroy_wheel();
+  test_beyond_span();
+  test_crowded_cascade();
+  for (unsigned seed = 1; seed <= 10; ++seed) {
+    test_random_timers(seed);
+  }
+  return test_result();
+}
@@ -35,9 +35,40 @@ BaseMutex::~BaseMutex() {
 }
 
 bool BaseMutex::lock(TickType_t wait_time_in_ticks) {
-  return xSemaphoreTake(semaphore_handle, wait_time_in_ticks) == pdTRUE;
+#if RTOSAID_LOCK_ORDER_CHECKING
+  LockOrder.acquiring(lock_order_key);
+#endif
+#if RTOSAID_MUTEX_STATISTICS
+  bool locked =
+      instrumentation.lock_mutex(semaphore_handle, wait_time_in_ticks);
+#else
+  bool locked =
+      xSemaphoreTake(semaphore_handle, wait_time_in_ticks) == pdTRUE;
+#endif
+#if RTOSAID_LOCK_ORDER_CHECKING
+  if (locked) {
+    LockOrder.acquired(lock_order_key);
+  }
+#endif
+  return locked;
+}
+
+bool BaseMutex::statistics(MutexStatistics *snapshot) {
+#if RTOSAID_MUTEX_STATISTICS
+  instrumentation.snapshot(snapshot);
+  return true;
+#else
+  return false;
+#endif
 }
 
 void BaseMutex::unlock() {
+#if RTOSAID_LOCK_ORDER_CHECKING
+  LockOrder.released(lock_order_key);
+#endif
+#if RTOSAID_MUTEX_STATISTICS
+  instrumentation.unlock_mutex(semaphore_handle);
+#else
   xSemaphoreGive(semaphore_handle);
+#endif
 }
@@ -28,7 +28,10 @@
 
 #include "Arduino.h"
 
+#include "LockOrderChecker.h"
 #include "MutexLock.h"
+#include "MutexStatistics.h"
+#include "RTOSAidConfig.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
@@ -37,6 +40,12 @@ class BaseMutex {
   friend MutexLock;
 
   SemaphoreHandle_t semaphore_handle;
+#if RTOSAID_MUTEX_STATISTICS
+  MutexInstrumentation instrumentation;
+#endif
+#if RTOSAID_LOCK_ORDER_CHECKING
+  LockOrderKey lock_order_key;
+#endif
 
   /**
    * Locks the semaphore, returning true if the semaphore is locked and false
@@ -68,6 +77,11 @@ protected:
    * method is not thread-safe.
    */
   inline bool set_handle(SemaphoreHandle_t handle) {
+#if RTOSAID_MUTEX_STATISTICS
+    if (handle) {
+      instrumentation.start();
+    }
+#endif
     return NULL != (semaphore_handle = handle);
   }
 
@@ -88,6 +102,28 @@ public:
    * setup because it is not thread-safe.
    */
   virtual bool begin(void) = 0;
+
+  /**
+   * Names this mutex in statistics and lock order reports. The name must
+   * outlive the mutex. Does nothing unless RTOSAID_MUTEX_STATISTICS or
+   * RTOSAID_LOCK_ORDER_CHECKING is on.
+   */
+  inline void set_name(const char *name) {
+#if RTOSAID_MUTEX_STATISTICS
+    instrumentation.set_name(name);
+#endif
+#if RTOSAID_LOCK_ORDER_CHECKING
+    lock_order_key.set_name(name);
+#endif
+  }
+
+  /**
+   * Retrieves this mutex's statistics.
+   *
+   * Returns: true if *snapshot was filled in, false if statistics
+   * are turned off (see RTOSAidConfig.h).
+   */
+  bool statistics(MutexStatistics *snapshot);
 };
 
 #endif /* LIBRARIES_RTOSAID_SRC_BASEMUTEX_H_ */
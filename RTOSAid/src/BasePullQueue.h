@@ -35,9 +35,16 @@
 
 #include "Arduino.h"
 
+#include "QueueStatistics.h"
+#include "RTOSAidConfig.h"
+
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 
+#include <atomic>
+
+class BaseTaskWithAction;
+
 class BasePullQueue {
 
   size_t message_size;
@@ -46,6 +53,32 @@ class BasePullQueue {
   QueueHandle_t queue_handle;
   StaticQueue_t queue_buffer;
 
+  // The task to notify after each send, if any, and the bits it receives.
+  std::atomic<BaseTaskWithAction *> send_task;
+  std::atomic<uint32_t> send_bits;
+#if RTOSAID_QUEUE_STATISTICS
+  QueueInstrumentation instrumentation;
+#endif
+
+  inline bool receive(void *message, TickType_t timeout) {
+#if RTOSAID_QUEUE_STATISTICS
+    return instrumentation.receive(queue_handle, message, timeout);
+#else
+    return xQueueReceive(queue_handle, message, timeout) == pdTRUE;
+#endif
+  }
+
+  void notify_send_task(void);
+  void IRAM_ATTR notify_send_task_from_isr(void);
+
+  inline bool send(const void *message, TickType_t timeout) {
+#if RTOSAID_QUEUE_STATISTICS
+    return instrumentation.send(queue_handle, message, timeout);
+#else
+    return xQueueSendToBack(queue_handle, message, timeout) == pdTRUE;
+#endif
+  }
+
 protected:
 
   /**
@@ -70,9 +103,34 @@ protected:
 
   bool really_pull_message(void *message, TickType_t timeout = portMAX_DELAY);
 
+  /**
+   * Pulls up to max_count messages into consecutive slots in messages,
+   * waiting at most timeout ticks for the first message and not waiting
+   * at all for the rest. FreeRTOS still copies one message per kernel
+   * call; the batch saves the wakeup per message.
+   *
+   * Returns: the number of messages pulled, 0 if none arrived in time.
+   */
+  size_t really_pull_messages(
+      void *messages, size_t max_count, TickType_t timeout = portMAX_DELAY);
+
   bool really_send_message(
       const void * const message, TickType_t timeout = portMAX_DELAY);
 
+  /**
+   * Sends up to count consecutive messages, waiting at most timeout
+   * ticks for room for the first message and not waiting at all for
+   * the rest. Sending stops when the queue fills. As with
+   * really_pull_messages(), each message is still a kernel call.
+   *
+   * Returns: the number of messages sent, which will be less than
+   * count if the queue filled.
+   */
+  size_t really_send_messages(
+      const void * const messages,
+      size_t count,
+      TickType_t timeout = portMAX_DELAY);
+
   /**
    * Sends a message from an interrupt service routine (ISR) and yields if a
    * higher priority task is awakened.
@@ -106,6 +164,29 @@ public:
    */
   bool begin(void);
 
+  /**
+   * Returns: the maximum number of messages that the queue can hold.
+   */
+  inline UBaseType_t capacity(void) const {
+    return queue_length;
+  }
+
+  /**
+   * Retrieve this queue's FreeRTOS handle. Note that the returned
+   * handle will only be valid if the queue is running, i.e. if
+   * begin() has run successfully.
+   *
+   * NOTE: production code SHOULD NOT references the queue handle
+   *       directly. This method is provided ONLY to aid migrating
+   *       from the low-level Queue API to this class and for
+   *       library classes like QueueSetWaiter.
+   *
+   * Returns: the queue handle, as described above.
+   */
+  inline QueueHandle_t handle(void) const {
+    return queue_handle;
+  }
+
   /**
    * Returns true if the queue is valid and can be used or false otherwise.
    * Note that this method will return false if begin() has not been invoked,
@@ -119,6 +200,32 @@ public:
    * certainly undesirable behavior.
    */
   UBaseType_t waiting_message_count(void) const;
+
+  /**
+   * Names this queue in statistics reports. The name must outlive the
+   * queue. Does nothing unless RTOSAID_QUEUE_STATISTICS is on.
+   */
+  inline void set_name(const char *name) {
+#if RTOSAID_QUEUE_STATISTICS
+    instrumentation.set_name(name);
+#endif
+  }
+
+  /**
+   * Names a task to notify after each successful send, from a task or an
+   * ISR. The task receives the specified bits via notify_bits(). Pass
+   * NULL to stop notifications. Only one task can be notified. CoReceive
+   * uses this to wake its coroutine scheduler when a message arrives.
+   */
+  void set_send_notification(BaseTaskWithAction *task, uint32_t bits);
+
+  /**
+   * Retrieves this queue's statistics.
+   *
+   * Returns: true if *snapshot was filled in, false if statistics
+   * are turned off (see RTOSAidConfig.h).
+   */
+  bool statistics(QueueStatistics *snapshot);
 };
 
 #endif /* BASEPULLQUEUE_H_ */
@@ -26,13 +26,21 @@
 
 #include "BasePullQueueH.h"
 
+#include "BaseTaskWithAction.h"
+#include "QueueBatchT.h"
+
 BasePullQueueH::BasePullQueueH(
     size_t message_size,
     UBaseType_t queue_length) :
         message_size(message_size),
         queue_length(queue_length),
-        queue_handle(NULL) {
-
+        queue_handle(NULL),
+        send_task(NULL),
+        send_bits(0)
+#if RTOSAID_QUEUE_STATISTICS
+        , instrumentation(queue_length)
+#endif
+        {
 }
 
 BasePullQueueH::~BasePullQueueH() {
@@ -42,20 +50,67 @@ BasePullQueueH::~BasePullQueueH() {
   }
 }
 
+void BasePullQueueH::notify_send_task(void) {
+  BaseTaskWithAction *task = send_task.load(std::memory_order_acquire);
+  if (task) {
+    task->notify_bits(send_bits.load(std::memory_order_relaxed));
+  }
+}
+
+void BasePullQueueH::notify_send_task_from_isr(void) {
+  BaseTaskWithAction *task = send_task.load(std::memory_order_acquire);
+  if (task) {
+    task->notify_bits_from_isr(send_bits.load(std::memory_order_relaxed));
+  }
+}
+
 bool BasePullQueueH::really_peek_message(void *message, TickType_t timeout) {
   return xQueuePeek(queue_handle, message, timeout) == pdTRUE;
 }
 
 bool BasePullQueueH::really_pull_message(void *message, TickType_t timeout) {
-  return xQueueReceive(queue_handle, message, timeout) == pdTRUE;
+  return receive(message, timeout);
+}
+
+size_t BasePullQueueH::really_pull_messages(
+    void *messages, size_t max_count, TickType_t timeout) {
+  uint8_t *slots = static_cast<uint8_t *>(messages);
+  return transfer_queue_batch(
+      max_count,
+      timeout,
+      [this, slots](size_t index, TickType_t ticks_to_wait) {
+        return receive(slots + index * message_size, ticks_to_wait);
+      });
 }
 
 bool BasePullQueueH::really_send_message(
     const void * const message, TickType_t timeout) {
-  return xQueueSendToBack(queue_handle, message, timeout) == pdTRUE;
+  bool sent = send(message, timeout);
+  if (sent) {
+    notify_send_task();
+  }
+  return sent;
+}
+
+size_t BasePullQueueH::really_send_messages(
+    const void * const messages, size_t count, TickType_t timeout) {
+  const uint8_t *slots = static_cast<const uint8_t *>(messages);
+  size_t sent = transfer_queue_batch(
+      count,
+      timeout,
+      [this, slots](size_t index, TickType_t ticks_to_wait) {
+        return send(slots + index * message_size, ticks_to_wait);
+      });
+  if (sent) {
+    notify_send_task();
+  }
+  return sent;
 }
 
 bool BasePullQueueH::really_send_message_from_ISR(const void * const message) {
+#if RTOSAID_QUEUE_STATISTICS
+  bool result = instrumentation.send_from_isr(queue_handle, message);
+#else
   BaseType_t higher_priority_task_woken;
   bool result = xQueueSendToBackFromISR(
       queue_handle,
@@ -64,15 +119,39 @@ bool BasePullQueueH::really_send_message_from_ISR(const void * const message) {
   if (higher_priority_task_woken) {
     portYIELD_FROM_ISR();
   }
+#endif
+  if (result) {
+    notify_send_task_from_isr();
+  }
   return result;
 }
 
+void BasePullQueueH::set_send_notification(BaseTaskWithAction *task, uint32_t bits) {
+  send_bits.store(bits, std::memory_order_relaxed);
+  send_task.store(task, std::memory_order_release);
+}
+
 UBaseType_t BasePullQueueH::available_message_storage(void) const {
   return uxQueueSpacesAvailable(queue_handle);
 }
 
 bool BasePullQueueH::begin(void) {
-  return (queue_handle = xQueueCreate(queue_length, message_size));
+  queue_handle = xQueueCreate(queue_length, message_size);
+#if RTOSAID_QUEUE_STATISTICS
+  if (queue_handle) {
+    instrumentation.start();
+  }
+#endif
+  return queue_handle;
+}
+
+bool BasePullQueueH::statistics(QueueStatistics *snapshot) {
+#if RTOSAID_QUEUE_STATISTICS
+  instrumentation.snapshot(snapshot);
+  return true;
+#else
+  return false;
+#endif
 }
 
 bool BasePullQueueH::valid(void) const {
@@ -26,13 +26,46 @@
 
 #include "Arduino.h"
 
+#include "QueueStatistics.h"
+#include "RTOSAidConfig.h"
+
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 
+#include <atomic>
+
+class BaseTaskWithAction;
+
 class BasePullQueueH {
   const size_t message_size;
   const UBaseType_t queue_length;
   QueueHandle_t queue_handle;
+
+  // The task to notify after each send, if any, and the bits it receives.
+  std::atomic<BaseTaskWithAction *> send_task;
+  std::atomic<uint32_t> send_bits;
+#if RTOSAID_QUEUE_STATISTICS
+  QueueInstrumentation instrumentation;
+#endif
+
+  inline bool receive(void *message, TickType_t timeout) {
+#if RTOSAID_QUEUE_STATISTICS
+    return instrumentation.receive(queue_handle, message, timeout);
+#else
+    return xQueueReceive(queue_handle, message, timeout) == pdTRUE;
+#endif
+  }
+
+  void notify_send_task(void);
+  void IRAM_ATTR notify_send_task_from_isr(void);
+
+  inline bool send(const void *message, TickType_t timeout) {
+#if RTOSAID_QUEUE_STATISTICS
+    return instrumentation.send(queue_handle, message, timeout);
+#else
+    return xQueueSendToBack(queue_handle, message, timeout) == pdTRUE;
+#endif
+  }
 protected:
 
   /*
@@ -92,6 +125,27 @@ protected:
    */
   bool really_pull_message(void *message, TickType_t timeout = portMAX_DELAY);
 
+  /*
+   * Pull up to max_count messages from the queue, waiting for the first
+   * message but not for the rest. Use this to drain a backlog with one
+   * wakeup. FreeRTOS still copies one message per kernel call.
+   *
+   *
+   * Parameters
+   *
+   * Name          Contents
+   * ------------- ----------------------------------------------------------
+   * messages      Receives the pulled messages in consecutive slots. Must
+   *               have room for max_count messages.
+   * max_count     The maximum number of messages to pull
+   * timeout       The wait limit for the first message in ticks.
+   *
+   * Returns: the number of messages pulled, 0 if none arrived within
+   * the specified timeout.
+   */
+  size_t really_pull_messages(
+      void *messages, size_t max_count, TickType_t timeout = portMAX_DELAY);
+
 
   /*
    * Add a a message to the end of the queue
@@ -110,6 +164,28 @@ protected:
   bool really_send_message(
       const void * const message, TickType_t timeout = portMAX_DELAY);
 
+  /*
+   * Add up to count messages to the end of the queue, waiting for room
+   * for the first message but not for the rest. Each message is still a
+   * kernel call.
+   *
+   *
+   * Parameters
+   *
+   * Name          Contents
+   * ------------- ----------------------------------------------------------
+   * messages      The messages to send, in consecutive slots
+   * count         The number of messages to send
+   * timeout       The wait limit for the first message in ticks.
+   *
+   * Returns: the number of messages sent, which will be less than count
+   * if the queue fills.
+   */
+  size_t really_send_messages(
+      const void * const messages,
+      size_t count,
+      TickType_t timeout = portMAX_DELAY);
+
   /*
    * Sends a message from an interrupt service routine (ISR) and yields if a
    * higher priority task is awakened.
@@ -136,6 +212,13 @@ public:
    */
   bool begin(void);
 
+  /*
+   * Returns: the maximum number of messages that the queue can hold.
+   */
+  inline UBaseType_t capacity(void) const {
+    return queue_length;
+  }
+
   /*
    * Retrieve this queue's FreeRTOS handle. Note that the returned
    * handle will only be valid if the queue is running, i.e. if
@@ -165,6 +248,32 @@ public:
    */
   UBaseType_t waiting_message_count(void) const;
 
+  /*
+   * Names this queue in statistics reports. The name must outlive the
+   * queue. Does nothing unless RTOSAID_QUEUE_STATISTICS is on.
+   */
+  inline void set_name(const char *name) {
+#if RTOSAID_QUEUE_STATISTICS
+    instrumentation.set_name(name);
+#endif
+  }
+
+  /*
+   * Names a task to notify after each successful send, from a task or an
+   * ISR. The task receives the specified bits via notify_bits(). Pass
+   * NULL to stop notifications. Only one task can be notified. CoReceive
+   * uses this to wake its coroutine scheduler when a message arrives.
+   */
+  void set_send_notification(BaseTaskWithAction *task, uint32_t bits);
+
+  /*
+   * Retrieves this queue's statistics.
+   *
+   * Returns: true if *snapshot was filled in, false if statistics
+   * are turned off (see RTOSAidConfig.h).
+   */
+  bool statistics(QueueStatistics *snapshot);
+
 };
 
 #endif /* SRC_BASEPULLQUEUEH_H_ */
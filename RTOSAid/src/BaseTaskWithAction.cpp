@@ -23,34 +23,99 @@
 
 #include "BaseTaskWithAction.h"
 
+#include "esp_timer.h"
+
 BaseTaskWithAction::BaseTaskWithAction(
     TaskAction *action,
     const char *name,
     const UBaseType_t priority,
-    const size_t stack_size) :
+    const size_t stack_size,
+    const BaseType_t core) :
       action(action),
       name(name),
       priority(priority),
       stack_size(stack_size),
-      task_handle(NULL) {
+      core(core),
+      handle_lock(portMUX_INITIALIZER_UNLOCKED),
+      task_handle(NULL),
+      retired(false),
+      completion(xSemaphoreCreateBinaryStatic(&completion_buffer))
+#if RTOSAID_TASK_STATISTICS
+      , instrumentation(name, priority, stack_size)
+#endif
+#if RTOSAID_STACK_PROFILING
+      , profiled_stack(NULL)
+      , profiling_armed(false)
+#endif
+      {
   action->containing_task = this;
 }
 
 BaseTaskWithAction::~BaseTaskWithAction() {
   if (task_handle) {
-    vTaskDelete(task_handle);
-    task_handle = NULL;
+    delete_task();
   }
+  vSemaphoreDelete(completion);
 }
 
 bool BaseTaskWithAction::set_task_handle(TaskHandle_t task_handle) {
-  this->task_handle = task_handle;
-  return this->task_handle;
+  // A task with a higher priority, or one on the other core, can run to
+  // completion before its creator gets here. Its handle is dead by then.
+  portENTER_CRITICAL(&handle_lock);
+  if (!retired) {
+    this->task_handle = task_handle;
+  }
+  portEXIT_CRITICAL(&handle_lock);
+  return task_handle;
 }
 
 
 void BaseTaskWithAction::delay_millis(uint32_t millis) {
-  vTaskDelay(pdMS_TO_TICKS(millis));
+#if RTOSAID_TASK_STATISTICS
+  int64_t delay_started_at = esp_timer_get_time();
+#endif
+  const TickType_t ticks = pdMS_TO_TICKS(millis);
+  const TickType_t start = xTaskGetTickCount();
+
+  // Waiting for a notification without clearing any bits lets
+  // cancellation end the delay without consuming notifications that
+  // the action is yet to wait for. Other notifications end the wait
+  // early, so keep waiting for the time remaining.
+  for (TickType_t elapsed = 0;
+      elapsed < ticks && !cancellation.cancelled();
+      elapsed = xTaskGetTickCount() - start) {
+    xTaskNotifyWait(0, 0, NULL, ticks - elapsed);
+  }
+
+#if RTOSAID_TASK_STATISTICS
+  instrumentation.record_delay(delay_started_at);
+#endif
+}
+
+void BaseTaskWithAction::delete_task(void) {
+  TaskHandle_t task = retire_task();
+  if (task) {
+    vTaskDelete(task);
+  }
+}
+
+void BaseTaskWithAction::finish_task(void) {
+  delete_task();
+}
+
+bool BaseTaskWithAction::join(uint32_t millis) {
+  if (!task_handle) {
+    return true;
+  }
+  if (task_handle == xTaskGetCurrentTaskHandle()) {
+    return false;
+  }
+  bool finished = xSemaphoreTake(completion, pdMS_TO_TICKS(millis)) == pdTRUE;
+  if (finished) {
+    // Let any other joiners through as well.
+    xSemaphoreGive(completion);
+  }
+  return finished;
 }
 
 void BaseTaskWithAction::notify(void) {
@@ -65,24 +130,106 @@ void BaseTaskWithAction::notify_from_isr(void) {
    }
 }
 
+void BaseTaskWithAction::notify_bits(uint32_t bits) {
+  xTaskNotify(task_handle, bits, eSetBits);
+}
+
+void BaseTaskWithAction::notify_bits_from_isr(uint32_t bits) {
+  BaseType_t higher_priority_task_woken = pdFALSE;
+  xTaskNotifyFromISR(
+      task_handle, bits, eSetBits, &higher_priority_task_woken);
+  if (higher_priority_task_woken) {
+    portYIELD_FROM_ISR();
+  }
+}
+
+void BaseTaskWithAction::prepare_to_start(void *stack) {
+  portENTER_CRITICAL(&handle_lock);
+  retired = false;
+  portEXIT_CRITICAL(&handle_lock);
+  cancellation.reset();
+  xSemaphoreTake(completion, 0);
+#if RTOSAID_TASK_STATISTICS
+  instrumentation.arm();
+#endif
+#if RTOSAID_STACK_PROFILING
+  profiled_stack = stack;
+  profiling_armed = true;
+  if (stack) {
+    StackProfiler::paint(stack, stack_size);
+  }
+#endif
+}
+
 void BaseTaskWithAction::resume(void) {
   vTaskResume(task_handle);
 }
 
+TaskHandle_t BaseTaskWithAction::retire_task(void) {
+  // Unbinding waits for any cancel() that is notifying the task, so the
+  // caller can delete the task once this returns.
+  portENTER_CRITICAL(&handle_lock);
+  TaskHandle_t retired_task = retired ? NULL : task_handle;
+  task_handle = NULL;
+  retired = true;
+  cancellation.bind(NULL);
+  portEXIT_CRITICAL(&handle_lock);
+  if (!retired_task) {
+    return NULL;
+  }
+#if RTOSAID_STACK_PROFILING
+  StackProfiles.task_stopping(retired_task, &profiling_armed);
+#endif
+#if RTOSAID_TASK_STATISTICS
+  instrumentation.stop();
+#endif
+  xSemaphoreGive(completion);
+  return retired_task;
+}
+
 void BaseTaskWithAction::run_task_loop(void *params) {
   static_cast<BaseTaskWithAction *>(params)->start_task();
 }
 
 void BaseTaskWithAction::start_task(void) {
+  // Record the handle here, rather than relying on the creator, so that
+  // the task is bound before its action runs and retire_task() finds it.
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  portENTER_CRITICAL(&handle_lock);
+  if (!retired) {
+    task_handle = self;
+    cancellation.bind(self);
+  }
+  portEXIT_CRITICAL(&handle_lock);
+#if RTOSAID_TASK_STATISTICS
+  // The task registers itself so that registration cannot race with
+  // the creating task recording the handle, or with retire_task().
+  instrumentation.start(self);
+#endif
+#if RTOSAID_STACK_PROFILING
+  StackProfiles.task_started(
+      name,
+      stack_size,
+      self,
+      profiled_stack,
+      &profiling_armed);
+#endif
   action->run();
-  vTaskDelete(task_handle);
-  task_handle = NULL;
+  finish_task();
+}
+
+bool BaseTaskWithAction::statistics(TaskStatistics *snapshot) {
+#if RTOSAID_TASK_STATISTICS
+  instrumentation.snapshot(snapshot);
+  return true;
+#else
+  return false;
+#endif
 }
 
 void BaseTaskWithAction::stop(void) {
   if (task_handle) {
-    vTaskDelete(task_handle);
-    task_handle = NULL;
+    delete_task();
   }
 }
 
@@ -91,7 +238,60 @@ void BaseTaskWithAction::suspend(void) {
 }
 
 uint32_t BaseTaskWithAction::wait_for_notification(uint32_t millis) {
-  return ulTaskNotifyTake(true, pdMS_TO_TICKS(millis));
+  if (cancellation.cancelled()) {
+    return 0;
+  }
+#if RTOSAID_TASK_STATISTICS
+  uint32_t result =
+      instrumentation.wait_for_notification(pdMS_TO_TICKS(millis));
+#else
+  uint32_t result = ulTaskNotifyTake(true, pdMS_TO_TICKS(millis));
+#endif
+  return cancellation.cancelled() ? 0 : result;
+}
+
+uint32_t BaseTaskWithAction::wait_for_bits(uint32_t mask, uint32_t millis) {
+#if RTOSAID_TASK_STATISTICS
+  int64_t wait_started_at = esp_timer_get_time();
+#endif
+  const TickType_t timeout = pdMS_TO_TICKS(millis);
+  const TickType_t start = xTaskGetTickCount();
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  uint32_t received = 0;
+  mask &= ~CancellationToken::CANCEL_BIT;
+
+  for (;;) {
+    // Take any bits that are already pending. An earlier wait might have
+    // consumed the notification that set them, so notify ourselves
+    // without changing the value. The zero timeout wait then returns
+    // immediately, clearing the masked bits.
+    uint32_t value = 0;
+    xTaskNotify(self, 0, eNoAction);
+    xTaskNotifyWait(0, mask, &value, 0);
+    received = value & mask;
+    if (received || cancellation.cancelled()) {
+      break;
+    }
+
+    TickType_t remaining = timeout;
+    if (timeout != portMAX_DELAY) {
+      TickType_t elapsed = xTaskGetTickCount() - start;
+      if (timeout <= elapsed) {
+        break;
+      }
+      remaining = timeout - elapsed;
+    }
+
+    // Wait for any notification, then check the bits again. Bits outside
+    // the mask also end the wait, so the loop resumes waiting for the
+    // time remaining.
+    xTaskNotifyWait(0, 0, NULL, remaining);
+  }
+
+#if RTOSAID_TASK_STATISTICS
+  instrumentation.record_wait(wait_started_at, received);
+#endif
+  return received;
 }
 
 void BaseTaskWithAction::yield() {
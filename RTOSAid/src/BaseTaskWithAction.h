@@ -25,9 +25,14 @@
 #define LIBRARIES_RTOSAID_SRC_BASETASKWITHACTION_H_
 
 #include "Arduino.h"
+#include "CancellationToken.h"
+#include "RTOSAidConfig.h"
+#include "StackProfiler.h"
 #include "TaskAction.h"
+#include "TaskStatistics.h"
 
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
 
 class TaskAction;
@@ -39,23 +44,89 @@ class BaseTaskWithAction {
   const char *name;
   const UBaseType_t priority;
   const size_t stack_size;
-  TaskHandle_t task_handle;
+  const BaseType_t core;
+
+  // The task records its own handle when it starts, and the creating
+  // task records it when the task is created, unless the task has
+  // already retired by then.
+  portMUX_TYPE handle_lock;
+  TaskHandle_t task_handle;  // Guarded by handle_lock
+  bool retired;              // Guarded by handle_lock
+
+  CancellationToken cancellation;
+  StaticSemaphore_t completion_buffer;
+  SemaphoreHandle_t completion;  // Given when the task finishes
+#if RTOSAID_TASK_STATISTICS
+  TaskInstrumentation instrumentation;
+#endif
+#if RTOSAID_STACK_PROFILING
+  void *profiled_stack;  // Painted stack, or NULL if FreeRTOS allocates it
+  bool profiling_armed;  // Guarded by the profiler; see StackProfiler
+#endif
+
+  /**
+   * Deletes the task, which must be running. Deleting the current
+   * task does not return.
+   */
+  void delete_task(void);
+
 protected:
   BaseTaskWithAction(
       TaskAction *action,
       const char *name,
       const UBaseType_t priority,
-      const size_t stack_size);
+      const size_t stack_size,
+      const BaseType_t core);
 
   inline const char *task_name(void) { return name; }
+  BaseType_t task_core(void) { return core; }
   UBaseType_t task_priority(void) { return priority; }
   size_t task_stack_size(void) { return stack_size; }
+
+  /**
+   * Records the handle of a newly created task unless the task has
+   * already retired. Subclasses must invoke this in start() after they
+   * create the FreeRTOS task.
+   *
+   * Returns: true if the task was created, i.e. task_handle is not NULL.
+   */
   bool set_task_handle(TaskHandle_t task_handle);
 
+  /**
+   * Readies the task to start by withdrawing any prior cancellation
+   * request and completion. Subclasses must invoke this in start()
+   * before they create the FreeRTOS task.
+   *
+   * Parameters:
+   *
+   * Name   Contents
+   * ------ -----------------------------------------------------------------
+   * stack  The stack that the task will run on, or NULL if FreeRTOS
+   *        allocates it. When stack profiling is on, the stack is painted
+   *        so that its usage can be measured. It MUST NOT be in use.
+   */
+  void prepare_to_start(void *stack = NULL);
+
+  /**
+   * Detaches the running task from this instance, withdraws it from
+   * statistics and signals completion to joiners, all without deleting
+   * it. The caller becomes responsible for deleting the task.
+   *
+   * Returns: the detached task's handle, or NULL if no task was running,
+   *          e.g. because it retired itself first.
+   */
+  TaskHandle_t retire_task(void);
+
+  /**
+   * Runs on the task after its action's run() returns, and must not
+   * return. The default implementation deletes the task.
+   */
+  virtual void finish_task(void);
+
   /**
    * Delay (pause) the task for the specified number of milliseconds. The task
    * loop will stop running for the specified time, and resume automatically
-   * afterward.
+   * afterward. Cancelling the task ends the delay early.
    */
   void delay_millis(uint32_t millis);
 
@@ -67,7 +138,8 @@ protected:
 
   /**
    * Runs the task loop in the associated Action. Note that this TaskWithAction
-   * will delete itself if the Action's run() method returns.
+   * will finish itself, by default deleting itself, if the Action's run()
+   * method returns.
    */
   void start_task(void);
 
@@ -85,10 +157,29 @@ protected:
    *
    * Returns the task's notification count before the method was invoked.
    * Note that the method sets the notification count to 0, forcing the
-   * task to wait.
+   * task to wait. Returns 0 immediately if the task has been cancelled.
    */
   uint32_t wait_for_notification(uint32_t millis_to_wait=portMAX_DELAY);
 
+  /**
+   * Suspend the task until some other task or an ISR sets any of the
+   * specified notification bits (see notify_bits()) or until the specified
+   * delay elapses. Bits outside the mask remain pending for a later wait.
+   *
+   * Parameters
+   *
+   * Name            Contents
+   * --------------- ----------------------------------------------------------
+   * mask            The bits to wait for
+   * millis_to_wait  Delay in milliseconds, which defaults to the maximum
+   *                 possible value if omitted. If millis_to_wait is zero,
+   *                 the method will return immediately.
+   *
+   * Returns the bits in mask that were set, which are cleared, or 0 if the
+   * wait timed out or the task has been cancelled.
+   */
+  uint32_t wait_for_bits(uint32_t mask, uint32_t millis_to_wait=portMAX_DELAY);
+
   /**
    * Yield to any higher priority tasks that are ready to run. Note that
    * FreeRTOS implements cooperative multitasking, which means that it
@@ -100,6 +191,41 @@ protected:
 public:
   virtual ~BaseTaskWithAction();
 
+  /**
+   * Asks the task to stop. The request wakes the task if it is waiting in
+   * wait_for_notification(), wait_for_bits(), or delay_millis(). The
+   * task's action is expected to notice the request via cancelled() and
+   * return from run(). Unlike stop(), cancel() lets the action release
+   * its resources. Use join() to wait for the task to finish.
+   */
+  inline void cancel(void) {
+    cancellation.cancel();
+  }
+
+  /**
+   * Returns: the task's cancellation token, which other components can
+   *          share to observe or request cancellation.
+   */
+  inline CancellationToken& cancellation_token(void) {
+    return cancellation;
+  }
+
+  /**
+   * Waits for the task to finish, i.e. for its action's run() to return
+   * or for the task to be stopped. Must not be invoked by the task itself.
+   *
+   * Parameters
+   *
+   * Name            Contents
+   * --------------- ----------------------------------------------------------
+   * millis_to_wait  The maximum time to wait in milliseconds, which defaults
+   *                 to forever.
+   *
+   * Returns: true if the task has finished or was never started, false if
+   *          the wait timed out or if the task tried to join itself.
+   */
+  bool join(uint32_t millis_to_wait=portMAX_DELAY);
+
   /**
    * Notify the task from application code. This will resume the task if it is
    * waiting for a notification. Does nothing if the task has a pending
@@ -113,11 +239,40 @@ public:
    */
   void IRAM_ATTR notify_from_isr();
 
+  /**
+   * Sets the specified bits in the task's notification value, resuming the
+   * task if it is waiting for any of them in wait_for_bits(). Bits that are
+   * already set stay set, so each bit can signal a distinct event source
+   * and no event is lost, though repeated events from the same source
+   * coalesce. This method is only for use by application code. ISR code
+   * must invoke notify_bits_from_isr() instead.
+   *
+   * Note that a task should wait for either notifications or bits, not
+   * both, since notify() and notify_from_isr() also change the
+   * notification value.
+   */
+  void notify_bits(uint32_t bits);
+
+  /**
+   * Sets the specified bits in the task's notification value from an
+   * interrupt service routine (ISR). Application code must invoke
+   * notify_bits() instead.
+   */
+  void IRAM_ATTR notify_bits_from_isr(uint32_t bits);
+
   /**
    * Resumes a suspended task.
    */
   void resume(void);
 
+  /**
+   * Retrieves this task's runtime statistics.
+   *
+   * Returns: true if *snapshot was filled in, false if statistics
+   * are turned off (see RTOSAidConfig.h).
+   */
+  bool statistics(TaskStatistics *snapshot);
+
   /**
    * Starts the task
    *
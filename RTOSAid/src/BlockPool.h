@@ -0,0 +1,170 @@
+/*
+ * BlockPool.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A fixed size pool of N blocks, each large enough to hold a T. Blocks
+ * are allocated and released in constant time without locks, so any
+ * task or interrupt service routine (ISR) can allocate or release a
+ * block at any time. The pool never touches the heap: its storage
+ * resides within the instance.
+ *
+ * Free blocks form a lock-free (Treiber) stack. The stack top packs the
+ * index of the top block with a 16 bit modification tag into a single
+ * 32 bit word that is updated by compare and swap. The tag changes on
+ * every update, which protects against the ABA problem.
+ *
+ * Blocks are handed out uninitialized, so T must be trivially copyable
+ * and trivially destructible. The pool can hold at most 65534 blocks.
+ */
+
+#ifndef SRC_BLOCKPOOL_H_
+#define SRC_BLOCKPOOL_H_
+
+#include "Arduino.h"
+
+#include <atomic>
+#include <type_traits>
+
+template <class T, size_t N> class BlockPool final {
+  static_assert(
+      0 < N && N < 0xFFFF,
+      "BlockPool must hold between 1 and 65534 blocks.");
+  static_assert(
+      std::is_trivially_copyable<T>::value
+          && std::is_trivially_destructible<T>::value,
+      "BlockPool blocks must be trivially copyable and destructible.");
+
+  // Links and the stack top hold block index + 1 so that 0 can mark the
+  // end of the free list.
+  static const uint32_t LINK_MASK = 0xFFFF;
+  static const uint32_t TAG_INCREMENT = 0x10000;
+
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type blocks[N];
+  std::atomic<uint16_t> next_free[N];
+  std::atomic<uint32_t> free_top;
+  std::atomic<uint32_t> free_count;
+
+  BlockPool(const BlockPool&) = delete;
+  BlockPool(BlockPool&&) = delete;
+  BlockPool& operator=(const BlockPool&) = delete;
+  BlockPool& operator=(BlockPool&&) = delete;
+
+public:
+  BlockPool(void) :
+      free_top(1),
+      free_count(N) {
+    for (size_t i = 0; i < N; ++i) {
+      next_free[i].store(
+          i + 1 < N ? static_cast<uint16_t>(i + 2) : 0,
+          std::memory_order_relaxed);
+    }
+  }
+
+  ~BlockPool() {}
+
+  /**
+   * Allocates a block. Safe to invoke from any task or ISR. The block's
+   * contents are unspecified.
+   *
+   * Returns: the allocated block or NULL if the pool is exhausted.
+   */
+  T *allocate(void) {
+    uint32_t top = free_top.load(std::memory_order_acquire);
+    for (;;) {
+      uint32_t link = top & LINK_MASK;
+      if (!link) {
+        return NULL;
+      }
+      uint32_t replacement =
+          ((top & ~LINK_MASK) + TAG_INCREMENT)
+          | next_free[link - 1].load(std::memory_order_relaxed);
+      if (free_top.compare_exchange_weak(
+          top,
+          replacement,
+          std::memory_order_acq_rel,
+          std::memory_order_acquire)) {
+        free_count.fetch_sub(1, std::memory_order_relaxed);
+        return reinterpret_cast<T *>(&blocks[link - 1]);
+      }
+    }
+  }
+
+  /**
+   * Returns: the number of unallocated blocks. The value is a snapshot
+   *          and may be stale.
+   */
+  size_t available(void) const {
+    return free_count.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns: the number of blocks in the pool.
+   */
+  static constexpr size_t capacity(void) {
+    return N;
+  }
+
+  /**
+   * Returns: the index of a block allocated from this pool, a value in
+   *          [0 .. N), which callers can use to keep per-block data in
+   *          their own arrays.
+   */
+  size_t index_of(const T *block) const {
+    return reinterpret_cast<const typename std::aligned_storage<
+        sizeof(T), alignof(T)>::type *>(block) - blocks;
+  }
+
+  /**
+   * Returns: true if and only if block was allocated from this pool.
+   */
+  bool owns(const T *block) const {
+    const uint8_t *address = reinterpret_cast<const uint8_t *>(block);
+    const uint8_t *first = reinterpret_cast<const uint8_t *>(&blocks[0]);
+    return first <= address
+        && address < reinterpret_cast<const uint8_t *>(&blocks[N])
+        && (address - first) % sizeof(blocks[0]) == 0;
+  }
+
+  /**
+   * Returns a block to the pool. Safe to invoke from any task or ISR.
+   * The block MUST have been allocated from this pool and MUST NOT be
+   * used after it is released. Releasing NULL does nothing.
+   */
+  void release(T *block) {
+    if (!block) {
+      return;
+    }
+    uint32_t link = static_cast<uint32_t>(index_of(block)) + 1;
+    uint32_t top = free_top.load(std::memory_order_relaxed);
+    do {
+      next_free[link - 1].store(
+          static_cast<uint16_t>(top & LINK_MASK),
+          std::memory_order_relaxed);
+    } while (!free_top.compare_exchange_weak(
+        top,
+        ((top & ~LINK_MASK) + TAG_INCREMENT) | link,
+        std::memory_order_release,
+        std::memory_order_relaxed));
+    free_count.fetch_add(1, std::memory_order_relaxed);
+  }
+};
+
+#endif /* SRC_BLOCKPOOL_H_ */
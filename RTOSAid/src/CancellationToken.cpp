@@ -0,0 +1,70 @@
+/*
+ * CancellationToken.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "CancellationToken.h"
+
+CancellationToken::CancellationToken(void) :
+    requested(false),
+    lock(portMUX_INITIALIZER_UNLOCKED),
+    task(NULL) {
+}
+
+void CancellationToken::bind(TaskHandle_t task) {
+  portENTER_CRITICAL(&lock);
+  this->task = task;
+  portEXIT_CRITICAL(&lock);
+}
+
+void CancellationToken::cancel(void) {
+  requested.store(true);
+  // Notify with the ISR variant, which never switches tasks, so that the
+  // critical section stays short. Yield afterward if needed.
+  BaseType_t higher_priority_task_woken = pdFALSE;
+  portENTER_CRITICAL(&lock);
+  if (task) {
+    xTaskNotifyFromISR(
+        task, CANCEL_BIT, eSetBits, &higher_priority_task_woken);
+  }
+  portEXIT_CRITICAL(&lock);
+  if (higher_priority_task_woken) {
+    taskYIELD();
+  }
+}
+
+void CancellationToken::cancel_from_isr(void) {
+  requested.store(true);
+  BaseType_t higher_priority_task_woken = pdFALSE;
+  portENTER_CRITICAL_ISR(&lock);
+  if (task) {
+    xTaskNotifyFromISR(
+        task, CANCEL_BIT, eSetBits, &higher_priority_task_woken);
+  }
+  portEXIT_CRITICAL_ISR(&lock);
+  if (higher_priority_task_woken) {
+    portYIELD_FROM_ISR();
+  }
+}
+
+void CancellationToken::reset(void) {
+  requested.store(false);
+}
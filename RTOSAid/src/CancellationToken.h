@@ -0,0 +1,99 @@
+/*
+ * CancellationToken.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Cooperative cancellation for tasks. Every BaseTaskWithAction owns a
+ * token. Invoking cancel() marks the token and sets CANCEL_BIT in the
+ * bound task's notification value, which wakes the task from
+ * wait_for_notification(), wait_for_bits(), and delay_millis(). The
+ * task's action observes the request via cancelled() and returns from
+ * run(), which completes the task and releases anyone waiting in join().
+ *
+ * Waits outside RTOSAid, e.g. in device drivers, cannot be interrupted,
+ * so actions that use them should wait with a timeout and check
+ * cancelled() in between.
+ *
+ * The bound task is read and notified under a spinlock that bind() also
+ * takes. BaseTaskWithAction unbinds the token before it deletes its
+ * task, so cancel() never notifies a deleted task.
+ */
+
+#ifndef SRC_CANCELLATIONTOKEN_H_
+#define SRC_CANCELLATIONTOKEN_H_
+
+#include "Arduino.h"
+
+#include <atomic>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+class CancellationToken final {
+  std::atomic<bool> requested;
+  portMUX_TYPE lock;
+  TaskHandle_t task;  // Guarded by lock
+
+  CancellationToken(const CancellationToken&) = delete;
+  CancellationToken& operator=(const CancellationToken&) = delete;
+
+public:
+  /**
+   * The notification bit that cancel() sets in the bound task's
+   * notification value. Applications must not use it.
+   */
+  static const uint32_t CANCEL_BIT = 1UL << 30;
+
+  CancellationToken(void);
+
+  /**
+   * Binds the token to the task that it wakes on cancellation, or
+   * unbinds it if task is NULL. BaseTaskWithAction does this when its
+   * task starts and before it deletes it. Waits for any cancel() that is
+   * notifying the previously bound task.
+   */
+  void bind(TaskHandle_t task);
+
+  /**
+   * Requests cancellation and wakes the bound task, if any. Idempotent.
+   * Only for use by application code. ISRs must invoke cancel_from_isr().
+   */
+  void cancel(void);
+
+  /**
+   * Requests cancellation from an interrupt service routine (ISR).
+   */
+  void IRAM_ATTR cancel_from_isr(void);
+
+  /**
+   * Returns: true if cancellation has been requested, false otherwise.
+   */
+  inline bool cancelled(void) const {
+    return requested.load();
+  }
+
+  /**
+   * Withdraws any cancellation request so that the token can be reused.
+   * BaseTaskWithAction does this before its task starts.
+   */
+  void reset(void);
+};
+
+#endif /* SRC_CANCELLATIONTOKEN_H_ */
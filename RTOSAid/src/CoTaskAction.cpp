@@ -0,0 +1,230 @@
+/*
+ * CoTaskAction.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "CoTaskAction.h"
+
+#if RTOSAID_COROUTINES
+
+CoTaskAction::CoTaskAction(void) :
+    spawn_lock(portMUX_INITIALIZER_UNLOCKED),
+    spawned(nullptr),
+    ready_first(nullptr),
+    ready_last(nullptr),
+    waiting(nullptr),
+    pending_bits(0),
+    coroutines(0),
+    running(false) {
+}
+
+CoTaskAction::~CoTaskAction() {
+  destroy_all(spawned);
+  destroy_all(ready_first);
+  destroy_all(waiting);
+}
+
+void CoTaskAction::accept_spawned(void) {
+  portENTER_CRITICAL(&spawn_lock);
+  CoTaskPromise *first = spawned;
+  spawned = nullptr;
+  portEXIT_CRITICAL(&spawn_lock);
+
+  // The spawned list is last in, first out. Reverse it so that coroutines
+  // first run in the order in which they were spawned.
+  CoTaskPromise *reversed = nullptr;
+  while (first) {
+    CoTaskPromise *next = first->next;
+    first->next = reversed;
+    reversed = first;
+    first = next;
+  }
+  while (reversed) {
+    CoTaskPromise *next = reversed->next;
+    append_ready(reversed);
+    reversed = next;
+  }
+}
+
+void CoTaskAction::append_ready(CoTaskPromise *promise) {
+  promise->wait_kind = CoWaitKind::NOTHING;
+  promise->next = nullptr;
+  if (ready_last) {
+    ready_last->next = promise;
+  } else {
+    ready_first = promise;
+  }
+  ready_last = promise;
+}
+
+TickType_t CoTaskAction::block_ticks(void) {
+  TickType_t result = portMAX_DELAY;
+  TickType_t now = xTaskGetTickCount();
+  for (CoTaskPromise *promise = waiting; promise; promise = promise->next) {
+    if (promise->wait_ticks != portMAX_DELAY) {
+      TickType_t elapsed = now - promise->wait_started_at;
+      TickType_t remaining = elapsed < promise->wait_ticks
+          ? promise->wait_ticks - elapsed
+          : 0;
+      if (remaining < result) {
+        result = remaining;
+      }
+    }
+  }
+  return result;
+}
+
+void CoTaskAction::collect_bits(TickType_t timeout) {
+  uint32_t bits = 0;
+  if (xTaskNotifyWait(0, UINT32_MAX, &bits, timeout) == pdTRUE) {
+    pending_bits |= bits & ~(CO_WAKE_BIT | CancellationToken::CANCEL_BIT);
+  }
+}
+
+size_t CoTaskAction::coroutine_count(void) {
+  portENTER_CRITICAL(&spawn_lock);
+  size_t result = coroutines;
+  portEXIT_CRITICAL(&spawn_lock);
+  return result;
+}
+
+void CoTaskAction::destroy_all(CoTaskPromise *first) {
+  while (first) {
+    CoTaskPromise *next = first->next;
+    CoTaskHandle::from_promise(*first).destroy();
+    first = next;
+  }
+}
+
+bool CoTaskAction::is_satisfied(CoTaskPromise *promise, TickType_t now) {
+  bool satisfied = false;
+  switch (promise->wait_kind) {
+  case CoWaitKind::NOTHING:
+  case CoWaitKind::DELAY:
+    break;
+  case CoWaitKind::BITS:
+    promise->received = pending_bits & promise->mask;
+    pending_bits &= ~promise->received;
+    satisfied = promise->received;
+    break;
+  case CoWaitKind::POLL:
+    satisfied = promise->poll(promise->poll_context);
+    break;
+  case CoWaitKind::FLAG:
+    satisfied = promise->flag->exchange(false);
+    break;
+  }
+  if (!satisfied
+      && promise->wait_ticks != portMAX_DELAY
+      && promise->wait_ticks <= now - promise->wait_started_at) {
+    satisfied = true;
+    promise->timed_out = promise->wait_kind != CoWaitKind::DELAY;
+  }
+  return satisfied;
+}
+
+void CoTaskAction::make_ready(void) {
+  TickType_t now = xTaskGetTickCount();
+  CoTaskPromise **link = &waiting;
+  while (*link) {
+    CoTaskPromise *promise = *link;
+    if (is_satisfied(promise, now)) {
+      *link = promise->next;
+      append_ready(promise);
+    } else {
+      link = &promise->next;
+    }
+  }
+}
+
+void CoTaskAction::resume_ready(void) {
+  // Coroutines that yield are appended to the ready list, so only resume
+  // the ones that were ready when the cycle started.
+  CoTaskPromise *promise = ready_first;
+  ready_first = nullptr;
+  ready_last = nullptr;
+  while (promise) {
+    CoTaskPromise *next = promise->next;
+    CoTaskHandle handle = CoTaskHandle::from_promise(*promise);
+    handle.resume();
+    if (handle.done()) {
+      handle.destroy();
+      portENTER_CRITICAL(&spawn_lock);
+      --coroutines;
+      portEXIT_CRITICAL(&spawn_lock);
+    }
+    promise = next;
+  }
+}
+
+void CoTaskAction::run(void) {
+  running.store(true);
+  while (!cancelled()) {
+    accept_spawned();
+    collect_bits(0);
+    make_ready();
+    if (ready_first) {
+      resume_ready();
+    } else {
+      collect_bits(block_ticks());
+    }
+  }
+  running.store(false);
+}
+
+bool CoTaskAction::spawn(CoTask&& task) {
+  if (!task.valid()) {
+    return false;
+  }
+  CoTaskPromise *promise = &task.handle.promise();
+  task.handle = nullptr;
+  promise->scheduler = this;
+  portENTER_CRITICAL(&spawn_lock);
+  promise->next = spawned;
+  spawned = promise;
+  ++coroutines;
+  portEXIT_CRITICAL(&spawn_lock);
+  wake();
+  return true;
+}
+
+void CoTaskAction::suspend(CoTaskPromise *promise) {
+  if (promise->wait_kind == CoWaitKind::NOTHING) {
+    append_ready(promise);
+  } else {
+    promise->next = waiting;
+    waiting = promise;
+  }
+}
+
+void CoTaskAction::wake(void) {
+  if (running.load()) {
+    notify_bits(CO_WAKE_BIT);
+  }
+}
+
+void CoTaskAction::wake_from_isr(void) {
+  if (running.load()) {
+    notify_bits_from_isr(CO_WAKE_BIT);
+  }
+}
+
+#endif /* RTOSAID_COROUTINES */
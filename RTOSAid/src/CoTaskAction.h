@@ -0,0 +1,531 @@
+/*
+ * CoTaskAction.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Stackless C++20 coroutines that share a single FreeRTOS task. Every
+ * TaskWithAction needs a stack of its own, typically 2 to 8 KB. A
+ * coroutine's state lives in a heap allocated frame that is usually a
+ * few hundred bytes, so a CoTaskAction can run many lightweight
+ * activities on one task and one stack.
+ *
+ * A coroutine is a function that returns CoTask and uses co_await to wait.
+ * Coroutines can wait for:
+ *
+ * * a delay:                   co_await CoDelay(100);
+ * * task notification bits:    uint32_t bits = co_await CoBits(0x3);
+ * * a message from a queue:    bool ok = co_await CoReceive(queue, &msg);
+ * * a CoTimer to expire:       co_await timer.expiry(500);
+ * * the next scheduler cycle:  co_await CoYield();
+ *
+ * Waits for bits and queue messages accept an optional timeout in
+ * milliseconds. Coroutines run cooperatively: a coroutine runs until it
+ * awaits or returns, so it MUST NOT block the task, e.g. by calling
+ * delay() or pulling from a queue with a timeout.
+ *
+ * Typical use:
+ *
+ *   CoTask blink(uint8_t pin, uint32_t half_period_ms) {
+ *     for (;;) {
+ *       digitalWrite(pin, HIGH);
+ *       co_await CoDelay(half_period_ms);
+ *       digitalWrite(pin, LOW);
+ *       co_await CoDelay(half_period_ms);
+ *     }
+ *   }
+ *
+ *   static CoTaskAction scheduler;
+ *   static TaskWithActionH scheduler_task("Coroutines", 2, &scheduler, 4096);
+ *
+ *   void setup() {
+ *     scheduler.spawn(blink(RED_LED, 500));
+ *     scheduler.spawn(blink(GREEN_LED, 333));
+ *     scheduler_task.start();
+ *   }
+ *
+ * Other tasks and ISRs send bits to coroutines by invoking notify_bits()
+ * or notify_bits_from_isr() on the scheduler's task. Bit 31,
+ * CO_WAKE_BIT, is reserved for the scheduler, and bit 30 for
+ * cancellation.
+ *
+ * A coroutine that awaits a queue names the scheduler's task as the
+ * queue's send notification (see set_send_notification()), so each send
+ * wakes the scheduler, which otherwise sleeps until the earliest
+ * timeout. A queue notifies only one task, so await a queue from one
+ * scheduler only, and do not give it a send notification of your own.
+ * The queue keeps notifying the scheduler's task after the wait ends,
+ * which costs a spurious wakeup per message. If the queue outlives that
+ * task, stop the notifications first: set_send_notification(NULL, 0).
+ *
+ * Coroutines require C++20. On toolchains without coroutine support,
+ * this header declares nothing and RTOSAID_COROUTINES is 0.
+ */
+
+#ifndef SRC_COTASKACTION_H_
+#define SRC_COTASKACTION_H_
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define RTOSAID_COROUTINES 1
+#else
+#define RTOSAID_COROUTINES 0
+#endif
+
+#if RTOSAID_COROUTINES
+
+#include "Arduino.h"
+
+#include "TaskAction.h"
+
+#include <atomic>
+#include <coroutine>
+#include <new>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+class CoTask;
+class CoTaskAction;
+
+/**
+ * Notification bit reserved for waking the scheduler.
+ */
+static const uint32_t CO_WAKE_BIT = 1UL << 31;
+
+/**
+ * What a suspended coroutine is waiting for.
+ */
+enum class CoWaitKind : uint8_t {
+  NOTHING,  // Ready to run
+  DELAY,    // Time to pass
+  BITS,     // Notification bits
+  POLL,     // A poll function, e.g. a queue pull, to succeed. Polled
+            // each time the scheduler wakes.
+  FLAG,     // A flag, e.g. timer expiry, to be set
+};
+
+/**
+ * Coroutine state that the scheduler maintains. Application code does
+ * not use this class directly.
+ */
+class CoTaskPromise final {
+  friend class CoTaskAction;
+  friend class CoAwaiter;
+
+  CoTaskAction *scheduler;
+  CoTaskPromise *next;
+  CoWaitKind wait_kind;
+  TickType_t wait_started_at;
+  TickType_t wait_ticks;
+  uint32_t mask;
+  uint32_t received;
+  bool (*poll)(void *context);
+  void *poll_context;
+  std::atomic<bool> *flag;
+  bool timed_out;
+
+public:
+  CoTaskPromise(void) :
+      scheduler(nullptr),
+      next(nullptr),
+      wait_kind(CoWaitKind::NOTHING),
+      wait_started_at(0),
+      wait_ticks(portMAX_DELAY),
+      mask(0),
+      received(0),
+      poll(nullptr),
+      poll_context(nullptr),
+      flag(nullptr),
+      timed_out(false) {
+  }
+
+  /**
+   * Allocates coroutine frames without throwing, so that a failed
+   * allocation yields an invalid CoTask instead of an exception.
+   */
+  static void *operator new(size_t size) noexcept {
+    return ::operator new(size, std::nothrow);
+  }
+
+  static void operator delete(void *frame) noexcept {
+    ::operator delete(frame);
+  }
+
+  static CoTask get_return_object_on_allocation_failure(void);
+
+  CoTask get_return_object(void);
+
+  // Coroutines start suspended and run when the scheduler resumes them.
+  std::suspend_always initial_suspend(void) noexcept {
+    return {};
+  }
+
+  // Finished coroutines stay suspended until the scheduler destroys them.
+  std::suspend_always final_suspend(void) noexcept {
+    return {};
+  }
+
+  void return_void(void) {
+  }
+
+  void unhandled_exception(void) {
+    abort();
+  }
+};
+
+typedef std::coroutine_handle<CoTaskPromise> CoTaskHandle;
+
+/**
+ * The return type of coroutines that a CoTaskAction runs. A CoTask owns
+ * its coroutine until it is passed to CoTaskAction::spawn().
+ */
+class CoTask final {
+  friend class CoTaskAction;
+  friend class CoTaskPromise;
+
+  CoTaskHandle handle;
+
+  explicit CoTask(CoTaskHandle handle) :
+      handle(handle) {
+  }
+
+public:
+  typedef CoTaskPromise promise_type;
+
+  CoTask(CoTask&& other) noexcept :
+      handle(other.handle) {
+    other.handle = nullptr;
+  }
+
+  CoTask(const CoTask&) = delete;
+  CoTask& operator=(const CoTask&) = delete;
+
+  ~CoTask() {
+    if (handle) {
+      handle.destroy();
+    }
+  }
+
+  /**
+   * Returns: true if the coroutine frame was allocated, false otherwise.
+   */
+  inline bool valid(void) const {
+    return static_cast<bool>(handle);
+  }
+};
+
+inline CoTask CoTaskPromise::get_return_object_on_allocation_failure(void) {
+  return CoTask(nullptr);
+}
+
+inline CoTask CoTaskPromise::get_return_object(void) {
+  return CoTask(CoTaskHandle::from_promise(*this));
+}
+
+/**
+ * Runs coroutines on its containing task. Spawn coroutines before or
+ * after starting the task.
+ */
+class CoTaskAction final : public TaskAction {
+  friend class CoAwaiter;
+
+  portMUX_TYPE spawn_lock;
+  CoTaskPromise *spawned;
+  CoTaskPromise *ready_first;
+  CoTaskPromise *ready_last;
+  CoTaskPromise *waiting;
+  uint32_t pending_bits;
+  size_t coroutines;
+  std::atomic<bool> running;
+
+  void append_ready(CoTaskPromise *promise);
+  void accept_spawned(void);
+  TickType_t block_ticks(void);
+  void collect_bits(TickType_t timeout);
+  static void destroy_all(CoTaskPromise *first);
+  bool is_satisfied(CoTaskPromise *promise, TickType_t now);
+  void make_ready(void);
+  void resume_ready(void);
+
+  /**
+   * Parks a coroutine that has just suspended. Awaiters invoke this.
+   */
+  void suspend(CoTaskPromise *promise);
+
+public:
+  CoTaskAction(void);
+
+  /**
+   * Destroys all coroutines. The containing task must be stopped first.
+   */
+  virtual ~CoTaskAction();
+
+  /**
+   * Returns: the number of coroutines that have not finished.
+   */
+  size_t coroutine_count(void);
+
+  /**
+   * Runs the coroutines until the containing task is cancelled.
+   * Coroutines that have not finished stay suspended and are destroyed
+   * with the action.
+   */
+  virtual void run(void);
+
+  /**
+   * Takes ownership of a coroutine and schedules it to run. Safe to
+   * invoke from any task, but not from an ISR.
+   *
+   * Returns: true if the coroutine was scheduled, false if the task is
+   *          not valid, e.g. because its frame could not be allocated.
+   */
+  bool spawn(CoTask&& task);
+
+  /**
+   * Wakes the scheduler so that it rechecks its coroutines' wait
+   * conditions. Does nothing if the scheduler is not running. Safe to
+   * invoke from any task. ISRs must invoke wake_from_isr() instead.
+   */
+  void wake(void);
+
+  /**
+   * ISR counterpart of wake().
+   */
+  void IRAM_ATTR wake_from_isr(void);
+};
+
+/**
+ * Base class for the awaitables. Records the wait condition in the
+ * awaiting coroutine's promise and hands the coroutine to its scheduler.
+ */
+class CoAwaiter {
+protected:
+  CoTaskPromise *promise;
+  const CoWaitKind kind;
+  const TickType_t ticks;
+
+  CoAwaiter(CoWaitKind kind, TickType_t ticks) :
+      promise(nullptr),
+      kind(kind),
+      ticks(ticks) {
+  }
+
+  /**
+   * Prepares the promise's wait condition. Subclasses record their own
+   * condition after invoking this.
+   */
+  inline void prepare(CoTaskHandle handle) {
+    promise = &handle.promise();
+    promise->wait_kind = kind;
+    promise->wait_started_at = xTaskGetTickCount();
+    promise->wait_ticks = ticks;
+    promise->timed_out = false;
+  }
+
+  inline void park(void) {
+    promise->scheduler->suspend(promise);
+  }
+
+  inline void await_bits(uint32_t mask) {
+    promise->mask = mask;
+    promise->received = 0;
+  }
+
+  inline void await_flag(std::atomic<bool> *flag) {
+    promise->flag = flag;
+  }
+
+  inline void await_poll(bool (*poll)(void *context), void *context) {
+    promise->poll = poll;
+    promise->poll_context = context;
+  }
+
+  /**
+   * Asks a queue to wake the coroutine's scheduler whenever a message is
+   * sent to it.
+   */
+  template <class Queue> static inline void wake_on_send(
+      CoTaskHandle handle, Queue& queue) {
+    queue.set_send_notification(
+        handle.promise().scheduler->owning_task(), CO_WAKE_BIT);
+  }
+
+  inline uint32_t received_bits(void) const {
+    return promise->received;
+  }
+
+  inline bool timed_out(void) const {
+    return promise->timed_out;
+  }
+
+  inline uint32_t take_bits(CoTaskHandle handle, uint32_t mask) {
+    CoTaskAction *scheduler = handle.promise().scheduler;
+    uint32_t result = scheduler->pending_bits & mask;
+    scheduler->pending_bits &= ~result;
+    return result;
+  }
+
+public:
+  bool await_ready(void) const noexcept {
+    return false;
+  }
+};
+
+/**
+ * Suspends the coroutine until the next scheduler cycle, letting the
+ * other ready coroutines run.
+ */
+class CoYield final : public CoAwaiter {
+public:
+  CoYield(void) :
+      CoAwaiter(CoWaitKind::NOTHING, 0) {
+  }
+
+  void await_suspend(CoTaskHandle handle) {
+    prepare(handle);
+    park();
+  }
+
+  void await_resume(void) const noexcept {
+  }
+};
+
+/**
+ * Suspends the coroutine for the specified number of milliseconds.
+ */
+class CoDelay final : public CoAwaiter {
+public:
+  CoDelay(uint32_t millis) :
+      CoAwaiter(CoWaitKind::DELAY, pdMS_TO_TICKS(millis)) {
+  }
+
+  void await_suspend(CoTaskHandle handle) {
+    prepare(handle);
+    park();
+  }
+
+  void await_resume(void) const noexcept {
+  }
+};
+
+/**
+ * Suspends the coroutine until any of the specified notification bits
+ * arrives or until the timeout elapses. Resumes with the bits received,
+ * which are cleared, or 0 on timeout.
+ */
+class CoBits final : public CoAwaiter {
+  const uint32_t mask;
+  uint32_t received;
+
+public:
+  CoBits(uint32_t mask, uint32_t millis = portMAX_DELAY) :
+      CoAwaiter(
+          CoWaitKind::BITS,
+          millis == portMAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(millis)),
+      mask(mask & ~(CO_WAKE_BIT | CancellationToken::CANCEL_BIT)),
+      received(0) {
+  }
+
+  bool await_suspend(CoTaskHandle handle) {
+    received = take_bits(handle, mask);
+    if (received) {
+      return false;
+    }
+    prepare(handle);
+    await_bits(mask);
+    park();
+    return true;
+  }
+
+  uint32_t await_resume(void) const noexcept {
+    return promise ? received_bits() : received;
+  }
+};
+
+/**
+ * Suspends the coroutine until a message arrives in a queue, e.g. a
+ * PullQueueT or PullQueueHT, or until the timeout elapses. Resumes with
+ * true if a message was pulled, false on timeout.
+ */
+template <class Queue, class T> class CoReceive final : public CoAwaiter {
+  Queue& queue;
+  T *message;
+
+  static bool poll(void *context) {
+    CoReceive *self = static_cast<CoReceive *>(context);
+    return self->queue.pull_message(self->message, 0);
+  }
+
+public:
+  CoReceive(Queue& queue, T *message, uint32_t millis = portMAX_DELAY) :
+      CoAwaiter(
+          CoWaitKind::POLL,
+          millis == portMAX_DELAY ? portMAX_DELAY : pdMS_TO_TICKS(millis)),
+      queue(queue),
+      message(message) {
+  }
+
+  bool await_suspend(CoTaskHandle handle) {
+    // Ask for the wakeup before the last look, so that a message sent
+    // after the look still wakes the scheduler.
+    wake_on_send(handle, queue);
+    if (queue.pull_message(message, 0)) {
+      return false;
+    }
+    prepare(handle);
+    await_poll(poll, this);
+    park();
+    return true;
+  }
+
+  bool await_resume(void) const noexcept {
+    return !promise || !timed_out();
+  }
+};
+
+/**
+ * Suspends the coroutine until another party sets a flag. CoTimer uses
+ * this to await expiry.
+ */
+class CoFlag final : public CoAwaiter {
+  std::atomic<bool>& flag;
+
+public:
+  CoFlag(std::atomic<bool>& flag) :
+      CoAwaiter(CoWaitKind::FLAG, portMAX_DELAY),
+      flag(flag) {
+  }
+
+  bool await_suspend(CoTaskHandle handle) {
+    if (flag.exchange(false)) {
+      return false;
+    }
+    prepare(handle);
+    await_flag(&flag);
+    park();
+    return true;
+  }
+
+  void await_resume(void) const noexcept {
+  }
+};
+
+#endif /* RTOSAID_COROUTINES */
+
+#endif /* SRC_COTASKACTION_H_ */
@@ -0,0 +1,65 @@
+/*
+ * CoTimer.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "CoTimer.h"
+
+#if RTOSAID_COROUTINES
+
+CoTimerExpiryFunction::CoTimerExpiryFunction(CoTimer& timer) :
+    timer(timer) {
+}
+
+CoTimerExpiryFunction::~CoTimerExpiryFunction() {
+}
+
+void CoTimerExpiryFunction::apply(void) {
+  timer.expired.store(true);
+  timer.scheduler.wake();
+}
+
+CoTimer::CoTimer(const char *name, CoTaskAction& scheduler) :
+    scheduler(scheduler),
+    expired(false),
+    expiry_function(*this),
+    timer(name, &expiry_function) {
+}
+
+CoTimer::~CoTimer() {
+}
+
+bool CoTimer::begin(void) {
+  return timer.begin();
+}
+
+CoFlag CoTimer::expiry(uint64_t micros) {
+  expired.store(false);
+  timer.start(micros);
+  return CoFlag(expired);
+}
+
+void CoTimer::stop(void) {
+  timer.stop();
+  expired.store(false);
+}
+
+#endif /* RTOSAID_COROUTINES */
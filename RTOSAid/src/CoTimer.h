@@ -0,0 +1,118 @@
+/*
+ * CoTimer.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A MicrosecondTimer whose expiry a coroutine can await. The timer fires
+ * in the ESP timer task, sets a flag, and wakes the CoTaskAction that
+ * runs the coroutine.
+ *
+ *   static CoTimer sample_timer("Sample", scheduler);
+ *
+ *   CoTask sample(void) {
+ *     for (;;) {
+ *       co_await sample_timer.expiry(250);  // 250 microseconds
+ *       take_sample();
+ *     }
+ *   }
+ *
+ * Invoke begin() before awaiting expiry. Only one coroutine may await a
+ * given CoTimer at a time.
+ */
+
+#ifndef SRC_COTIMER_H_
+#define SRC_COTIMER_H_
+
+#include "CoTaskAction.h"
+
+#if RTOSAID_COROUTINES
+
+#include "MicrosecondTimer.h"
+#include "VoidFunction.h"
+
+#include <atomic>
+
+class CoTimer;
+
+/**
+ * Marks the timer expired and wakes the scheduler. Internal use only.
+ */
+class CoTimerExpiryFunction final : public VoidFunction {
+  CoTimer& timer;
+
+public:
+  CoTimerExpiryFunction(CoTimer& timer);
+  virtual ~CoTimerExpiryFunction();
+
+  virtual void apply(void);
+};
+
+class CoTimer final {
+  friend class CoTimerExpiryFunction;
+
+  CoTaskAction& scheduler;
+  std::atomic<bool> expired;
+  CoTimerExpiryFunction expiry_function;
+  MicrosecondTimer timer;
+
+public:
+  /**
+   * Constructor
+   *
+   * Parameters:
+   *
+   * Name       Contents
+   * ---------- --------------------------------------------------------------
+   * name       Timer name, for display in debug and error messages
+   * scheduler  Runs the coroutines that await this timer
+   */
+  CoTimer(const char *name, CoTaskAction& scheduler);
+  ~CoTimer();
+
+  /**
+   * Creates the underlying MicrosecondTimer. Invoke exactly once.
+   *
+   * Returns: true if the timer was created, false otherwise.
+   */
+  bool begin(void);
+
+  /**
+   * Starts the timer and returns an awaitable that resumes the awaiting
+   * coroutine when the timer expires. If the timer is running, it is
+   * restarted.
+   *
+   * Parameters:
+   *
+   * Name    Contents
+   * ------- -----------------------------------------------------------------
+   * micros  Time until expiry in microseconds
+   */
+  CoFlag expiry(uint64_t micros);
+
+  /**
+   * Stops the timer. A coroutine awaiting expiry stays suspended until
+   * the timer is started again and expires.
+   */
+  void stop(void);
+};
+
+#endif /* RTOSAID_COROUTINES */
+
+#endif /* SRC_COTIMER_H_ */
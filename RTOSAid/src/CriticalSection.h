@@ -0,0 +1,98 @@
+/*
+ * CriticalSection.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Holds a SpinLock for the guard's lifetime. Construction always
+ * succeeds, so there is no succeeded() method. Works in tasks and in
+ * interrupt service routines.
+ *
+ * As with MutexLock, instances MUST be automatic variables. They cannot
+ * be created via new, declared as class fields, or inherited from.
+ *
+ * Note that including CriticalSection.h also includes SpinLock.h.
+ */
+
+#ifndef SRC_CRITICALSECTION_H_
+#define SRC_CRITICALSECTION_H_
+
+#include "Arduino.h"
+
+#include "SpinLock.h"
+
+#include <new>
+
+class CriticalSection final {
+  SpinLock& spin_lock;
+
+  /**
+   * Copy construction makes no sense in the class, so we
+   * hide same.
+   */
+  CriticalSection(CriticalSection *) = delete;
+  CriticalSection(const CriticalSection *) = delete;
+  CriticalSection(CriticalSection&) = delete;
+  CriticalSection(const CriticalSection&) = delete;
+  CriticalSection(CriticalSection&&) = delete;
+  CriticalSection(const CriticalSection&&) = delete;
+  CriticalSection& operator=(CriticalSection&) = delete;
+  CriticalSection& operator=(const CriticalSection&) = delete;
+
+  /**
+   * Hiding the new and delete operators prevents allocation on the heap.
+   */
+  void* operator new  (std::size_t count) { return NULL; }
+  void* operator new[](std::size_t count) { return NULL; }
+  void* operator new  (
+      std::size_t count, const std::nothrow_t& tag) { return NULL; }
+  void* operator new[](
+      std::size_t count, const std::nothrow_t& tag) { return NULL; }
+
+  void operator delete  (void* ptr) {}
+  void operator delete[](void* ptr) {}
+  void operator delete  (void* ptr, const std::nothrow_t& tag) {}
+  void operator delete[](void* ptr, const std::nothrow_t& tag) {}
+  void operator delete  (void* ptr, std::size_t sz) {}
+  void operator delete[](void* ptr, std::size_t sz) {}
+
+public:
+  /**
+   * Takes the specified SpinLock, spinning until it is available.
+   *
+   * Parameters:
+   *
+   * Name      Contents
+   * --------- ----------------------------------------------------------------
+   * spin_lock The SpinLock to take
+   */
+  inline CriticalSection(SpinLock& spin_lock) :
+      spin_lock(spin_lock) {
+    spin_lock.lock();
+  }
+
+  /**
+   * Releases the SpinLock.
+   */
+  inline ~CriticalSection() {
+    spin_lock.unlock();
+  }
+};
+
+#endif /* SRC_CRITICALSECTION_H_ */
@@ -0,0 +1,334 @@
+/*
+ * EventBusT.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A typed publish/subscribe event bus. Producers publish each message once.
+ * Every subscriber, whether a queue (EventQueueSubscriberT) or a callback
+ * (EventCallbackSubscriberT), receives a pointer to the same message. No
+ * payload is copied on fan-out.
+ *
+ * Messages live in blocks drawn from an embedded BlockPool and are
+ * reference counted. Publishing takes one reference per subscriber. A
+ * subscriber drops its reference when it finishes with a message, or when
+ * its overflow policy discards it, and the block returns to the pool when
+ * the last reference is dropped.
+ *
+ * Each queue subscriber has its own overflow policy and counts the
+ * messages delivered to it and the messages it dropped.
+ *
+ * Typical use:
+ *
+ *   static EventBusT<Reading, 8> readings;
+ *   static EventQueueSubscriberT<Reading, 4> logger(
+ *       EventOverflowPolicy::DROP_OLDEST);
+ *   static EventCallbackSubscriberT<Reading> alarm(alarm_check);
+ *
+ *   void setup() {
+ *     logger.begin();
+ *     readings.subscribe(&logger);
+ *     readings.subscribe(&alarm);
+ *     ...
+ *   }
+ *
+ *   // Producer
+ *   Reading *reading = readings.allocate();
+ *   if (reading) {
+ *     ... fill in *reading ...
+ *     readings.publish(reading);
+ *   }
+ *
+ *   // Logger task
+ *   const Reading *reading;
+ *   if (logger.pull_message(&reading)) {
+ *     ... use *reading ...
+ *     logger.release(reading);
+ *   }
+ *
+ * Subscribers must subscribe before the first message is published,
+ * typically in setup(), and must remain subscribed. Publishing is for
+ * tasks only.
+ */
+
+#ifndef SRC_EVENTBUST_H_
+#define SRC_EVENTBUST_H_
+
+#include "Arduino.h"
+
+#include "BlockPool.h"
+
+#include <atomic>
+
+/**
+ * What a queue subscriber does with a new message when its queue is full.
+ */
+enum class EventOverflowPolicy {
+  DROP_OLDEST,  // Discard the oldest queued message to make room
+  DROP_NEWEST,  // Discard the new message
+  BLOCK,        // Block the publisher until there is room or a timeout
+};
+
+template <class T> class BaseEventBusT;
+
+/**
+ * Receives messages from an event bus. This class is not meant to be
+ * subclassed by application code. Use EventQueueSubscriberT or
+ * EventCallbackSubscriberT instead.
+ */
+template <class T> class EventSubscriberT {
+  friend class BaseEventBusT<T>;
+
+  BaseEventBusT<T> *bus;
+  EventSubscriberT<T> *next;
+  std::atomic<uint32_t> delivered_count;
+  std::atomic<uint32_t> dropped_count;
+
+protected:
+  EventSubscriberT(void) :
+      bus(NULL),
+      next(NULL),
+      delivered_count(0),
+      dropped_count(0) {
+  }
+
+  /**
+   * Accepts a message. The subscriber holds one reference to the message,
+   * which it MUST drop with release(), or with counted_drop() if it
+   * discards the message, exactly once.
+   */
+  virtual void deliver(const T *message) = 0;
+
+  /**
+   * Counts a discarded message and drops the reference to it.
+   */
+  inline void counted_drop(const T *message) {
+    dropped_count.fetch_add(1, std::memory_order_relaxed);
+    release(message);
+  }
+
+  /**
+   * Counts a message that reached the subscriber's consumer.
+   */
+  inline void counted_delivery(void) {
+    delivered_count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+public:
+  virtual ~EventSubscriberT() {}
+
+  /**
+   * Returns: the number of messages delivered to this subscriber, which
+   *          excludes dropped messages.
+   */
+  inline uint32_t delivered(void) const {
+    return delivered_count.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Returns: the number of messages that this subscriber dropped.
+   */
+  inline uint32_t dropped(void) const {
+    return dropped_count.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Drops a reference to a message that this subscriber received. The
+   * message MUST NOT be used afterward.
+   */
+  inline void release(const T *message) {
+    bus->release(message);
+  }
+
+  /**
+   * Zeros the delivered and dropped counts.
+   */
+  inline void reset_counters(void) {
+    delivered_count.store(0, std::memory_order_relaxed);
+    dropped_count.store(0, std::memory_order_relaxed);
+  }
+};
+
+/**
+ * The pool independent part of an event bus. Use EventBusT.
+ */
+template <class T> class BaseEventBusT {
+  EventSubscriberT<T> *first;
+  std::atomic<uint32_t> published_count;
+  std::atomic<uint32_t> exhausted_count;
+
+  BaseEventBusT(const BaseEventBusT&) = delete;
+  BaseEventBusT& operator=(const BaseEventBusT&) = delete;
+
+protected:
+  BaseEventBusT(void) :
+      first(NULL),
+      published_count(0),
+      exhausted_count(0) {
+  }
+
+  /**
+   * Adds the specified number of references to a message.
+   */
+  virtual void add_references(const T *message, uint32_t count) = 0;
+
+  /**
+   * Allocates an unreferenced message block.
+   *
+   * Returns: the block or NULL if the pool is exhausted.
+   */
+  virtual T *allocate_block(void) = 0;
+
+public:
+  virtual ~BaseEventBusT() {}
+
+  /**
+   * Allocates a message for the caller to fill in and publish. A message
+   * that is not published MUST be released.
+   *
+   * Returns: an uninitialized message, or NULL if the pool is exhausted.
+   */
+  T *allocate(void) {
+    T *message = allocate_block();
+    if (message) {
+      add_references(message, 1);
+    } else {
+      exhausted_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    return message;
+  }
+
+  /**
+   * Returns: the number of times allocate() failed because the pool was
+   *          exhausted.
+   */
+  inline uint32_t exhausted(void) const {
+    return exhausted_count.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Publishes a message obtained from allocate() to every subscriber.
+   * The publisher gives up its reference and MUST NOT use the message
+   * afterward. Blocks only if a subscriber's policy is BLOCK.
+   */
+  void publish(T *message) {
+    for (EventSubscriberT<T> *subscriber = first;
+        subscriber;
+        subscriber = subscriber->next) {
+      add_references(message, 1);
+      subscriber->deliver(message);
+    }
+    published_count.fetch_add(1, std::memory_order_relaxed);
+    release(message);
+  }
+
+  /**
+   * Copies a message into a newly allocated block and publishes it.
+   *
+   * Returns: true if the message was published, false if the pool
+   *          was exhausted.
+   */
+  bool publish(const T& message) {
+    T *block = allocate();
+    if (block) {
+      *block = message;
+      publish(block);
+    }
+    return block;
+  }
+
+  /**
+   * Returns: the number of messages published.
+   */
+  inline uint32_t published(void) const {
+    return published_count.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Drops a reference to a message, returning the message to the pool
+   * when the last reference is dropped.
+   */
+  virtual void release(const T *message) = 0;
+
+  /**
+   * Subscribes a subscriber to this bus. Subscribe before publishing
+   * begins. A subscriber can subscribe to only one bus.
+   *
+   * Returns: true if the subscriber was added, false if it already
+   *          subscribes to a bus.
+   */
+  bool subscribe(EventSubscriberT<T> *subscriber) {
+    if (subscriber->bus) {
+      return false;
+    }
+    subscriber->bus = this;
+    // Append, so that subscribers receive messages in subscription order.
+    EventSubscriberT<T> **link = &first;
+    while (*link) {
+      link = &(*link)->next;
+    }
+    *link = subscriber;
+    return true;
+  }
+};
+
+/**
+ * An event bus whose pool holds N messages. Size the pool to cover the
+ * messages that all subscribers can hold at once, plus those being
+ * filled in by producers.
+ */
+template <class T, size_t N> class EventBusT final : public BaseEventBusT<T> {
+  BlockPool<T, N> pool;
+  std::atomic<uint32_t> references[N];
+
+protected:
+  virtual void add_references(const T *message, uint32_t count) override {
+    references[pool.index_of(message)].fetch_add(
+        count, std::memory_order_relaxed);
+  }
+
+  virtual T *allocate_block(void) override {
+    return pool.allocate();
+  }
+
+public:
+  EventBusT(void) {
+    for (size_t i = 0; i < N; ++i) {
+      references[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  virtual ~EventBusT() {}
+
+  /**
+   * Returns: the number of messages that can be allocated.
+   */
+  inline size_t available_messages(void) const {
+    return pool.available();
+  }
+
+  virtual void release(const T *message) override {
+    if (references[pool.index_of(message)].fetch_sub(
+        1, std::memory_order_acq_rel) == 1) {
+      pool.release(const_cast<T *>(message));
+    }
+  }
+};
+
+#endif /* SRC_EVENTBUST_H_ */
@@ -0,0 +1,55 @@
+/*
+ * EventCallbackSubscriberT.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * An event bus subscriber that passes each message to a MessageFunctionT
+ * as it is published. The handler runs on the publishing task, before
+ * publish() returns, so it MUST be brief and MUST NOT block.
+ */
+
+#ifndef SRC_EVENTCALLBACKSUBSCRIBERT_H_
+#define SRC_EVENTCALLBACKSUBSCRIBERT_H_
+
+#include "Arduino.h"
+
+#include "EventBusT.h"
+#include "MessageFunctionT.h"
+
+template <class T> class EventCallbackSubscriberT final
+    : public EventSubscriberT<T> {
+  MessageFunctionT<T>& handler;
+
+protected:
+  virtual void deliver(const T *message) override {
+    handler.apply(*message);
+    this->counted_delivery();
+    this->release(message);
+  }
+
+public:
+  EventCallbackSubscriberT(MessageFunctionT<T>& handler) :
+      handler(handler) {
+  }
+
+  virtual ~EventCallbackSubscriberT() {}
+};
+
+#endif /* SRC_EVENTCALLBACKSUBSCRIBERT_H_ */
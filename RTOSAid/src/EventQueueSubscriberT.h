@@ -0,0 +1,146 @@
+/*
+ * EventQueueSubscriberT.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * An event bus subscriber that queues messages for a consumer task. The
+ * queue carries pointers to the bus's messages, so queueing copies no
+ * payload. The consumer pulls a message, uses it, and releases it.
+ *
+ * When the queue is full, the subscriber applies its overflow policy:
+ *
+ * * DROP_OLDEST discards the oldest queued message to make room, so the
+ *   consumer sees the newest messages.
+ * * DROP_NEWEST discards the new message, so the consumer sees the oldest.
+ * * BLOCK makes the publisher wait for room, up to a timeout, after which
+ *   the new message is discarded. A slow consumer therefore slows every
+ *   publisher on the bus.
+ *
+ * Discarded messages are counted in dropped().
+ */
+
+#ifndef SRC_EVENTQUEUESUBSCRIBERT_H_
+#define SRC_EVENTQUEUESUBSCRIBERT_H_
+
+#include "Arduino.h"
+
+#include "EventBusT.h"
+#include "PullQueueT.h"
+
+template <class T, size_t DEPTH> class EventQueueSubscriberT final
+    : public EventSubscriberT<T> {
+  const EventOverflowPolicy policy;
+  const uint32_t block_ms;
+  const T *queue_storage[DEPTH];
+  PullQueueT<const T *> queue;
+
+protected:
+  virtual void deliver(const T *message) override {
+    bool sent = false;
+    switch (policy) {
+      case EventOverflowPolicy::DROP_OLDEST:
+        // A concurrent consumer or publisher can change the queue between
+        // attempts, so give up after DEPTH evictions.
+        for (size_t attempt = 0; !sent && attempt <= DEPTH; ++attempt) {
+          sent = queue.send_message(&message, 0);
+          const T *oldest = NULL;
+          if (!sent && queue.pull_message(&oldest, 0)) {
+            this->counted_drop(oldest);
+          }
+        }
+        break;
+      case EventOverflowPolicy::DROP_NEWEST:
+        sent = queue.send_message(&message, 0);
+        break;
+      case EventOverflowPolicy::BLOCK:
+        sent = block_ms == portMAX_DELAY
+            ? queue.send_message(&message)
+            : queue.send_message(&message, block_ms);
+        break;
+    }
+    if (sent) {
+      this->counted_delivery();
+    } else {
+      this->counted_drop(message);
+    }
+  }
+
+public:
+
+  /**
+   * Creates a subscriber. Invoke begin() before subscribing it.
+   *
+   * Parameters:
+   *
+   * Name      Contents
+   * --------- ----------------------------------------------------------------
+   * policy    What to do with new messages when the queue is full
+   * block_ms  For the BLOCK policy, the longest time in milliseconds that a
+   *           publisher waits for room. Defaults to forever.
+   */
+  EventQueueSubscriberT(
+      EventOverflowPolicy policy,
+      uint32_t block_ms = portMAX_DELAY) :
+        policy(policy),
+        block_ms(block_ms),
+        queue(queue_storage, DEPTH) {
+  }
+
+  virtual ~EventQueueSubscriberT() {}
+
+  /**
+   * Starts the subscriber's queue.
+   *
+   * Returns: true if the queue started, false otherwise.
+   */
+  inline bool begin(void) {
+    return queue.begin();
+  }
+
+  /**
+   * Retrieves the oldest queued message, waiting for one to arrive. The
+   * caller MUST release() the message when it is done with it.
+   *
+   * Parameters:
+   *
+   * Name         Contents
+   * ------------ -------------------------------------------------------------
+   * message      Receives the message
+   * max_wait_ms  The maximum number of milliseconds to wait, forever if
+   *              omitted.
+   *
+   * Returns: true if a message was retrieved, false if the wait timed out.
+   */
+  inline bool pull_message(
+      const T **message, uint32_t max_wait_ms = portMAX_DELAY) {
+    return max_wait_ms == portMAX_DELAY
+        ? queue.pull_message(message)
+        : queue.pull_message(message, max_wait_ms);
+  }
+
+  /**
+   * Returns: the number of messages waiting in the queue.
+   */
+  inline UBaseType_t waiting_message_count(void) const {
+    return queue.waiting_message_count();
+  }
+};
+
+#endif /* SRC_EVENTQUEUESUBSCRIBERT_H_ */
@@ -0,0 +1,193 @@
+/*
+ * GpioDebounceService.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "GpioDebounceService.h"
+
+#include "esp_timer.h"
+
+GpioDebounceService::EdgeFunction::EdgeFunction(void) :
+    service(NULL),
+    index(0) {
+}
+
+GpioDebounceService::EdgeFunction::~EdgeFunction() {
+}
+
+void IRAM_ATTR GpioDebounceService::EdgeFunction::apply(void) {
+  service->record_edge(index);
+}
+
+void GpioDebounceService::EdgeFunction::bind(
+    GpioDebounceService *service, size_t index) {
+  this->service = service;
+  this->index = index;
+}
+
+GpioDebounceService::WakeFunction::WakeFunction(
+    GpioDebounceService& service) :
+      service(service) {
+}
+
+GpioDebounceService::WakeFunction::~WakeFunction() {
+}
+
+void GpioDebounceService::WakeFunction::apply(void) {
+  service.notify();
+}
+
+GpioDebounceService::GpioDebounceService(
+    const char *task_name,
+    UBaseType_t priority,
+    size_t stack_size,
+    GpioEdgeSource& edge_source) :
+      edge_source(edge_source),
+      pin_count(0),
+      attached_count(0),
+      pending_edges(0),
+      on_timer(*this),
+      timer(task_name, &on_timer),
+      timer_ready(false),
+      task(task_name, priority, this, stack_size) {
+}
+
+GpioDebounceService::~GpioDebounceService() {
+  stop();
+}
+
+int GpioDebounceService::add_pin(
+    uint8_t pin_no, uint32_t window_micros, VoidFunction *on_settled) {
+  if (MAX_PINS <= pin_count) {
+    return -1;
+  }
+  Pin& pin = pins[pin_count];
+  pin.pin_no = pin_no;
+  pin.window_micros = window_micros;
+  pin.on_settled = on_settled;
+  pin.on_edge.bind(this, pin_count);
+  pin.last_edge_micros = 0;
+  pin.edge_count = 0;
+  pin.settle_count = 0;
+  pin.bouncing = false;
+  return static_cast<int>(pin_count++);
+}
+
+void GpioDebounceService::detach_pins(void) {
+  while (attached_count) {
+    edge_source.detach(pins[--attached_count].pin_no);
+  }
+}
+
+void IRAM_ATTR GpioDebounceService::record_edge(size_t index) {
+  Pin& pin = pins[index];
+  pin.last_edge_micros = static_cast<uint32_t>(esp_timer_get_time());
+  pin.edge_count = pin.edge_count + 1;
+  pending_edges.fetch_or(1u << index);
+  // Simulated edge sources run in tasks, the hardware in an ISR.
+  if (xPortInIsrContext()) {
+    notify_from_isr();
+  } else {
+    notify();
+  }
+}
+
+void GpioDebounceService::run(void) {
+  while (!cancelled()) {
+    wait_for_notification();
+    if (!cancelled()) {
+      settle();
+    }
+  }
+}
+
+void GpioDebounceService::settle(void) {
+  uint32_t edges = pending_edges.exchange(0);
+  for (size_t i = 0; edges; ++i, edges >>= 1) {
+    if (edges & 1) {
+      pins[i].bouncing = true;
+    }
+  }
+
+  bool waiting = false;
+  uint32_t next_settle_micros = UINT32_MAX;
+  for (size_t i = 0; i < pin_count; ++i) {
+    Pin& pin = pins[i];
+    if (!pin.bouncing) {
+      continue;
+    }
+    // Read the edge time before the clock so that an edge arriving
+    // between the two reads cannot make the quiet time negative.
+    uint32_t last_edge_micros = pin.last_edge_micros;
+    uint32_t quiet_micros =
+        static_cast<uint32_t>(esp_timer_get_time()) - last_edge_micros;
+    if (pin.window_micros <= quiet_micros) {
+      pin.bouncing = false;
+      ++pin.settle_count;
+      pin.on_settled->apply();
+    } else {
+      waiting = true;
+      uint32_t remaining_micros = pin.window_micros - quiet_micros;
+      if (remaining_micros < next_settle_micros) {
+        next_settle_micros = remaining_micros;
+      }
+    }
+  }
+
+  // Edges that arrive from here on notify the task, which runs settle()
+  // again, so restarting the timer cannot miss them.
+  if (waiting) {
+    timer.start(next_settle_micros);
+  }
+}
+
+bool GpioDebounceService::start(void) {
+  if (!timer_ready) {
+    timer_ready = timer.begin();
+  }
+  if (!timer_ready || !task.start()) {
+    return false;
+  }
+  while (attached_count < pin_count) {
+    Pin& pin = pins[attached_count];
+    if (!edge_source.attach(pin.pin_no, &pin.on_edge)) {
+      detach_pins();
+      task.cancel();
+      task.join();
+      return false;
+    }
+    ++attached_count;
+  }
+  return true;
+}
+
+void GpioDebounceService::stop(void) {
+  detach_pins();
+  if (timer_ready) {
+    timer.stop();
+  }
+  task.cancel();
+  task.join();
+  pending_edges.store(0);
+  for (size_t i = 0; i < pin_count; ++i) {
+    pins[i].bouncing = false;
+  }
+}
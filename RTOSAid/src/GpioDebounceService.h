@@ -0,0 +1,236 @@
+/*
+ * GpioDebounceService.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Debounces many GPIO inputs with one task and one timer. Each
+ * GpioDebouncer has its own task, stack, MicrosecondTimer, and change
+ * detector, so twenty buttons cost twenty of each. A GpioDebounceService
+ * watches up to MAX_PINS pins, each with its own debounce window and
+ * callback, and shares a single task and a single MicrosecondTimer among
+ * them.
+ *
+ * The edge interrupt does as little as possible: it records the time and
+ * marks the pin, then wakes the service task. The task tracks which pins
+ * are bouncing and starts the timer for the earliest moment that one of
+ * them could settle. A pin settles when no edge has arrived for its
+ * window. The task then invokes the pin's callback, once per burst of
+ * bounces, just as a GpioDebouncer would. Callbacks run on the service
+ * task, not in an interrupt, so they may read the pin, log, and block
+ * briefly, but they delay the other pins while they run.
+ *
+ *     static GpioDebounceService buttons("Buttons", 5);
+ *
+ *     buttons.add_pin(BUTTON_A, 20000, &on_button_a);  // 20 ms window
+ *     buttons.add_pin(BUTTON_B, 5000, &on_button_b);   //  5 ms window
+ *     buttons.start();
+ *
+ * Edges come from a GpioEdgeSource, the GPIO hardware by default. Tests
+ * can substitute a source that plays scripted waveforms; see the
+ * GpioDebounceService example.
+ */
+
+#ifndef SRC_GPIODEBOUNCESERVICE_H_
+#define SRC_GPIODEBOUNCESERVICE_H_
+
+#include "Arduino.h"
+
+#include "GpioEdgeSource.h"
+#include "MicrosecondTimer.h"
+#include "TaskAction.h"
+#include "TaskWithActionH.h"
+#include "VoidFunction.h"
+
+#include <atomic>
+
+class GpioDebounceService : public TaskAction {
+public:
+  static const size_t MAX_PINS = 32;
+
+private:
+  /**
+   * Records an edge on one pin. The edge source invokes it.
+   */
+  class EdgeFunction final : public VoidFunction {
+    GpioDebounceService *service;
+    size_t index;
+
+  public:
+    EdgeFunction(void);
+    virtual ~EdgeFunction();
+
+    virtual void IRAM_ATTR apply(void);
+
+    void bind(GpioDebounceService *service, size_t index);
+  };
+
+  /**
+   * Wakes the service task when the timer fires.
+   */
+  class WakeFunction final : public VoidFunction {
+    GpioDebounceService& service;
+
+  public:
+    WakeFunction(GpioDebounceService& service);
+    virtual ~WakeFunction();
+
+    virtual void apply(void);
+  };
+
+  struct Pin {
+    uint8_t pin_no;
+    uint32_t window_micros;
+    VoidFunction *on_settled;
+    EdgeFunction on_edge;
+
+    // Low 32 bits of esp_timer_get_time() at the most recent edge. The
+    // edge interrupt writes it; a 32 bit store is atomic.
+    volatile uint32_t last_edge_micros;
+    volatile uint32_t edge_count;
+    uint32_t settle_count;
+
+    // Set while the pin is bouncing. Only the service task uses it.
+    bool bouncing;
+  };
+
+  GpioEdgeSource& edge_source;
+  Pin pins[MAX_PINS];
+  size_t pin_count;
+
+  // The number of pins, counting from the first, that are attached to
+  // the edge source.
+  size_t attached_count;
+
+  // One bit per pin that has seen an edge since the task last looked.
+  std::atomic<uint32_t> pending_edges;
+
+  WakeFunction on_timer;
+  MicrosecondTimer timer;
+  bool timer_ready;
+  TaskWithActionH task;
+
+  GpioDebounceService(const GpioDebounceService&) = delete;
+  GpioDebounceService& operator=(const GpioDebounceService&) = delete;
+
+  /**
+   * Detaches every attached pin from the edge source.
+   */
+  void detach_pins(void);
+
+  /**
+   * Records an edge on a pin and wakes the service task. Callable from
+   * an ISR or from a task.
+   */
+  void IRAM_ATTR record_edge(size_t index);
+
+protected:
+  /**
+   * Invokes the callbacks of pins that have settled and, if any pins
+   * are still bouncing, starts the timer for the earliest that could
+   * settle next. The service task invokes it whenever it is notified,
+   * which tests can emulate.
+   */
+  void settle(void);
+
+public:
+  /**
+   * Creates a service that watches no pins.
+   *
+   * Parameters:
+   *
+   * Name        Contents
+   * ----------- --------------------------------------------------------------
+   * task_name   Name of the service task, also used for its timer
+   * priority    Service task priority
+   * stack_size  Service task stack size in bytes. Pin callbacks run on
+   *             the service task, so size it for them.
+   * edge_source Source of GPIO edges, the hardware by default
+   */
+  GpioDebounceService(
+      const char *task_name,
+      UBaseType_t priority,
+      size_t stack_size = 4096,
+      GpioEdgeSource& edge_source = GpioEdges);
+  virtual ~GpioDebounceService();
+
+  /**
+   * Adds a pin. Add every pin before invoking start().
+   *
+   * Parameters:
+   *
+   * Name          Contents
+   * ------------- ------------------------------------------------------------
+   * pin_no        The GPIO pin to watch. Callers must configure the pin's
+   *               mode and pull resistors.
+   * window_micros How long the pin must be quiet, in microseconds, before
+   *               it is considered settled. Must be less than 2^31.
+   * on_settled    Invoked on the service task each time the pin settles
+   *               after one or more edges
+   *
+   * Returns: the pin's index, which identifies it to edge_count() and
+   *          settle_count(), or -1 if the service is full.
+   */
+  int add_pin(uint8_t pin_no, uint32_t window_micros, VoidFunction *on_settled);
+
+  /**
+   * Returns: the number of edges seen on a pin, bounces included.
+   */
+  inline uint32_t edge_count(size_t index) const {
+    return pins[index].edge_count;
+  }
+
+  /**
+   * Returns: the number of pins added.
+   */
+  inline size_t pins_added(void) const {
+    return pin_count;
+  }
+
+  /**
+   * The service task loop. Applications must not invoke this.
+   */
+  virtual void run(void);
+
+  /**
+   * Returns: the number of times a pin has settled, which is the number
+   *          of times its callback has been invoked.
+   */
+  inline uint32_t settle_count(size_t index) const {
+    return pins[index].settle_count;
+  }
+
+  /**
+   * Starts the service task and the timer and attaches every pin.
+   *
+   * Returns: true on success, false on failure, in which case nothing
+   *          is left running.
+   */
+  bool start(void);
+
+  /**
+   * Detaches every pin that start() attached and stops the timer and the
+   * service task. Bouncing pins are abandoned without invoking their
+   * callbacks. Does nothing to the edge source if the service was never
+   * started.
+   */
+  void stop(void);
+};
+
+#endif /* SRC_GPIODEBOUNCESERVICE_H_ */
@@ -0,0 +1,61 @@
+/*
+ * GpioEdgeSource.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "GpioEdgeSource.h"
+
+#include "GpioChangeDetector.h"
+
+#include "driver/gpio.h"
+
+HardwareGpioEdgeSource GpioEdges;
+
+GpioEdgeSource::GpioEdgeSource(void) {
+}
+
+GpioEdgeSource::~GpioEdgeSource() {
+}
+
+HardwareGpioEdgeSource::HardwareGpioEdgeSource(void) {
+}
+
+HardwareGpioEdgeSource::~HardwareGpioEdgeSource() {
+}
+
+void IRAM_ATTR HardwareGpioEdgeSource::edge_interrupt_handler(void *params) {
+  static_cast<VoidFunction *>(params)->apply();
+}
+
+bool HardwareGpioEdgeSource::attach(uint8_t pin_no, VoidFunction *on_edge) {
+  gpio_num_t gpio_num = gpio_num_t(pin_no);
+  return
+      GpioChangeService.begin()
+      && (gpio_set_intr_type(gpio_num, GPIO_INTR_ANYEDGE) == ESP_OK)
+      && (gpio_isr_handler_add(gpio_num, edge_interrupt_handler, on_edge) ==
+          ESP_OK);
+}
+
+void HardwareGpioEdgeSource::detach(uint8_t pin_no) {
+  gpio_num_t gpio_num = gpio_num_t(pin_no);
+  gpio_set_intr_type(gpio_num, GPIO_INTR_DISABLE);
+  gpio_isr_handler_remove(gpio_num);
+}
@@ -0,0 +1,93 @@
+/*
+ * GpioEdgeSource.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Sources of GPIO edges, the interface between GPIO interrupts and the
+ * classes that respond to them. A GpioEdgeSource invokes a VoidFunction
+ * for every voltage change, rising or falling, on an attached pin.
+ *
+ * The library's GpioEdges instance takes its edges from the hardware.
+ * Tests can substitute a simulated source that plays scripted waveforms,
+ * so that edge handling logic, such as GpioDebounceService, can be
+ * exercised without switches, wiring, or real bounce.
+ */
+
+#ifndef SRC_GPIOEDGESOURCE_H_
+#define SRC_GPIOEDGESOURCE_H_
+
+#include "Arduino.h"
+
+#include "VoidFunction.h"
+
+class GpioEdgeSource {
+public:
+  GpioEdgeSource(void);
+  virtual ~GpioEdgeSource();
+
+  /**
+   * Starts invoking a function on every edge on a pin.
+   *
+   * Parameters:
+   *
+   * Name     Contents
+   * -------- -----------------------------------------------------------------
+   * pin_no   The GPIO pin to watch. Callers must configure the pin's mode
+   *          and pull resistors.
+   * on_edge  Invoked on every edge, typically from an interrupt service
+   *          routine. It must be short, must not block, and must reside
+   *          in IRAM.
+   *
+   * Returns: true on success, false on failure.
+   */
+  virtual bool attach(uint8_t pin_no, VoidFunction *on_edge) = 0;
+
+  /**
+   * Stops watching a pin. Does nothing if the pin is not attached.
+   */
+  virtual void detach(uint8_t pin_no) = 0;
+};
+
+/**
+ * Edges from the GPIO hardware. Attaching a pin starts the
+ * GpioChangeService if it is not already running. Callers must not
+ * create instances of this class. Use the library's GpioEdges instance
+ * instead.
+ */
+class HardwareGpioEdgeSource final : public GpioEdgeSource {
+
+  /**
+   * The interrupt handler, which invokes the VoidFunction that params
+   * points to.
+   */
+  static void IRAM_ATTR edge_interrupt_handler(void *params);
+
+public:
+  HardwareGpioEdgeSource(void);
+  virtual ~HardwareGpioEdgeSource();
+
+  virtual bool attach(uint8_t pin_no, VoidFunction *on_edge);
+
+  virtual void detach(uint8_t pin_no);
+};
+
+extern HardwareGpioEdgeSource GpioEdges;
+
+#endif /* SRC_GPIOEDGESOURCE_H_ */
@@ -0,0 +1,175 @@
+/*
+ * InstrumentationRegistryT.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The set of all started instances of an instrumentation class, e.g.
+ * every instrumented queue, kept in an intrusive singly linked list so
+ * that registering never allocates memory. QueueRegistry, TaskRegistry,
+ * and MutexRegistry are instances.
+ *
+ * The registry is guarded by a recursive FreeRTOS mutex rather than a
+ * spinlock, because some snapshots, e.g. a task's stack high-water mark,
+ * take too long to copy with interrupts masked. Registries must not be
+ * used from ISRs. Instrumentation classes that need to update their own
+ * state atomically with registration can hold the registry's lock
+ * across add() or remove(); the lock is recursive.
+ *
+ * The instrumentation class I must
+ *
+ * * declare InstrumentationRegistryT a friend,
+ * * have an I *next member and a bool registered member, both of which
+ *   belong to the registry,
+ * * provide void reset(void), which discards the instance's statistics,
+ * * provide void copy_statistics(S *snapshot), which the registry
+ *   invokes with its lock held, and
+ * * provide static void print_statistics(Print& out, const S& snapshot),
+ *   which prints one line.
+ *
+ * S is the snapshot struct, e.g. QueueStatistics.
+ */
+
+#ifndef SRC_INSTRUMENTATIONREGISTRYT_H_
+#define SRC_INSTRUMENTATIONREGISTRYT_H_
+
+#include "Arduino.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+template <class I, class S> class InstrumentationRegistryT final {
+  I *first;
+  StaticSemaphore_t mutex_buffer;
+  SemaphoreHandle_t mutex;
+
+  InstrumentationRegistryT(const InstrumentationRegistryT&) = delete;
+  InstrumentationRegistryT& operator=(
+      const InstrumentationRegistryT&) = delete;
+
+public:
+  InstrumentationRegistryT(void) :
+      first(NULL),
+      mutex(xSemaphoreCreateRecursiveMutexStatic(&mutex_buffer)) {
+  }
+
+  /**
+   * Registers an instance unless it is registered already.
+   * Instrumented objects do this automatically.
+   */
+  void add(I *instrumentation) {
+    lock();
+    if (!instrumentation->registered) {
+      instrumentation->next = first;
+      first = instrumentation;
+      instrumentation->registered = true;
+    }
+    unlock();
+  }
+
+  /**
+   * Returns: the number of registered instances.
+   */
+  size_t count(void) {
+    size_t result = 0;
+    lock();
+    for (I *i = first; i; i = i->next) {
+      ++result;
+    }
+    unlock();
+    return result;
+  }
+
+  /**
+   * Takes the registry's lock, waiting as long as necessary. Every
+   * lock() must be balanced by an unlock().
+   */
+  void lock(void) {
+    xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
+  }
+
+  /**
+   * Prints one line of statistics per registered instance.
+   */
+  void print(Print& out) {
+    S statistics;
+    // Printing can block, so copy each instance's statistics before
+    // printing it.
+    for (size_t index = 0; snapshot(index, &statistics); ++index) {
+      I::print_statistics(out, statistics);
+    }
+  }
+
+  /**
+   * Unregisters an instance if it is registered. Instrumented objects do
+   * this automatically.
+   */
+  void remove(I *instrumentation) {
+    lock();
+    if (instrumentation->registered) {
+      for (I **link = &first; *link; link = &(*link)->next) {
+        if (*link == instrumentation) {
+          *link = instrumentation->next;
+          break;
+        }
+      }
+      instrumentation->next = NULL;
+      instrumentation->registered = false;
+    }
+    unlock();
+  }
+
+  /**
+   * Resets every registered instance's statistics.
+   */
+  void reset_all(void) {
+    lock();
+    for (I *i = first; i; i = i->next) {
+      i->reset();
+    }
+    unlock();
+  }
+
+  /**
+   * Retrieves the statistics of the index-th registered instance.
+   *
+   * Returns: true if the instance exists, false if index is out of range.
+   */
+  bool snapshot(size_t index, S *snapshot) {
+    lock();
+    I *instrumentation = first;
+    for (size_t i = 0; instrumentation && i < index; ++i) {
+      instrumentation = instrumentation->next;
+    }
+    if (instrumentation) {
+      instrumentation->copy_statistics(snapshot);
+    }
+    unlock();
+    return instrumentation;
+  }
+
+  /**
+   * Releases the registry's lock.
+   */
+  void unlock(void) {
+    xSemaphoreGiveRecursive(mutex);
+  }
+};
+
+#endif /* SRC_INSTRUMENTATIONREGISTRYT_H_ */
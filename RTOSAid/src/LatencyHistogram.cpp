@@ -0,0 +1,126 @@
+/*
+ * LatencyHistogram.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LatencyHistogram.h"
+
+#include <cstring>
+
+LatencyHistogram::LatencyHistogram(void) {
+  clear();
+}
+
+void LatencyHistogram::clear(void) {
+  std::memset(buckets, 0, sizeof(buckets));
+  sample_count = 0;
+  minimum_sample = 0;
+  maximum_sample = 0;
+  sample_total = 0;
+}
+
+uint32_t LatencyHistogram::mean(void) const {
+  return sample_count
+      ? static_cast<uint32_t>(sample_total / sample_count)
+      : 0;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+  if (!other.sample_count) {
+    return;
+  }
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    buckets[i] += other.buckets[i];
+  }
+  if (!sample_count || other.minimum_sample < minimum_sample) {
+    minimum_sample = other.minimum_sample;
+  }
+  if (maximum_sample < other.maximum_sample) {
+    maximum_sample = other.maximum_sample;
+  }
+  sample_count += other.sample_count;
+  sample_total += other.sample_total;
+}
+
+uint32_t LatencyHistogram::percentile(float percent) const {
+  if (!sample_count) {
+    return 0;
+  }
+  if (percent <= 0.0f) {
+    return minimum_sample;
+  }
+  if (100.0f <= percent) {
+    return maximum_sample;
+  }
+
+  // The 1-based rank of the requested sample
+  uint32_t rank = static_cast<uint32_t>(
+      (percent * sample_count + 99.0f) / 100.0f);
+  if (!rank) {
+    rank = 1;
+  }
+
+  uint32_t below = 0;
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    uint32_t in_bucket = buckets[i];
+    if (rank <= below + in_bucket) {
+      // The top bucket's ceiling is 2^32, so compute in 64 bits and
+      // narrow only after clamping.
+      uint64_t floor = bucket_floor(i);
+      uint64_t width = i ? floor : 0;
+      uint64_t estimate = floor + (width * (rank - below)) / in_bucket;
+      if (estimate < minimum_sample) {
+        estimate = minimum_sample;
+      }
+      if (maximum_sample < estimate) {
+        estimate = maximum_sample;
+      }
+      return static_cast<uint32_t>(estimate);
+    }
+    below += in_bucket;
+  }
+  return maximum_sample;
+}
+
+void LatencyHistogram::print(
+    Print& out, const char *title, const char *units) const {
+  out.printf(
+      "%s: n=%lu min=%lu p50=%lu p90=%lu p99=%lu max=%lu mean=%lu %s\n",
+      title,
+      static_cast<unsigned long>(sample_count),
+      static_cast<unsigned long>(minimum()),
+      static_cast<unsigned long>(percentile(50.0f)),
+      static_cast<unsigned long>(percentile(90.0f)),
+      static_cast<unsigned long>(percentile(99.0f)),
+      static_cast<unsigned long>(maximum_sample),
+      static_cast<unsigned long>(mean()),
+      units);
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    if (buckets[i]) {
+      uint64_t ceiling = i ? static_cast<uint64_t>(bucket_floor(i)) << 1 : 1;
+      out.printf(
+          "  [%10lu, %10llu) %lu\n",
+          static_cast<unsigned long>(bucket_floor(i)),
+          static_cast<unsigned long long>(ceiling),
+          static_cast<unsigned long>(buckets[i]));
+    }
+  }
+}
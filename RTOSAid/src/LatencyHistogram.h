@@ -0,0 +1,167 @@
+/*
+ * LatencyHistogram.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A compact, fixed size histogram of unsigned 32 bit samples, typically
+ * durations in microseconds or CPU cycles. Samples are sorted into
+ * power of two buckets: bucket 0 holds 0, and bucket n, n > 0, holds
+ * values in [2^(n-1), 2^n). Recording a sample is a handful of
+ * instructions and never allocates, so histograms can be embedded in
+ * queues, mutexes, and tasks to gather statistics in production.
+ *
+ * Percentiles are estimated by linear interpolation within the bucket
+ * that contains the requested rank, so they are approximate. The
+ * minimum, maximum, count and total are exact.
+ *
+ * Instances are NOT thread-safe. Callers that record from multiple tasks
+ * or from an ISR must provide their own serialization.
+ */
+
+#ifndef SRC_LATENCYHISTOGRAM_H_
+#define SRC_LATENCYHISTOGRAM_H_
+
+#include "Arduino.h"
+
+class LatencyHistogram final {
+public:
+  static const size_t BUCKET_COUNT = 33;
+
+private:
+  uint32_t buckets[BUCKET_COUNT];
+  uint32_t sample_count;
+  uint32_t minimum_sample;
+  uint32_t maximum_sample;
+  uint64_t sample_total;
+
+public:
+  LatencyHistogram(void);
+
+  /**
+   * Returns: the index of the bucket that holds the specified value.
+   */
+  static inline size_t bucket_index(uint32_t value) {
+    return value ? 32 - __builtin_clz(value) : 0;
+  }
+
+  /**
+   * Returns: the smallest value that the specified bucket can hold.
+   */
+  static inline uint32_t bucket_floor(size_t bucket) {
+    return bucket ? (1UL << (bucket - 1)) : 0;
+  }
+
+  /**
+   * Returns: the number of samples in the specified bucket, which must be
+   * less than BUCKET_COUNT.
+   */
+  inline uint32_t bucket(size_t index) const {
+    return buckets[index];
+  }
+
+  /**
+   * Discards all recorded samples.
+   */
+  void clear(void);
+
+  /**
+   * Returns: the number of recorded samples.
+   */
+  inline uint32_t count(void) const {
+    return sample_count;
+  }
+
+  /**
+   * Returns: the largest recorded sample, or 0 if none have been recorded.
+   */
+  inline uint32_t maximum(void) const {
+    return maximum_sample;
+  }
+
+  /**
+   * Returns: the mean of all recorded samples, or 0 if none have been
+   * recorded.
+   */
+  uint32_t mean(void) const;
+
+  /**
+   * Adds the samples in another histogram to this one.
+   */
+  void merge(const LatencyHistogram& other);
+
+  /**
+   * Returns: the smallest recorded sample, or 0 if none have been recorded.
+   */
+  inline uint32_t minimum(void) const {
+    return sample_count ? minimum_sample : 0;
+  }
+
+  /**
+   * Estimates the value below which the specified percentage of the
+   * recorded samples fall.
+   *
+   * Parameters:
+   *
+   * Name     Contents
+   * -------- ---------------------------------------------------------------
+   * percent  The desired percentile in [0 .. 100], e.g. 99.9
+   *
+   * Returns: the estimated percentile, which is clamped to the recorded
+   *          minimum and maximum, or 0 if the histogram is empty.
+   */
+  uint32_t percentile(float percent) const;
+
+  /**
+   * Prints a one line summary (count, min, p50, p90, p99, max) followed by
+   * the non-empty buckets.
+   *
+   * Parameters:
+   *
+   * Name     Contents
+   * -------- ---------------------------------------------------------------
+   * out      Receives the report, typically Serial
+   * title    Histogram name, printed at the start of the summary
+   * units    Sample units, e.g. "us" or "cycles"
+   */
+  void print(Print& out, const char *title, const char *units) const;
+
+  /**
+   * Records a single sample.
+   */
+  inline void record(uint32_t sample) {
+    ++buckets[bucket_index(sample)];
+    if (!sample_count++ || sample < minimum_sample) {
+      minimum_sample = sample;
+    }
+    if (maximum_sample < sample) {
+      maximum_sample = sample;
+    }
+    sample_total += sample;
+  }
+
+  /**
+   * Returns: the sum of all recorded samples.
+   */
+  inline uint64_t total(void) const {
+    return sample_total;
+  }
+};
+
+#endif /* SRC_LATENCYHISTOGRAM_H_ */
@@ -0,0 +1,277 @@
+/*
+ * LatestValueT.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A lock-free channel that holds only the most recently published value
+ * of a T, such as a sensor reading or a decoded CAN signal. Use it instead
+ * of a queue when readers care only about the newest value: the writer
+ * never blocks or fails, nothing is queued, and readers never drain stale
+ * values.
+ *
+ * The channel is a sequence lock (seqlock). The writer makes the sequence
+ * number odd, copies the value, then makes the sequence number even again.
+ * A reader copies the value between two reads of the sequence number and
+ * tries again if the numbers differ or are odd, so readers always see a
+ * consistent value without ever blocking the writer.
+ *
+ * Readers can ask whether the value changed since they last read it, and
+ * one task can be notified, through BaseTaskWithAction::notify_bits(),
+ * each time a value is published.
+ *
+ * Restrictions:
+ *
+ * 1. At most one writer, a task or an ISR, may publish at any time. Any
+ *    number of tasks may read.
+ * 2. T must be trivially copyable. Keep it small, as readers copy the
+ *    whole value and retry when a write overlaps the copy.
+ * 3. ISRs may read only with try_read(), which fails instead of waiting.
+ *
+ * Storage is allocated within the instance, so declare channels statically
+ * or as class fields.
+ */
+
+#ifndef SRC_LATESTVALUET_H_
+#define SRC_LATESTVALUET_H_
+
+#include "Arduino.h"
+#include "BaseTaskWithAction.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+template <class T> class LatestValueT final {
+  static_assert(
+      std::is_trivially_copyable<T>::value,
+      "LatestValueT values must be trivially copyable.");
+
+  static const size_t WORD_COUNT = (sizeof(T) + 3) / 4;
+
+  // Failed attempts after which a reader sleeps for a tick, giving a
+  // lower priority writer that it preempted on the same core a chance
+  // to finish.
+  static const uint32_t SPINS_BEFORE_SLEEP = 16;
+
+  // Odd while a write is in progress. Each write adds 2.
+  std::atomic<uint32_t> sequence;
+
+  // Set by the first write. Guarded by sequence like the value, since
+  // sequence itself wraps back to 0.
+  std::atomic<bool> published;
+
+  // The value, copied word by word with relaxed atomic accesses so that
+  // a read that overlaps a write is well defined, if discarded.
+  std::atomic<uint32_t> words[WORD_COUNT];
+
+  std::atomic<BaseTaskWithAction *> change_task;
+  std::atomic<uint32_t> change_bits;
+
+  LatestValueT(const LatestValueT&) = delete;
+  LatestValueT(LatestValueT&&) = delete;
+  LatestValueT& operator=(const LatestValueT&) = delete;
+  LatestValueT& operator=(LatestValueT&&) = delete;
+
+  /**
+   * Makes one attempt to copy the value.
+   *
+   * Returns: true if the copy is consistent, false if a write overlapped
+   *          it. *version receives the version that was copied, and
+   *          *has_value whether any value had been published.
+   */
+  inline bool attempt_read(
+      T *value, uint32_t *version, bool *has_value) const {
+    uint32_t before = sequence.load(std::memory_order_acquire);
+    if (before & 1) {
+      return false;
+    }
+    uint32_t copy[WORD_COUNT];
+    for (size_t i = 0; i < WORD_COUNT; ++i) {
+      copy[i] = words[i].load(std::memory_order_relaxed);
+    }
+    bool copied_published = published.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence.load(std::memory_order_relaxed) != before) {
+      return false;
+    }
+    std::memcpy(value, copy, sizeof(T));
+    *version = before >> 1;
+    *has_value = copied_published;
+    return true;
+  }
+
+  inline void write(const T& value) {
+    uint32_t copy[WORD_COUNT];
+    copy[WORD_COUNT - 1] = 0;
+    std::memcpy(copy, &value, sizeof(T));
+    uint32_t current = sequence.load(std::memory_order_relaxed);
+    sequence.store(current + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORD_COUNT; ++i) {
+      words[i].store(copy[i], std::memory_order_relaxed);
+    }
+    published.store(true, std::memory_order_relaxed);
+    sequence.store(current + 2, std::memory_order_release);
+  }
+
+public:
+  inline LatestValueT(void) :
+      sequence(0),
+      published(false),
+      change_task(NULL),
+      change_bits(0) {
+    for (size_t i = 0; i < WORD_COUNT; ++i) {
+      words[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  ~LatestValueT() {}
+
+  /**
+   * Returns: true if the value has been published since the reader last
+   *          read it, i.e. if its version differs from last_version.
+   */
+  inline bool changed_since(uint32_t last_version) const {
+    return version() != last_version;
+  }
+
+  /**
+   * Publishes a new value, replacing the current one, and notifies the
+   * change task, if any. Never blocks. For use ONLY by the writer task.
+   * ISRs MUST invoke publish_from_isr() instead.
+   */
+  inline void publish(const T& value) {
+    write(value);
+    BaseTaskWithAction *task = change_task.load(std::memory_order_acquire);
+    if (task) {
+      task->notify_bits(change_bits.load(std::memory_order_relaxed));
+    }
+  }
+
+  /**
+   * Publishes a new value from an interrupt service routine (ISR),
+   * notifying the change task, if any, and yielding if it is awakened.
+   */
+  inline void IRAM_ATTR publish_from_isr(const T& value) {
+    write(value);
+    BaseTaskWithAction *task = change_task.load(std::memory_order_acquire);
+    if (task) {
+      task->notify_bits_from_isr(change_bits.load(std::memory_order_relaxed));
+    }
+  }
+
+  /**
+   * Retrieves the current value, waiting for an overlapping write to
+   * finish. For use by tasks only.
+   *
+   * Parameters:
+   *
+   * Name     Contents
+   * -------- ----------------------------------------------------------------
+   * value    Receives the value, if one has been published
+   * version  If not NULL, receives the value's version, which
+   *          changed_since() and read_if_changed() accept.
+   *
+   * Returns: true if a value was retrieved, false if no value has been
+   *          published yet.
+   */
+  bool read(T *value, uint32_t *version = NULL) const {
+    uint32_t read_version = 0;
+    bool has_value = false;
+    for (uint32_t attempts = 1;
+        !attempt_read(value, &read_version, &has_value);
+        ++attempts) {
+      if (attempts % SPINS_BEFORE_SLEEP == 0) {
+        vTaskDelay(1);
+      }
+    }
+    if (version) {
+      *version = read_version;
+    }
+    return has_value;
+  }
+
+  /**
+   * Retrieves the current value if it has been published since the reader
+   * last read it. For use by tasks only.
+   *
+   * Parameters:
+   *
+   * Name          Contents
+   * ------------- -----------------------------------------------------------
+   * value         Receives the value, if it changed
+   * last_version  The version the reader last read, 0 initially. Updated
+   *               when a new value is retrieved.
+   *
+   * Returns: true if a new value was retrieved, false if the value has not
+   *          changed.
+   */
+  bool read_if_changed(T *value, uint32_t *last_version) const {
+    if (!changed_since(*last_version)) {
+      return false;
+    }
+    return read(value, last_version);
+  }
+
+  /**
+   * Names a task to notify each time a value is published. The task
+   * receives the specified bits via notify_bits() and typically waits for
+   * them with wait_for_bits(). Pass NULL to stop notifications. Only one
+   * task can be notified.
+   */
+  inline void set_change_notification(
+      BaseTaskWithAction *task, uint32_t bits) {
+    change_bits.store(bits, std::memory_order_relaxed);
+    change_task.store(task, std::memory_order_release);
+  }
+
+  /**
+   * Makes a single attempt to retrieve the current value. Safe to invoke
+   * from any task or ISR.
+   *
+   * Returns: true if a value was retrieved, false if no value has been
+   *          published or a write is in progress.
+   */
+  inline bool try_read(T *value, uint32_t *version = NULL) const {
+    uint32_t read_version = 0;
+    bool has_value = false;
+    bool succeeded =
+        attempt_read(value, &read_version, &has_value) && has_value;
+    if (succeeded && version) {
+      *version = read_version;
+    }
+    return succeeded;
+  }
+
+  /**
+   * Returns: the number of values published so far, which serves as the
+   *          current value's version. 0 means nothing has been published,
+   *          or that the version wrapped, which happens after 2^31
+   *          publications.
+   */
+  inline uint32_t version(void) const {
+    return (sequence.load(std::memory_order_acquire) + 1) >> 1;
+  }
+};
+
+#endif /* SRC_LATESTVALUET_H_ */
@@ -0,0 +1,289 @@
+/*
+ * LockOrderChecker.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "LockOrderChecker.h"
+
+#include <string.h>
+
+#if RTOSAID_LOCK_ORDER_CHECKING
+
+LockOrderChecker LockOrder;
+
+LockOrderKey::LockOrderKey(void) :
+    name(NULL),
+    lock_class(-1) {
+}
+
+void LockOrderKey::set_name(const char *name) {
+  this->name = name;
+  lock_class = -1;
+}
+
+LockOrderChecker::LockOrderChecker(void) :
+    class_count(0),
+    violation_count(0),
+    untracked_count(0),
+    output(&Serial),
+    lock(portMUX_INITIALIZER_UNLOCKED) {
+  memset(class_names, 0, sizeof(class_names));
+  memset(successors, 0, sizeof(successors));
+  memset(held_locks, 0, sizeof(held_locks));
+  memset(&last_violation, 0, sizeof(last_violation));
+}
+
+void LockOrderChecker::acquiring(LockOrderKey& key) {
+  if (!key.name) {
+    return;
+  }
+  TaskHandle_t task = xTaskGetCurrentTaskHandle();
+  Violation violation;
+  violation.task_name = pcTaskGetName(NULL);
+  bool violated = false;
+
+  portENTER_CRITICAL(&lock);
+  int lock_class = resolve(key);
+  HeldLocks *held = held_by(task);
+  if (0 <= lock_class && held) {
+    uint32_t lock_class_bit = 1UL << lock_class;
+    for (size_t i = 0; i < held->count; ++i) {
+      int held_class = held->lock_classes[i];
+      if (successors[held_class] & lock_class_bit) {
+        continue;  // Known edge, checked when it was recorded.
+      }
+      if (!violated) {
+        violation.cycle[0] = class_names[held_class];
+        violation.cycle_length = 1;
+        if (held_class == lock_class) {
+          violation.cycle[violation.cycle_length++] =
+              class_names[held_class];
+          violated = true;
+        } else {
+          violated = find_path(lock_class, held_class, &violation);
+        }
+      }
+      successors[held_class] |= lock_class_bit;
+    }
+    if (violated) {
+      ++violation_count;
+      last_violation = violation;
+    }
+  } else if (lock_class < 0) {
+    ++untracked_count;
+  }
+  portEXIT_CRITICAL(&lock);
+
+  if (violated) {
+    report(violation);
+  }
+}
+
+void LockOrderChecker::acquired(LockOrderKey& key) {
+  // acquiring() counted unnamed and unclassified locks.
+  if (key.lock_class < 0) {
+    return;
+  }
+  TaskHandle_t task = xTaskGetCurrentTaskHandle();
+  portENTER_CRITICAL(&lock);
+  HeldLocks *held = held_by(task);
+  if (!held) {
+    held = held_by(NULL);  // Find a free entry
+    if (held) {
+      held->task = task;
+      held->count = 0;
+    }
+  }
+  if (held && held->count < MAX_HELD_LOCKS) {
+    held->lock_classes[held->count++] = key.lock_class;
+  } else {
+    ++untracked_count;
+    if (held && !held->count) {
+      held->task = NULL;
+    }
+  }
+  portEXIT_CRITICAL(&lock);
+}
+
+bool LockOrderChecker::find_path(int from, int to, Violation *violation) {
+  // Breadth first search, so the reported cycle is as short as possible.
+  int8_t previous[MAX_LOCK_CLASSES];
+  int queue[MAX_LOCK_CLASSES];
+  size_t head = 0;
+  size_t tail = 0;
+  uint32_t visited = 1UL << from;
+  previous[from] = -1;
+  queue[tail++] = from;
+  bool found = false;
+  while (!found && head < tail) {
+    int current = queue[head++];
+    uint32_t unvisited = successors[current] & ~visited;
+    while (unvisited) {
+      int next = __builtin_ctz(unvisited);
+      unvisited &= unvisited - 1;
+      visited |= 1UL << next;
+      previous[next] = current;
+      queue[tail++] = next;
+      if (next == to) {
+        found = true;
+        break;
+      }
+    }
+  }
+
+  if (found) {
+    // Walk back from to, then append the path in forward order.
+    int path[MAX_LOCK_CLASSES];
+    size_t length = 0;
+    for (int lock_class = to; 0 <= lock_class;
+        lock_class = previous[lock_class]) {
+      path[length++] = lock_class;
+    }
+    while (length) {
+      violation->cycle[violation->cycle_length++] =
+          class_names[path[--length]];
+    }
+  }
+  return found;
+}
+
+LockOrderChecker::HeldLocks *LockOrderChecker::held_by(TaskHandle_t task) {
+  for (size_t i = 0; i < MAX_TASKS; ++i) {
+    if (held_locks[i].task == task) {
+      return held_locks + i;
+    }
+  }
+  return NULL;
+}
+
+size_t LockOrderChecker::lock_class_count(void) {
+  portENTER_CRITICAL(&lock);
+  size_t result = class_count;
+  portEXIT_CRITICAL(&lock);
+  return result;
+}
+
+bool LockOrderChecker::most_recent_violation(Violation *violation) {
+  portENTER_CRITICAL(&lock);
+  bool found = 0 < violation_count;
+  if (found) {
+    *violation = last_violation;
+  }
+  portEXIT_CRITICAL(&lock);
+  return found;
+}
+
+void LockOrderChecker::print_graph(Print& out) {
+  const char *names[MAX_LOCK_CLASSES];
+  uint32_t edges[MAX_LOCK_CLASSES];
+  // Printing can block, so copy the graph before printing it.
+  portENTER_CRITICAL(&lock);
+  size_t count = class_count;
+  memcpy(names, class_names, sizeof(names));
+  memcpy(edges, successors, sizeof(edges));
+  portEXIT_CRITICAL(&lock);
+
+  out.printf("Lock order graph, %u lock classes:\n",
+      static_cast<unsigned>(count));
+  for (size_t from = 0; from < count; ++from) {
+    for (size_t to = 0; to < count; ++to) {
+      if (edges[from] & (1UL << to)) {
+        out.printf("  %s -> %s\n", names[from], names[to]);
+      }
+    }
+  }
+}
+
+void LockOrderChecker::released(LockOrderKey& key) {
+  if (key.lock_class < 0) {
+    return;
+  }
+  TaskHandle_t task = xTaskGetCurrentTaskHandle();
+  portENTER_CRITICAL(&lock);
+  HeldLocks *held = held_by(task);
+  if (held) {
+    // Locks are usually released in reverse order, so search from the
+    // most recently acquired.
+    for (size_t i = held->count; 0 < i; --i) {
+      if (held->lock_classes[i - 1] == key.lock_class) {
+        memmove(
+            held->lock_classes + i - 1,
+            held->lock_classes + i,
+            (held->count - i) * sizeof(held->lock_classes[0]));
+        --held->count;
+        break;
+      }
+    }
+    if (!held->count) {
+      held->task = NULL;
+    }
+  }
+  portEXIT_CRITICAL(&lock);
+}
+
+void LockOrderChecker::report(const Violation& violation) {
+  Print *out = output;
+  if (!out) {
+    return;
+  }
+  out->printf(
+      "Lock order violation in task %s: locking %s while holding %s "
+      "closes the cycle ",
+      violation.task_name ? violation.task_name : "(unknown)",
+      violation.cycle[1],
+      violation.cycle[0]);
+  out->printf("%s", violation.cycle[0]);
+  for (size_t i = 1; i < violation.cycle_length; ++i) {
+    out->printf(" -> %s", violation.cycle[i]);
+  }
+  out->printf("\n");
+}
+
+void LockOrderChecker::reset(void) {
+  portENTER_CRITICAL(&lock);
+  memset(successors, 0, sizeof(successors));
+  violation_count = 0;
+  untracked_count = 0;
+  memset(&last_violation, 0, sizeof(last_violation));
+  portEXIT_CRITICAL(&lock);
+}
+
+int LockOrderChecker::resolve(LockOrderKey& key) {
+  if (key.lock_class < 0 && key.name) {
+    for (size_t i = 0; i < class_count; ++i) {
+      if (!strcmp(class_names[i], key.name)) {
+        key.lock_class = i;
+        break;
+      }
+    }
+    if (key.lock_class < 0 && class_count < MAX_LOCK_CLASSES) {
+      class_names[class_count] = key.name;
+      key.lock_class = class_count++;
+    }
+  }
+  return key.lock_class;
+}
+
+void LockOrderChecker::set_output(Print *output) {
+  this->output = output;
+}
+
+#endif /* RTOSAID_LOCK_ORDER_CHECKING */
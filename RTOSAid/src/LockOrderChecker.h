@@ -0,0 +1,220 @@
+/*
+ * LockOrderChecker.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Optional lock order checking, a debugging aid in the spirit of the
+ * Linux kernel's lockdep. When RTOSAID_LOCK_ORDER_CHECKING is turned on
+ * (see RTOSAidConfig.h), every MutexLock on a named Mutex or MutexH
+ * reports to the LockOrder checker, which
+ *
+ * 1. tracks the named locks that each task holds,
+ * 2. records an edge A -> B in a lock dependency graph whenever a task
+ *    locks B while holding A, and
+ * 3. reports a violation the first time a new edge closes a cycle.
+ *
+ * A cycle means that two or more tasks can deadlock by locking the same
+ * mutexes in different orders, so the checker reports it even if no
+ * deadlock actually happened. Edges are recorded before the task waits
+ * for the lock, so a cycle is reported even if the lock then deadlocks.
+ *
+ * Locks are identified by name, so every mutex with the same name
+ * belongs to the same lock class. Name mutexes with set_name(); unnamed
+ * mutexes are not checked. Locking two mutexes of the same class at the
+ * same time is reported as a cycle of length 1.
+ *
+ * Violations are printed to Serial by default. Use set_output() to
+ * redirect or silence them.
+ *
+ * The checker costs a spinlock and a table search on every lock and
+ * unlock, so it is meant for debug builds. Release builds, with the
+ * option off, do not even contain the LockOrder instance.
+ */
+
+#ifndef SRC_LOCKORDERCHECKER_H_
+#define SRC_LOCKORDERCHECKER_H_
+
+#include "Arduino.h"
+
+#include "RTOSAidConfig.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/**
+ * Identifies a lock to the checker. Every checked lock embeds one.
+ */
+class LockOrderKey final {
+  friend class LockOrderChecker;
+
+  const char *name;
+  int lock_class;  // Index into the lock class table, -1 if not yet known
+
+public:
+  LockOrderKey(void);
+
+  /**
+   * Sets the lock's name. The name must outlive the lock, and is
+   * compared by value, so locks with equal names form a single class.
+   */
+  void set_name(const char *name);
+};
+
+class LockOrderChecker final {
+public:
+  static const size_t MAX_LOCK_CLASSES = 32;
+  static const size_t MAX_TASKS = 32;
+  static const size_t MAX_HELD_LOCKS = 8;
+
+  /**
+   * A detected cycle. cycle[0] is the lock that the task held, cycle[1]
+   * is the lock that it tried to lock, and the remaining entries follow
+   * the recorded edges back to cycle[0], which is repeated at the end.
+   */
+  struct Violation {
+    const char *task_name;
+    const char *cycle[MAX_LOCK_CLASSES + 2];
+    size_t cycle_length;
+  };
+
+private:
+  // The named locks that a task holds, in locking order.
+  struct HeldLocks {
+    TaskHandle_t task;                // NULL if the entry is free
+    size_t count;
+    int lock_classes[MAX_HELD_LOCKS];
+  };
+
+  const char *class_names[MAX_LOCK_CLASSES];
+  // Bit n of successors[m] is set if class n was locked while class m
+  // was held.
+  uint32_t successors[MAX_LOCK_CLASSES];
+  size_t class_count;
+  HeldLocks held_locks[MAX_TASKS];
+  uint32_t violation_count;
+  uint32_t untracked_count;
+  Violation last_violation;
+  Print *output;
+  portMUX_TYPE lock;
+
+  LockOrderChecker(const LockOrderChecker&) = delete;
+  LockOrderChecker& operator=(const LockOrderChecker&) = delete;
+
+  /**
+   * Searches the graph for a path between two lock classes and, if one
+   * exists, appends it to violation->cycle. The caller must hold the
+   * lock.
+   *
+   * Returns: true if to can be reached from from.
+   */
+  bool find_path(int from, int to, Violation *violation);
+
+  /**
+   * Returns: the held lock entry for the specified task, or NULL if the
+   *          task holds no named locks. The caller must hold the lock.
+   */
+  HeldLocks *held_by(TaskHandle_t task);
+
+  /**
+   * Prints a violation to the output, if any. The caller must NOT hold
+   * the lock.
+   */
+  void report(const Violation& violation);
+
+  /**
+   * Returns: the key's lock class, assigning one if need be, or -1 if
+   *          the key is unnamed or the class table is full. The caller
+   *          must hold the lock.
+   */
+  int resolve(LockOrderKey& key);
+
+public:
+  LockOrderChecker(void);
+
+  /**
+   * Records the edges from every lock that the invoking task holds to
+   * the specified lock, reporting a violation if one closes a cycle.
+   * Locks invoke this before waiting for the lock.
+   */
+  void acquiring(LockOrderKey& key);
+
+  /**
+   * Adds the specified lock to the set of locks held by the invoking
+   * task. Locks invoke this after the lock succeeds.
+   */
+  void acquired(LockOrderKey& key);
+
+  /**
+   * Returns: the number of lock classes seen so far.
+   */
+  size_t lock_class_count(void);
+
+  /**
+   * Retrieves the most recent violation.
+   *
+   * Returns: true if *violation was filled in, false if no violation has
+   *          been detected.
+   */
+  bool most_recent_violation(Violation *violation);
+
+  /**
+   * Prints every recorded edge of the lock dependency graph.
+   */
+  void print_graph(Print& out);
+
+  /**
+   * Removes the specified lock from the set of locks held by the invoking
+   * task. Locks invoke this before they unlock.
+   */
+  void released(LockOrderKey& key);
+
+  /**
+   * Forgets the recorded graph and violations. Held locks are still
+   * tracked, as their owners will release them.
+   */
+  void reset(void);
+
+  /**
+   * Sets where violations are printed. Pass NULL to stop printing them.
+   */
+  void set_output(Print *output);
+
+  /**
+   * Returns: the number of lock operations that went unchecked because a
+   *          table was full. Raise the corresponding limit if this is not
+   *          zero.
+   */
+  inline uint32_t untracked(void) const {
+    return untracked_count;
+  }
+
+  /**
+   * Returns: the number of cycles detected since the last reset.
+   */
+  inline uint32_t violations(void) const {
+    return violation_count;
+  }
+};
+
+#if RTOSAID_LOCK_ORDER_CHECKING
+extern LockOrderChecker LockOrder;
+#endif
+
+#endif /* SRC_LOCKORDERCHECKER_H_ */
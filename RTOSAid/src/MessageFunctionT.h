@@ -0,0 +1,50 @@
+/*
+ * MessageFunctionT.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A function object that consumes a single message of type T. It is the
+ * typed counterpart of VoidFunction, and serves as the per-queue handler
+ * in a QueueSetWaiter.
+ */
+
+#ifndef SRC_MESSAGEFUNCTIONT_H_
+#define SRC_MESSAGEFUNCTIONT_H_
+
+template <class T> class MessageFunctionT {
+public:
+  MessageFunctionT() {}
+  virtual ~MessageFunctionT() {}
+
+  /**
+   * Processes a message. Subclasses must implement this function,
+   * which MUST return.
+   *
+   * Parameters:
+   *
+   * Name     Contents
+   * -------- ---------------------------------------------------------------
+   * message  The message to process. The reference is only valid for
+   *          the duration of the call.
+   */
+  virtual void apply(const T& message) = 0;
+};
+
+#endif /* SRC_MESSAGEFUNCTIONT_H_ */
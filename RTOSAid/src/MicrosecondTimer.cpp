@@ -23,6 +23,12 @@
  * Note that esp_timer_stop() returns ESP_ERR_INVALID_STATE if it is called
  * while the timer is not running. If we simply want to stop the timer and
  * don't care if it has already stopped, the error is harmless.
+ *
+ * Conversely, esp_timer_start_once() and esp_timer_start_periodic() return
+ * ESP_ERR_INVALID_STATE if the timer is running. The ESP timer API is
+ * thread-safe, so rather than serializing starts with a mutex, restart()
+ * stops the timer and retries a few times if another task started it in
+ * between.
  */
 
 #include "MicrosecondTimer.h"
@@ -37,14 +43,25 @@ MicrosecondTimer::~MicrosecondTimer() {
 }
 
 bool MicrosecondTimer::begin(void) {
-  bool result = h_timer == NULL && mutex.begin();
+  bool result = h_timer == NULL;
+#if !CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
+  if (dispatch_method == ISR) {
+    Serial.println("ISR timer dispatch is not configured.");
+    result = false;
+  }
+#endif
   if (result) {
     Serial.println("Creating the timer.");
     esp_timer_create_args_t timer_create_args;
     memset(&timer_create_args, 0, sizeof(timer_create_args));
     timer_create_args.callback = timer_callback;
     timer_create_args.arg = this;
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
+    timer_create_args.dispatch_method =
+        dispatch_method == ISR ? ESP_TIMER_ISR : ESP_TIMER_TASK;
+#else
     timer_create_args.dispatch_method = ESP_TIMER_TASK;
+#endif
     timer_create_args.name = timer_name;
     timer_create_args.skip_unhandled_events = true;
     esp_err_t create_result = esp_timer_create(&timer_create_args, &h_timer);
@@ -58,39 +75,55 @@ bool MicrosecondTimer::end(void) {
   bool result = (esp_timer_delete(h_timer) == ESP_OK);
   if (result) {
     h_timer = NULL;
+    timer_state.set(STOPPED);
   }
   return result;
 }
 
-bool MicrosecondTimer::start(uint64_t timeout_in_microseconds) {
-  MutexLock lock(mutex);
-  bool result = h_timer != NULL;
-  if (result) {
-    stop_if_running();
-    result = (esp_timer_start_once(h_timer, timeout_in_microseconds) == ESP_OK);
-    if (result) {
-      timer_state = TimerState::RUNNING;
-    }
+bool MicrosecondTimer::restart(uint64_t microseconds, bool periodic) {
+  if (!h_timer) {
+    return false;
   }
-  return result;
+  esp_err_t start_result = ESP_ERR_INVALID_STATE;
+  for (int attempt = 0;
+      attempt < START_ATTEMPTS && start_result == ESP_ERR_INVALID_STATE;
+      ++attempt) {
+    esp_timer_stop(h_timer);  // ESP_ERR_INVALID_STATE is harmless; see above.
+    // Mark the timer running before it starts, so that a one shot that
+    // fires at once is marked stopped.
+    timer_state.set(periodic ? RUNNING_PERIODIC : RUNNING_ONCE);
+    start_result = periodic
+        ? esp_timer_start_periodic(h_timer, microseconds)
+        : esp_timer_start_once(h_timer, microseconds);
+  }
+  if (start_result != ESP_OK && start_result != ESP_ERR_INVALID_STATE) {
+    // ESP_ERR_INVALID_STATE means that another task's start won, and the
+    // timer is running as that task started it.
+    timer_state.set(STOPPED);
+  }
+  return start_result == ESP_OK;
 }
 
-void MicrosecondTimer::stop(void) {
-  MutexLock lock(mutex);
-  stop_if_running();
+bool MicrosecondTimer::start(uint64_t timeout_in_microseconds) {
+  return restart(timeout_in_microseconds, false);
 }
 
-void MicrosecondTimer::stop_if_running() {
-  if (timer_state == RUNNING) {
+bool MicrosecondTimer::start_periodic(uint64_t period_us) {
+  return restart(period_us, true);
+}
+
+void MicrosecondTimer::stop(void) {
+  if (h_timer) {
     esp_timer_stop(h_timer);
-    timer_state = STOPPED;
   }
+  timer_state.set(STOPPED);
 }
 
-void MicrosecondTimer::timer_expired(void) {
+void IRAM_ATTR MicrosecondTimer::timer_expired(void) {
+  timer_state.compare_and_set(RUNNING_ONCE, STOPPED);
   target_function->apply();
 }
 
-void MicrosecondTimer::timer_callback(void *params) {
+void IRAM_ATTR MicrosecondTimer::timer_callback(void *params) {
   static_cast<MicrosecondTimer *>(params)->timer_expired();
 }
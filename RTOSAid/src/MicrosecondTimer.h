@@ -4,9 +4,19 @@
  *  Created on: Jul 10, 2023
  *      Author: Eric Mintz
  *
- * A microsecond resolution one shot timer that invokes an action when it
- * fires. The action is set at construction. Note that this class is
- * multitasking-safe and thread-safe.
+ * A microsecond resolution timer that invokes an action when it fires,
+ * either once or periodically. The action is set at construction. Note
+ * that this class is multitasking-safe and thread-safe.
+ *
+ * By default, the ESP timer task invokes the action, which adds a task
+ * switch to every expiration. Timers created with the ISR dispatch method
+ * invoke the action directly from the timer interrupt, which is faster and
+ * unaffected by busy high priority tasks, but restricts the action to what
+ * an interrupt service routine can do. ISR dispatch requires
+ * CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD; begin() fails without it.
+ *
+ * Starting and stopping take no locks beyond those inside the ESP timer
+ * API, so they are cheap enough to invoke on every event.
  *
  * Copyright (C) 2023 Eric Mintz
  * All Rights Reserved
@@ -30,7 +40,7 @@
 #define MICROSECONDTIMER_H_
 
 #include "Arduino.h"
-#include "Mutex.h"
+#include "AtomicStateT.h"
 #include "esp_timer.h"
 #include "VoidFunction.h"
 
@@ -39,34 +49,51 @@ class TimerAction;
 class MicrosecondTimer final {
 public:
   enum TimerState {
-    RUNNING,
+    RUNNING_ONCE,      // Started by start() and not yet fired
+    RUNNING_PERIODIC,  // Started by start_periodic()
     STOPPED,
   };
+
+  /**
+   * How the timer invokes its action
+   */
+  enum DispatchMethod {
+    TASK,  // From the ESP timer task
+    ISR,   // From the timer interrupt
+  };
 private:
+  // How many times restart() tries to start the timer when another task
+  // keeps starting it first.
+  static const int START_ATTEMPTS = 4;
+
   const char *timer_name;
   VoidFunction *target_function;
+  const DispatchMethod dispatch_method;
   esp_timer_handle_t h_timer;
-  TimerState timer_state;
-  Mutex mutex;
+  // Set before the timer starts, so the expiration that the start
+  // schedules sees the matching mode.
+  AtomicStateT<TimerState> timer_state;
 
   /**
-   * Stops the timer if it is running, and does nothing otherwise. To avoid
-   * race conditions, callers must hold the mutex before they invoke this
-   * method.
+   * Starts the timer, first stopping it if it is running. If other tasks
+   * keep starting the timer in between, gives up after START_ATTEMPTS
+   * tries, leaving the timer as they started it.
+   *
+   * Returns: true on success, false on failure.
    */
-  void stop_if_running(void);
+  bool restart(uint64_t microseconds, bool periodic);
 
   /**
    * Invoked when the timer fires. User is responsible for implementing
    * multi-task and thread safety if required.
    */
-  static void timer_callback(void *params);
+  static void IRAM_ATTR timer_callback(void *params);
 
   /**
    * Invokes the bound Action. Note that the timer callback
    * invokes this.
    */
-  void timer_expired(void);
+  void IRAM_ATTR timer_expired(void);
 
 public:
   /**
@@ -80,17 +107,23 @@ public:
    * name            Timer name, a NULL-terminated string containing the
    *                 timer's name for display in debug and error messages.
    * target_function A VoidFunction subclass containing the code to run when
-   *                 the timer fires. Note: the function is invoked from an
-   *                 ISR. Keep it short and do NOT block.
+   *                 the timer fires. Keep it short and do NOT block.
+   * dispatch_method TASK, the default, to invoke target_function from the
+   *                 ESP timer task, or ISR to invoke it from the timer
+   *                 interrupt. An ISR dispatched function must follow the
+   *                 rules for interrupt service routines: it must use
+   *                 the _from_isr() or _from_ISR() API variants and MUST
+   *                 reside in IRAM.
    */
   MicrosecondTimer(
       const char *timer_name,
-      VoidFunction *target_function) :
+      VoidFunction *target_function,
+      DispatchMethod dispatch_method = TASK) :
         timer_name(timer_name),
         target_function(target_function),
+        dispatch_method(dispatch_method),
         h_timer(NULL),
-        timer_state(STOPPED),
-        mutex() {
+        timer_state(STOPPED) {
   }
 
   virtual ~MicrosecondTimer();
@@ -116,13 +149,52 @@ public:
 
   bool start(uint64_t timeout_in_microseconds);
 
+  /**
+   * Starts the timer running periodically, invoking the function once per
+   * period until stopped. If the timer is already running, it restarts
+   * with the new period. Periods are measured from the start, so
+   * expirations do not drift.
+   *
+   * Parameters
+   *
+   * Name            Contents
+   * -----------     -----------------------------------------------------
+   * period_us       The period in microseconds. The ESP timer API
+   *                 requires at least 50 microseconds.
+   *
+   * Returns: true on success, false on failure.
+   */
+  bool start_periodic(uint64_t period_us);
+
   /**
    * Stops the timer.
    */
   void stop(void);
 
+  /**
+   * Returns: how the timer invokes its function.
+   */
+  DispatchMethod dispatch(void) const {
+    return dispatch_method;
+  }
+
+  /**
+   * Returns: true if the timer has been started and has neither been
+   *          stopped nor, when started by start(), fired. The value is a
+   *          snapshot and may be stale.
+   */
+  bool running() {
+    return !timer_state.is(STOPPED);
+  }
+
+  /**
+   * Returns: RUNNING_ONCE if the timer was started by start() and has
+   *          neither been stopped nor fired, RUNNING_PERIODIC if it was
+   *          started by start_periodic() and has not been stopped, and
+   *          STOPPED otherwise. The value is a snapshot and may be stale.
+   */
   TimerState state() {
-    return timer_state;
+    return timer_state();
   }
 };
 
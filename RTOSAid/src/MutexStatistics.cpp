@@ -0,0 +1,165 @@
+/*
+ * MutexStatistics.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "MutexStatistics.h"
+
+#include "esp_timer.h"
+
+#include <string.h>
+
+#if RTOSAID_MUTEX_STATISTICS
+
+MutexInstrumentationRegistry MutexRegistry;
+
+static void copy_task_name(char *destination, const char *source) {
+  strncpy(destination, source, configMAX_TASK_NAME_LEN - 1);
+  destination[configMAX_TASK_NAME_LEN - 1] = '\0';
+}
+
+MutexInstrumentation::MutexInstrumentation(void) :
+    name(NULL),
+    lock(portMUX_INITIALIZER_UNLOCKED),
+    locked_at_micros(0),
+    next(NULL),
+    registered(false) {
+  holder[0] = '\0';
+  reset();
+}
+
+MutexInstrumentation::~MutexInstrumentation() {
+  MutexRegistry.remove(this);
+}
+
+void MutexInstrumentation::copy_statistics(MutexStatistics *snapshot) {
+  int64_t now = esp_timer_get_time();
+  portENTER_CRITICAL(&lock);
+  snapshot->name = name;
+  snapshot->lock_count = lock_count;
+  snapshot->contended_count = contended_count;
+  snapshot->failed_count = failed_count;
+  snapshot->wait_micros = wait_micros;
+  snapshot->hold_micros = hold_micros;
+  copy_task_name(snapshot->longest_wait_holder, longest_wait_holder);
+  copy_task_name(snapshot->longest_hold_task, longest_hold_task);
+  snapshot->elapsed_micros = now - reset_at_micros;
+  portEXIT_CRITICAL(&lock);
+}
+
+bool MutexInstrumentation::lock_mutex(
+    SemaphoreHandle_t semaphore, TickType_t timeout) {
+  bool locked = xSemaphoreTake(semaphore, 0) == pdTRUE;
+  bool contended = !locked;
+  uint32_t waited_micros = 0;
+  char blocked_by[configMAX_TASK_NAME_LEN];
+  blocked_by[0] = '\0';
+  if (!locked && timeout) {
+    // Note the task that we are about to wait for. It might unlock before
+    // we start waiting, so the name is a best guess.
+    portENTER_CRITICAL(&lock);
+    copy_task_name(blocked_by, holder);
+    portEXIT_CRITICAL(&lock);
+    int64_t start = esp_timer_get_time();
+    locked = xSemaphoreTake(semaphore, timeout) == pdTRUE;
+    waited_micros = static_cast<uint32_t>(esp_timer_get_time() - start);
+  }
+  const char *task_name = pcTaskGetName(NULL);
+  int64_t now = esp_timer_get_time();
+  portENTER_CRITICAL(&lock);
+  if (locked) {
+    ++lock_count;
+    if (contended) {
+      ++contended_count;
+    }
+    if (wait_micros.maximum() < waited_micros) {
+      copy_task_name(longest_wait_holder, blocked_by);
+    }
+    wait_micros.record(waited_micros);
+    copy_task_name(holder, task_name);
+    locked_at_micros = now;
+  } else {
+    ++failed_count;
+  }
+  portEXIT_CRITICAL(&lock);
+  return locked;
+}
+
+void MutexInstrumentation::print_statistics(
+    Print& out, const MutexStatistics& snapshot) {
+  out.printf(
+      "%s: locked %lu, contended %lu, failed %lu, "
+      "wait us p50 %lu p99 %lu max %lu (holder %s), "
+      "hold us p50 %lu p99 %lu max %lu (by %s)\n",
+      snapshot.name ? snapshot.name : "(unnamed)",
+      static_cast<unsigned long>(snapshot.lock_count),
+      static_cast<unsigned long>(snapshot.contended_count),
+      static_cast<unsigned long>(snapshot.failed_count),
+      static_cast<unsigned long>(snapshot.wait_micros.percentile(50.0f)),
+      static_cast<unsigned long>(snapshot.wait_micros.percentile(99.0f)),
+      static_cast<unsigned long>(snapshot.wait_micros.maximum()),
+      snapshot.longest_wait_holder[0]
+          ? snapshot.longest_wait_holder : "-",
+      static_cast<unsigned long>(snapshot.hold_micros.percentile(50.0f)),
+      static_cast<unsigned long>(snapshot.hold_micros.percentile(99.0f)),
+      static_cast<unsigned long>(snapshot.hold_micros.maximum()),
+      snapshot.longest_hold_task[0]
+          ? snapshot.longest_hold_task : "-");
+}
+
+void MutexInstrumentation::reset(void) {
+  portENTER_CRITICAL(&lock);
+  lock_count = 0;
+  contended_count = 0;
+  failed_count = 0;
+  wait_micros.clear();
+  hold_micros.clear();
+  longest_wait_holder[0] = '\0';
+  longest_hold_task[0] = '\0';
+  reset_at_micros = esp_timer_get_time();
+  portEXIT_CRITICAL(&lock);
+}
+
+void MutexInstrumentation::snapshot(MutexStatistics *snapshot) {
+  copy_statistics(snapshot);
+}
+
+void MutexInstrumentation::start(void) {
+  reset();
+  MutexRegistry.add(this);
+}
+
+void MutexInstrumentation::unlock_mutex(SemaphoreHandle_t semaphore) {
+  // Record before giving the semaphore away, while locked_at_micros and
+  // holder still describe the caller.
+  int64_t now = esp_timer_get_time();
+  portENTER_CRITICAL(&lock);
+  uint32_t held_micros = static_cast<uint32_t>(now - locked_at_micros);
+  if (hold_micros.maximum() < held_micros) {
+    copy_task_name(longest_hold_task, holder);
+  }
+  hold_micros.record(held_micros);
+  holder[0] = '\0';
+  portEXIT_CRITICAL(&lock);
+  xSemaphoreGive(semaphore);
+}
+
+#endif /* RTOSAID_MUTEX_STATISTICS */
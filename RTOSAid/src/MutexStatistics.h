@@ -0,0 +1,163 @@
+/*
+ * MutexStatistics.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Optional mutex instrumentation. When RTOSAID_MUTEX_STATISTICS is turned
+ * on (see RTOSAidConfig.h), every Mutex and MutexH records
+ *
+ * * the number of times it was locked, how many of those locks had to
+ *   wait because another task held the mutex, and how many lock
+ *   attempts timed out,
+ * * a histogram of the time spent waiting for the lock,
+ * * a histogram of the time the lock was held, and
+ * * the task that held the lock during the longest wait, and the task
+ *   that held it the longest.
+ *
+ * Mutexes register themselves with the MutexRegistry when they begin(),
+ * so an application can dump every mutex's statistics with a single
+ * call. Name mutexes with set_name() so that reports identify them.
+ * With the option off, MutexRegistry is not defined at all.
+ *
+ * To keep the fast path fast, a lock first tries without waiting. Only
+ * a lock that must wait is timed.
+ */
+
+#ifndef SRC_MUTEXSTATISTICS_H_
+#define SRC_MUTEXSTATISTICS_H_
+
+#include "Arduino.h"
+
+#include "InstrumentationRegistryT.h"
+#include "LatencyHistogram.h"
+#include "RTOSAidConfig.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+/**
+ * A point in time snapshot of a mutex's statistics.
+ */
+struct MutexStatistics {
+  const char *name;                   // Mutex name, possibly NULL
+  uint32_t lock_count;                // Successful locks
+  uint32_t contended_count;           // Locks that had to wait
+  uint32_t failed_count;              // Lock attempts that timed out
+  LatencyHistogram wait_micros;       // Time spent waiting for the lock
+  LatencyHistogram hold_micros;       // Time the lock was held
+  char longest_wait_holder[configMAX_TASK_NAME_LEN];
+                                      // Held the lock during longest wait
+  char longest_hold_task[configMAX_TASK_NAME_LEN];
+                                      // Held the lock the longest
+  int64_t elapsed_micros;             // Time since the last reset
+};
+
+/**
+ * Statistics gatherer embedded in an instrumented mutex. The mutex routes
+ * its lock and unlock calls through an instance, which times and counts
+ * them. Updates are guarded by a spinlock, so other tasks can take
+ * snapshots safely.
+ */
+class MutexInstrumentation final {
+  template <class I, class S> friend class InstrumentationRegistryT;
+
+  const char *name;
+  portMUX_TYPE lock;
+  uint32_t lock_count;
+  uint32_t contended_count;
+  uint32_t failed_count;
+  LatencyHistogram wait_micros;
+  LatencyHistogram hold_micros;
+
+  // The current holder's name and when it took the lock. Only one task
+  // holds the lock at a time, so one copy suffices.
+  char holder[configMAX_TASK_NAME_LEN];
+  int64_t locked_at_micros;
+
+  char longest_wait_holder[configMAX_TASK_NAME_LEN];
+  char longest_hold_task[configMAX_TASK_NAME_LEN];
+  int64_t reset_at_micros;
+  MutexInstrumentation *next;
+  bool registered;
+
+  MutexInstrumentation(const MutexInstrumentation&) = delete;
+  MutexInstrumentation& operator=(const MutexInstrumentation&) = delete;
+
+  void copy_statistics(MutexStatistics *snapshot);
+
+  static void print_statistics(Print& out, const MutexStatistics& snapshot);
+
+public:
+  MutexInstrumentation(void);
+
+  /**
+   * Removes this instance from the registry if it is registered.
+   */
+  ~MutexInstrumentation();
+
+  /**
+   * Locks the specified mutex semaphore, timing any wait.
+   */
+  bool lock_mutex(SemaphoreHandle_t semaphore, TickType_t timeout);
+
+  /**
+   * Discards all statistics gathered so far.
+   */
+  void reset(void);
+
+  /**
+   * Sets the name that identifies the mutex in reports. The name must
+   * outlive the mutex.
+   */
+  inline void set_name(const char *name) {
+    this->name = name;
+  }
+
+  /**
+   * Copies the current statistics into *snapshot.
+   */
+  void snapshot(MutexStatistics *snapshot);
+
+  /**
+   * Resets the statistics and registers this instance with the
+   * MutexRegistry. Instrumented mutexes invoke this from begin().
+   */
+  void start(void);
+
+  /**
+   * Records how long the lock was held and unlocks the specified mutex
+   * semaphore. Only the task that holds the lock may invoke this.
+   */
+  void unlock_mutex(SemaphoreHandle_t semaphore);
+};
+
+/**
+ * The set of all started, instrumented mutexes. Use MutexRegistry, the
+ * library's singleton instance, rather than creating one. See
+ * InstrumentationRegistryT.h.
+ */
+typedef InstrumentationRegistryT<MutexInstrumentation, MutexStatistics>
+    MutexInstrumentationRegistry;
+
+#if RTOSAID_MUTEX_STATISTICS
+extern MutexInstrumentationRegistry MutexRegistry;
+#endif
+
+#endif /* SRC_MUTEXSTATISTICS_H_ */
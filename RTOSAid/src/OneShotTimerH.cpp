@@ -46,6 +46,9 @@ void OneShotTimerH::timer_callback(TimerHandle_t timer_handle) {
 }
 
 void OneShotTimerH::on_timer_expired(void) {
+  if (TimerCoalescer *coalescer = TimerCoalescer::shared_if_constructed()) {
+    coalescer->record_expiration();
+  }
   on_expiration_.apply();
 }
 
@@ -65,8 +68,21 @@ bool OneShotTimerH::begin(void) {
 
 
 bool OneShotTimerH::start_ticks(
-    TickType_t timeout_ticks, TickType_t wait_time) {
-  return xTimerChangePeriod(h_timer, timeout_ticks, wait_time);
+    TickType_t timeout_ticks,
+    TickType_t wait_time,
+    TickType_t slack_ticks) {
+  if (!slack_ticks) {
+    return xTimerChangePeriod(h_timer, timeout_ticks, wait_time);
+  }
+  // The coalescer chooses a tick relative to the current tick, but the
+  // timer service measures a changed period from the tick on which it
+  // processes the change, which can be later. A start is measured from
+  // the tick on which it was sent, so restart the timer after changing
+  // its period.
+  timeout_ticks =
+      TimerCoalescer::shared().coalesce(timeout_ticks, slack_ticks);
+  return xTimerChangePeriod(h_timer, timeout_ticks, wait_time)
+      && xTimerStart(h_timer, wait_time);
 }
 
 bool OneShotTimerH::start_ticks_from_isr(TickType_t timeout_ticks) {
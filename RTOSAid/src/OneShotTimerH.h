@@ -8,6 +8,10 @@
  * FreeRTOS API and has a one FreeRTOS tick resolution. Use the
  * MicrosecondTimer for higher resolution.
  *
+ * Timers that need not fire exactly on time can be started with slack,
+ * which lets the shared TimerCoalescer fire them together with other
+ * timers. See TimerCoalescer.h.
+ *
  * Copyright (C) 2025 Eric Mintz
  * All Rights Reserved
  *
@@ -31,6 +35,7 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/timers.h"
 
+#include "TimerCoalescer.h"
 #include "VoidFunction.h"
 
 /**
@@ -150,12 +155,17 @@ public:
    * timeout_ms                  The expiration time in milliseconds
    * wait_time                   Number of ticks to wait for the timer queue
    *                             to accept the request.
+   * slack_ms                    How many milliseconds late the timer may
+   *                             fire so that it can share a timer service
+   *                             wakeup with other timers. Defaults to 0,
+   *                             which fires the timer on time.
    *
    * Return: true on success, false on failure.
    */
   bool start_ms(
-      uint32_t timeout_ms, TickType_t wait_time) {
-    return start_ticks(pdMS_TO_TICKS(timeout_ms), wait_time);
+      uint32_t timeout_ms, TickType_t wait_time, uint32_t slack_ms = 0) {
+    return start_ticks(
+        pdMS_TO_TICKS(timeout_ms), wait_time, pdMS_TO_TICKS(slack_ms));
   }
 
   /**
@@ -187,11 +197,17 @@ public:
    * timeout_ticks               The expiration time in ticks
    * wait_time                   Number of ticks to wait for the timer queue
    *                             to accept the request.
+   * slack_ticks                 How many ticks late the timer may fire so
+   *                             that it can share a timer service wakeup
+   *                             with other timers. Defaults to 0, which
+   *                             fires the timer on time.
    *
    * Return: true on success, false on failure.
    */
   bool start_ticks(
-      TickType_t timeout_ticks, TickType_t wait_time);
+      TickType_t timeout_ticks,
+      TickType_t wait_time,
+      TickType_t slack_ticks = 0);
 
 
   /**
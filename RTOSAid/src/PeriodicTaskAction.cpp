@@ -0,0 +1,136 @@
+/*
+ * PeriodicTaskAction.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "PeriodicTaskAction.h"
+
+#include "esp_timer.h"
+
+PeriodicTaskAction::PeriodicTaskAction(uint32_t period_ms) :
+    period_ticks(pdMS_TO_TICKS(period_ms) ? pdMS_TO_TICKS(period_ms) : 1),
+    period_micros(period_ticks * (1000000UL / configTICK_RATE_HZ)),
+    lock(portMUX_INITIALIZER_UNLOCKED),
+    cycle_count(0),
+    overrun_count(0),
+    max_lateness_micros(0) {
+}
+
+PeriodicTaskAction::~PeriodicTaskAction() {
+}
+
+uint32_t PeriodicTaskAction::cycles(void) {
+  portENTER_CRITICAL(&lock);
+  uint32_t result = cycle_count;
+  portEXIT_CRITICAL(&lock);
+  return result;
+}
+
+void PeriodicTaskAction::jitter_histogram(LatencyHistogram *histogram) {
+  portENTER_CRITICAL(&lock);
+  *histogram = lateness_histogram;
+  portEXIT_CRITICAL(&lock);
+}
+
+uint32_t PeriodicTaskAction::max_lateness(void) {
+  portENTER_CRITICAL(&lock);
+  uint32_t result = max_lateness_micros;
+  portEXIT_CRITICAL(&lock);
+  return result;
+}
+
+uint32_t PeriodicTaskAction::overruns(void) {
+  portENTER_CRITICAL(&lock);
+  uint32_t result = overrun_count;
+  portEXIT_CRITICAL(&lock);
+  return result;
+}
+
+void PeriodicTaskAction::print_statistics(Print& out, const char *title) {
+  LatencyHistogram histogram;
+  jitter_histogram(&histogram);
+  out.printf(
+      "%s: period %lu us, %lu cycles, %lu overruns, max lateness %lu us\n",
+      title,
+      static_cast<unsigned long>(period_micros),
+      static_cast<unsigned long>(cycles()),
+      static_cast<unsigned long>(overruns()),
+      static_cast<unsigned long>(max_lateness()));
+  histogram.print(out, "Lateness", "us");
+}
+
+void PeriodicTaskAction::record_cycle(uint32_t lateness_micros, bool overran) {
+  portENTER_CRITICAL(&lock);
+  ++cycle_count;
+  if (overran) {
+    ++overrun_count;
+  }
+  if (max_lateness_micros < lateness_micros) {
+    max_lateness_micros = lateness_micros;
+  }
+  lateness_histogram.record(lateness_micros);
+  portEXIT_CRITICAL(&lock);
+}
+
+void PeriodicTaskAction::reset_statistics(void) {
+  portENTER_CRITICAL(&lock);
+  cycle_count = 0;
+  overrun_count = 0;
+  max_lateness_micros = 0;
+  lateness_histogram.clear();
+  portEXIT_CRITICAL(&lock);
+}
+
+void PeriodicTaskAction::run(void) {
+  TickType_t last_wake = xTaskGetTickCount();
+  // Start the schedule on a tick boundary. Lateness is measured against
+  // the time the first wait returned, which cancels the offset between
+  // the tick interrupt and the microsecond clock. Taking the baseline
+  // before the wait would be off by up to a tick.
+  if (!wait_until(&last_wake, 1)) {
+    return;
+  }
+  int64_t scheduled_micros = esp_timer_get_time();
+  do {
+    int64_t lateness = esp_timer_get_time() - scheduled_micros;
+    tick();
+    bool overran = period_ticks <= xTaskGetTickCount() - last_wake;
+    record_cycle(
+        0 < lateness ? static_cast<uint32_t>(lateness) : 0,
+        overran);
+    scheduled_micros += period_micros;
+  } while (wait_until(&last_wake, period_ticks));
+}
+
+bool PeriodicTaskAction::wait_until(
+    TickType_t *previous_wake, TickType_t increment) {
+  // Cancellation sets a notification bit, so waiting for a notification
+  // instead of calling vTaskDelayUntil() lets it end the wait. Other
+  // notifications end the wait as well, so keep waiting for the time
+  // remaining. Nothing is cleared, so the bits stay pending.
+  for (TickType_t elapsed = xTaskGetTickCount() - *previous_wake;
+      elapsed < increment && !cancelled();
+      elapsed = xTaskGetTickCount() - *previous_wake) {
+    xTaskNotifyWait(0, 0, NULL, increment - elapsed);
+  }
+  *previous_wake += increment;
+  return !cancelled();
+}
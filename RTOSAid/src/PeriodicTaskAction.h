@@ -0,0 +1,152 @@
+/*
+ * PeriodicTaskAction.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Base class for actions that must run at a fixed rate, e.g. control
+ * loops. Subclasses implement tick(), which the action invokes once per
+ * period. Periods are measured from the previous scheduled wakeup, as
+ * vTaskDelayUntil() does, so the time that tick() takes does not
+ * accumulate as drift. Cancelling the containing task ends the wait for
+ * the next cycle, and run() returns.
+ *
+ * The action also records how well it holds its rate:
+ *
+ * * the number of cycles run,
+ * * overruns, cycles whose tick() was still running when the next cycle
+ *   was due,
+ * * the maximum lateness, how long after its scheduled time a cycle
+ *   actually started, and
+ * * a histogram of lateness in microseconds, i.e. the jitter.
+ *
+ * After an overrun, the action runs the missed cycles back to back until
+ * it catches up, so the number of cycles always matches the elapsed time.
+ *
+ * Periods are whole scheduler ticks, 1 millisecond in the standard ESP32
+ * Arduino configuration, so a 1 kHz loop has a period of 1.
+ */
+
+#ifndef SRC_PERIODICTASKACTION_H_
+#define SRC_PERIODICTASKACTION_H_
+
+#include "Arduino.h"
+
+#include "LatencyHistogram.h"
+#include "TaskAction.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+class PeriodicTaskAction : public TaskAction {
+  const TickType_t period_ticks;
+  const uint32_t period_micros;
+  portMUX_TYPE lock;
+  uint32_t cycle_count;
+  uint32_t overrun_count;
+  uint32_t max_lateness_micros;
+  LatencyHistogram lateness_histogram;
+
+  void record_cycle(uint32_t lateness_micros, bool overran);
+
+  /**
+   * Waits until increment ticks after *previous_wake, like
+   * vTaskDelayUntil(), then advances *previous_wake by increment.
+   * Cancellation ends the wait early.
+   *
+   * Returns: true if the wait ran its course, false if the task was
+   *          cancelled.
+   */
+  bool wait_until(TickType_t *previous_wake, TickType_t increment);
+
+protected:
+  /**
+   * Constructor
+   *
+   * Parameters:
+   *
+   * Name       Contents
+   * ---------- --------------------------------------------------------------
+   * period_ms  The period in milliseconds, which must be at least one
+   *            scheduler tick.
+   */
+  PeriodicTaskAction(uint32_t period_ms);
+
+  /**
+   * Runs once per period. Subclasses must implement it. To keep the rate,
+   * tick() must return well within the period.
+   */
+  virtual void tick(void) = 0;
+
+public:
+  virtual ~PeriodicTaskAction();
+
+  /**
+   * Copies the lateness histogram, whose samples are in microseconds,
+   * into *histogram.
+   */
+  void jitter_histogram(LatencyHistogram *histogram);
+
+  /**
+   * Returns: the number of cycles run since the last reset.
+   */
+  uint32_t cycles(void);
+
+  /**
+   * Returns: the maximum lateness, in microseconds, since the last reset.
+   */
+  uint32_t max_lateness(void);
+
+  /**
+   * Returns: the number of overruns since the last reset.
+   */
+  uint32_t overruns(void);
+
+  /**
+   * Returns: the period in scheduler ticks.
+   */
+  inline TickType_t period(void) const {
+    return period_ticks;
+  }
+
+  /**
+   * Prints the cycle and overrun counts and the lateness histogram.
+   *
+   * Parameters:
+   *
+   * Name   Contents
+   * ------ -----------------------------------------------------------------
+   * out    Receives the report, typically Serial
+   * title  Identifies the action in the report
+   */
+  void print_statistics(Print& out, const char *title);
+
+  /**
+   * Discards all statistics gathered so far.
+   */
+  void reset_statistics(void);
+
+  /**
+   * Invokes tick() once per period until the containing task is
+   * cancelled. Subclasses MUST NOT override this method.
+   */
+  virtual void run(void) final;
+};
+
+#endif /* SRC_PERIODICTASKACTION_H_ */
@@ -97,6 +97,51 @@ public:
     return really_pull_message(message, pdMS_TO_TICKS(max_wait_ms));
   }
 
+  /**
+   * Retrieve and remove up to max_count messages from the queue, waiting
+   * the maximum allowable time for the first message to appear and not
+   * waiting at all for the rest. Draining a backlog this way costs a
+   * single wakeup instead of one per message.
+   *
+   * Parameters:
+   *
+   * Name        Contents
+   * ----------  --------------------------------------------------------------
+   * messages    Receives the retrieved messages. Must hold at least
+   *             max_count messages.
+   * max_count   The maximum number of messages to retrieve
+   *
+   * Returns: the number of messages retrieved.
+   */
+  inline size_t pull_messages(T *messages, size_t max_count) {
+    return really_pull_messages(messages, max_count);
+  }
+
+  /**
+   * Retrieve and remove up to max_count messages from the queue, waiting
+   * the specified time for the first message to appear and not waiting
+   * at all for the rest.
+   *
+   * Parameters:
+   *
+   * Name        Contents
+   * ----------  --------------------------------------------------------------
+   * messages    Receives the retrieved messages. Must hold at least
+   *             max_count messages.
+   * max_count   The maximum number of messages to retrieve
+   * max_wait_ms The maximum number of milliseconds to wait for the first
+   *             message. If the wait time is zero, the call returns
+   *             immediately.
+   *
+   * Returns: the number of messages retrieved, 0 if no message appeared
+   * within the wait time.
+   */
+  inline size_t pull_messages(
+      T *messages, size_t max_count, uint32_t max_wait_ms) {
+    return really_pull_messages(
+        messages, max_count, pdMS_TO_TICKS(max_wait_ms));
+  }
+
   /**
    * Add a message to the queue tail, waiting the maximum permitted time for
    * space to become available in the queue. If the call succeeds, the
@@ -140,6 +185,47 @@ public:
     return really_send_message(message, pdMS_TO_TICKS(max_wait_ms));
   }
 
+  /**
+   * Add up to count messages to the queue tail, waiting the maximum
+   * permitted time for room for the first message and not waiting at
+   * all for the rest. Sending stops when the queue is full.
+   *
+   * Parameters:
+   *
+   * Name        Contents
+   * ----------  --------------------------------------------------------------
+   * messages    The messages to send.
+   * count       The number of messages to send.
+   *
+   * Returns: the number of messages sent, which is less than count if
+   * the queue filled.
+   */
+  inline size_t send_messages(const T * const messages, size_t count) {
+    return really_send_messages(messages, count);
+  }
+
+  /**
+   * Add up to count messages to the queue tail, waiting the specified
+   * milliseconds for room for the first message and not waiting at all
+   * for the rest. Sending stops when the queue is full.
+   *
+   * Parameters:
+   *
+   * Name        Contents
+   * ----------  --------------------------------------------------------------
+   * messages    The messages to send.
+   * count       The number of messages to send.
+   * max_wait_ms The maximum number of milliseconds to wait for room for
+   *             the first message.
+   *
+   * Returns: the number of messages sent, which is less than count if
+   * the queue filled.
+   */
+  inline size_t send_messages(
+      const T * const messages, size_t count, uint32_t max_wait_ms) {
+    return really_send_messages(messages, count, pdMS_TO_TICKS(max_wait_ms));
+  }
+
   /**
    * Sends a message from an interrupt service routine (ISR) and yields if a
    * higher priority task is awakened. If the send succeeds, the message is
@@ -0,0 +1,65 @@
+/*
+ * QueueBatchT.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The batch transfer loop shared by BasePullQueue and BasePullQueueH.
+ * FreeRTOS copies one message per kernel call, so a batch is a series of
+ * calls: the first may wait, and the rest do not. The scheduler stays
+ * running throughout, since a send or receive can wake a blocked task,
+ * which FreeRTOS forbids while the scheduler is suspended.
+ */
+
+#ifndef SRC_QUEUEBATCHT_H_
+#define SRC_QUEUEBATCHT_H_
+
+#include "Arduino.h"
+
+#include "freertos/FreeRTOS.h"
+
+/**
+ * Transfers up to count messages, waiting at most timeout ticks for the
+ * first and not at all for the rest.
+ *
+ * Parameters:
+ *
+ * Name      Contents
+ * --------- ------------------------------------------------------------------
+ * count     The most messages to transfer
+ * timeout   The wait limit for the first message in ticks
+ * transfer  Invoked as transfer(index, ticks_to_wait) to move the message
+ *           at index in the caller's buffer. Returns true on success.
+ *
+ * Returns: the number of messages transferred, which stops at the first
+ *          transfer that fails.
+ */
+template <typename Transfer> size_t transfer_queue_batch(
+    size_t count, TickType_t timeout, Transfer transfer) {
+  if (!count || !transfer(0, timeout)) {
+    return 0;
+  }
+  size_t transferred = 1;
+  while (transferred < count && transfer(transferred, 0)) {
+    ++transferred;
+  }
+  return transferred;
+}
+
+#endif /* SRC_QUEUEBATCHT_H_ */
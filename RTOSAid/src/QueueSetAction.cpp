@@ -0,0 +1,40 @@
+/*
+ * QueueSetAction.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "QueueSetAction.h"
+
+QueueSetAction::QueueSetAction(QueueSetWaiter& waiter) :
+    waiter(waiter) {
+}
+
+QueueSetAction::~QueueSetAction() {
+}
+
+void QueueSetAction::run(void) {
+  if (!waiter.valid()) {
+    return;
+  }
+  while (!cancelled()) {
+    waiter.wait_and_dispatch(CANCELLATION_POLL_MS);
+  }
+}
@@ -0,0 +1,63 @@
+/*
+ * QueueSetAction.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A TaskAction that serves a QueueSetWaiter until it is cancelled,
+ * dispatching every message that arrives on any of its member queues.
+ * Use it to replace a group of tasks that each block on a single queue
+ * with one task. The waiter must be started before the containing task
+ * starts.
+ *
+ * A task notification cannot end a queue set wait, so the action waits
+ * at most CANCELLATION_POLL_MS at a time and checks for cancellation in
+ * between. That bounds how long cancel() takes to end the task.
+ */
+
+#ifndef SRC_QUEUESETACTION_H_
+#define SRC_QUEUESETACTION_H_
+
+#include "QueueSetWaiter.h"
+#include "TaskAction.h"
+
+class QueueSetAction final : public TaskAction {
+public:
+  static const uint32_t CANCELLATION_POLL_MS = 20;
+
+private:
+  QueueSetWaiter& waiter;
+
+public:
+  /**
+   * Constructor
+   *
+   * Parameters:
+   *
+   * Name    Contents
+   * ------- ----------------------------------------------------------------
+   * waiter  The waiter to serve. Must outlive the action.
+   */
+  QueueSetAction(QueueSetWaiter& waiter);
+  virtual ~QueueSetAction();
+
+  virtual void run(void);
+};
+
+#endif /* SRC_QUEUESETACTION_H_ */
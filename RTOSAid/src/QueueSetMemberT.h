@@ -0,0 +1,102 @@
+/*
+ * QueueSetMemberT.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Binds a typed pull queue to the handler that processes its messages,
+ * so that the pair can be registered with a QueueSetWaiter. Works with
+ * both PullQueueT and PullQueueHT queues.
+ *
+ * Note that the member pulls messages into a local variable, so the
+ * waiting task's stack must accommodate a message of type T.
+ */
+
+#ifndef SRC_QUEUESETMEMBERT_H_
+#define SRC_QUEUESETMEMBERT_H_
+
+#include "MessageFunctionT.h"
+#include "PullQueueHT.h"
+#include "PullQueueT.h"
+#include "QueueSetWaiter.h"
+
+template <class T> class QueueSetMemberT final : public QueueSetMember {
+  PullQueueT<T> *queue;
+  PullQueueHT<T> *heap_queue;
+  MessageFunctionT<T>& handler;
+
+protected:
+  virtual UBaseType_t capacity(void) const {
+    return queue ? queue->capacity() : heap_queue->capacity();
+  }
+
+  virtual bool dispatch(void) {
+    T message;
+    bool result = queue
+        ? queue->pull_message(&message, 0)
+        : heap_queue->pull_message(&message, 0);
+    if (result) {
+      handler.apply(message);
+    }
+    return result;
+  }
+
+  virtual QueueHandle_t handle(void) const {
+    return queue ? queue->handle() : heap_queue->handle();
+  }
+
+public:
+  /**
+   * Binds a statically allocated queue to its handler.
+   *
+   * Parameters:
+   *
+   * Name     Contents
+   * -------- ---------------------------------------------------------------
+   * queue    The member queue, which must outlive this member
+   * handler  Processes messages pulled from the queue. Must outlive
+   *          this member.
+   */
+  QueueSetMemberT(PullQueueT<T>& queue, MessageFunctionT<T>& handler) :
+      queue(&queue),
+      heap_queue(NULL),
+      handler(handler) {
+  }
+
+  /**
+   * Binds a heap allocated queue to its handler.
+   *
+   * Parameters:
+   *
+   * Name     Contents
+   * -------- ---------------------------------------------------------------
+   * queue    The member queue, which must outlive this member
+   * handler  Processes messages pulled from the queue. Must outlive
+   *          this member.
+   */
+  QueueSetMemberT(PullQueueHT<T>& queue, MessageFunctionT<T>& handler) :
+      queue(NULL),
+      heap_queue(&queue),
+      handler(handler) {
+  }
+
+  virtual ~QueueSetMemberT() {}
+};
+
+#endif /* SRC_QUEUESETMEMBERT_H_ */
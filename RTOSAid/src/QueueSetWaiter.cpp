@@ -0,0 +1,122 @@
+/*
+ * QueueSetWaiter.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "QueueSetWaiter.h"
+
+QueueSetMember::QueueSetMember(void) :
+    owner(NULL),
+    next(NULL) {
+}
+
+QueueSetMember::~QueueSetMember() {
+}
+
+QueueSetWaiter::QueueSetWaiter(void) :
+    first_member(NULL),
+    set_handle(NULL) {
+}
+
+QueueSetWaiter::~QueueSetWaiter() {
+  if (set_handle) {
+    for (QueueSetMember *member = first_member; member; member = member->next) {
+      xQueueRemoveFromSet(member->handle(), set_handle);
+    }
+    vQueueDelete(set_handle);
+    set_handle = NULL;
+  }
+  for (QueueSetMember *member = first_member; member; member = member->next) {
+    member->owner = NULL;
+  }
+}
+
+bool QueueSetWaiter::add(QueueSetMember *member) {
+  bool result = !set_handle && !member->owner;
+  if (result) {
+    member->owner = this;
+    member->next = first_member;
+    first_member = member;
+  }
+  return result;
+}
+
+bool QueueSetWaiter::begin(void) {
+  if (set_handle || !first_member) {
+    return false;
+  }
+
+  // The set holds one entry per queued message, so it must be able to
+  // hold as many entries as all of its members combined.
+  UBaseType_t total_capacity = 0;
+  for (QueueSetMember *member = first_member; member; member = member->next) {
+    total_capacity += member->capacity();
+  }
+
+  set_handle = xQueueCreateSet(total_capacity);
+  if (!set_handle) {
+    return false;
+  }
+
+  QueueSetMember *added = first_member;
+  for (; added; added = added->next) {
+    if (!added->handle()
+        || xQueueAddToSet(added->handle(), set_handle) != pdPASS) {
+      break;
+    }
+  }
+
+  bool result = added == NULL;
+  if (!result) {
+    for (QueueSetMember *member = first_member;
+        member != added;
+        member = member->next) {
+      xQueueRemoveFromSet(member->handle(), set_handle);
+    }
+    vQueueDelete(set_handle);
+    set_handle = NULL;
+  }
+  return result;
+}
+
+bool QueueSetWaiter::really_wait_and_dispatch(TickType_t timeout) {
+  if (!set_handle) {
+    return false;
+  }
+  QueueSetMemberHandle_t ready = xQueueSelectFromSet(set_handle, timeout);
+  if (!ready) {
+    return false;
+  }
+  for (QueueSetMember *member = first_member; member; member = member->next) {
+    if (member->handle() == ready) {
+      return member->dispatch();
+    }
+  }
+  return false;
+}
+
+bool QueueSetWaiter::wait_and_dispatch(uint32_t max_wait_ms) {
+  return really_wait_and_dispatch(pdMS_TO_TICKS(max_wait_ms));
+}
+
+bool QueueSetWaiter::wait_and_dispatch(void) {
+  return really_wait_and_dispatch(portMAX_DELAY);
+}
@@ -0,0 +1,183 @@
+/*
+ * QueueSetWaiter.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Blocks a single task on several queues at once. Applications register
+ * any number of queues, each paired with its own message handler, then
+ * call wait_and_dispatch(), which blocks until any of the queues has a
+ * message, pulls it, and passes it to the queue's handler. One task can
+ * therefore serve many message sources with a single blocking call and
+ * no polling.
+ *
+ * The implementation uses a FreeRTOS queue set, which imposes the
+ * following restrictions:
+ *
+ * 1. Queues must be started (i.e. their begin() must succeed) and empty
+ *    when the waiter starts.
+ * 2. A queue can belong to at most one waiter.
+ * 3. Once the waiter starts, messages MUST be pulled from member queues
+ *    ONLY by the waiter. Pulling a message directly, peeking aside,
+ *    leaves the queue set out of step with its members.
+ *
+ * Typical use:
+ *
+ *   PullQueueT<CanFrame> frame_queue(frame_storage, FRAME_COUNT);
+ *   PullQueueT<Command> command_queue(command_storage, COMMAND_COUNT);
+ *   FrameHandler frame_handler;     // A MessageFunctionT<CanFrame>
+ *   CommandHandler command_handler; // A MessageFunctionT<Command>
+ *   QueueSetMemberT<CanFrame> frames(frame_queue, frame_handler);
+ *   QueueSetMemberT<Command> commands(command_queue, command_handler);
+ *   QueueSetWaiter waiter;
+ *
+ *   void setup() {
+ *     frame_queue.begin();
+ *     command_queue.begin();
+ *     waiter.add(&frames);
+ *     waiter.add(&commands);
+ *     waiter.begin();
+ *     ...
+ *   }
+ *
+ *   ... then, in a TaskAction's run() method
+ *
+ *     for (;;) {
+ *       waiter.wait_and_dispatch();
+ *     }
+ */
+
+#ifndef SRC_QUEUESETWAITER_H_
+#define SRC_QUEUESETWAITER_H_
+
+#include "Arduino.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+class QueueSetWaiter;
+
+/**
+ * A queue that belongs to a QueueSetWaiter. This class is not meant
+ * to be subclassed by application code. Use QueueSetMemberT instead.
+ */
+class QueueSetMember {
+  friend class QueueSetWaiter;
+
+  QueueSetWaiter *owner;
+  QueueSetMember *next;
+
+protected:
+  QueueSetMember(void);
+
+  /**
+   * Returns: the member queue's capacity in messages
+   */
+  virtual UBaseType_t capacity(void) const = 0;
+
+  /**
+   * Pulls a message from the queue without waiting and passes
+   * it to the message handler.
+   *
+   * Returns: true if a message was pulled and handled, false if
+   *          the queue was empty.
+   */
+  virtual bool dispatch(void) = 0;
+
+  /**
+   * Returns: the member queue's FreeRTOS handle.
+   */
+  virtual QueueHandle_t handle(void) const = 0;
+
+public:
+  virtual ~QueueSetMember();
+};
+
+class QueueSetWaiter final {
+  QueueSetMember *first_member;
+  QueueSetHandle_t set_handle;
+
+public:
+  QueueSetWaiter(void);
+  ~QueueSetWaiter();
+
+  /**
+   * Adds a member queue. Members must be added before begin() is
+   * invoked, and cannot be removed.
+   *
+   * Parameters:
+   *
+   * Name    Contents
+   * ------- ----------------------------------------------------------------
+   * member  The queue and its handler. The member must outlive the
+   *         waiter.
+   *
+   * Returns: true if the member was added, false if the waiter has
+   *          started or if the member already belongs to a waiter.
+   */
+  bool add(QueueSetMember *member);
+
+  /**
+   * Creates the underlying queue set and adds all member queues to it.
+   *
+   * Returns: true if the waiter started, false if it has already started,
+   *          has no members, or if the queue set could not be created
+   *          or populated, typically because a member queue has not been
+   *          started or is not empty.
+   */
+  bool begin(void);
+
+  /**
+   * Waits for any member queue to receive a message, then pulls that
+   * message and passes it to the queue's handler. Exactly one message
+   * is handled per call.
+   *
+   * Parameters:
+   *
+   * Name        Contents
+   * ----------- ------------------------------------------------------------
+   * max_wait_ms The maximum number of milliseconds to wait for a message.
+   *             Waits forever if omitted. If the wait time is zero, the
+   *             call returns immediately.
+   *
+   * Returns: true if a message was handled, false if no message arrived
+   *          within the wait time or if the waiter has not started.
+   */
+  bool wait_and_dispatch(uint32_t max_wait_ms);
+
+  /**
+   * Waits forever for any member queue to receive a message, then
+   * handles it as described above.
+   *
+   * Returns: true if a message was handled.
+   */
+  bool wait_and_dispatch(void);
+
+  /**
+   * Returns: true if the waiter has started and can dispatch messages.
+   */
+  inline bool valid(void) const {
+    return set_handle != NULL;
+  }
+
+private:
+  bool really_wait_and_dispatch(TickType_t timeout);
+};
+
+#endif /* SRC_QUEUESETWAITER_H_ */
@@ -0,0 +1,176 @@
+/*
+ * QueueStatistics.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "QueueStatistics.h"
+
+#include "esp_timer.h"
+
+#if RTOSAID_QUEUE_STATISTICS
+
+QueueInstrumentationRegistry QueueRegistry;
+
+QueueInstrumentation::QueueInstrumentation(UBaseType_t capacity) :
+    name(NULL),
+    capacity(capacity),
+    lock(portMUX_INITIALIZER_UNLOCKED),
+    next(NULL),
+    registered(false) {
+  reset();
+}
+
+QueueInstrumentation::~QueueInstrumentation() {
+  QueueRegistry.remove(this);
+}
+
+void QueueInstrumentation::copy_statistics(QueueStatistics *snapshot) {
+  int64_t now = esp_timer_get_time();
+  portENTER_CRITICAL(&lock);
+  snapshot->name = name;
+  snapshot->capacity = capacity;
+  snapshot->peak_occupancy = peak_occupancy;
+  snapshot->sent_count = sent_count;
+  snapshot->received_count = received_count;
+  snapshot->failed_send_count = failed_send_count;
+  snapshot->send_blocked_micros = send_blocked_micros;
+  snapshot->max_send_blocked_micros = max_send_blocked_micros;
+  snapshot->pull_blocked_micros = pull_blocked_micros;
+  snapshot->max_pull_blocked_micros = max_pull_blocked_micros;
+  snapshot->elapsed_micros = now - reset_at_micros;
+  portEXIT_CRITICAL(&lock);
+  snapshot->messages_per_second = snapshot->elapsed_micros > 0
+      ? static_cast<uint32_t>(
+          (snapshot->received_count * 1000000LL) / snapshot->elapsed_micros)
+      : 0;
+}
+
+void QueueInstrumentation::print_statistics(
+    Print& out, const QueueStatistics& snapshot) {
+  out.printf(
+      "%s: capacity %u, peak %u, sent %lu, received %lu, failed %lu, "
+      "%lu msg/s, send blocked %llu us (max %lu), "
+      "pull blocked %llu us (max %lu)\n",
+      snapshot.name ? snapshot.name : "(unnamed)",
+      static_cast<unsigned>(snapshot.capacity),
+      static_cast<unsigned>(snapshot.peak_occupancy),
+      static_cast<unsigned long>(snapshot.sent_count),
+      static_cast<unsigned long>(snapshot.received_count),
+      static_cast<unsigned long>(snapshot.failed_send_count),
+      static_cast<unsigned long>(snapshot.messages_per_second),
+      static_cast<unsigned long long>(snapshot.send_blocked_micros),
+      static_cast<unsigned long>(snapshot.max_send_blocked_micros),
+      static_cast<unsigned long long>(snapshot.pull_blocked_micros),
+      static_cast<unsigned long>(snapshot.max_pull_blocked_micros));
+}
+
+bool QueueInstrumentation::receive(
+    QueueHandle_t queue, void *message, TickType_t timeout) {
+  bool received = xQueueReceive(queue, message, 0) == pdTRUE;
+  uint32_t blocked_micros = 0;
+  if (!received && timeout) {
+    int64_t start = esp_timer_get_time();
+    received = xQueueReceive(queue, message, timeout) == pdTRUE;
+    blocked_micros = static_cast<uint32_t>(esp_timer_get_time() - start);
+  }
+  portENTER_CRITICAL(&lock);
+  if (received) {
+    ++received_count;
+  }
+  pull_blocked_micros += blocked_micros;
+  if (max_pull_blocked_micros < blocked_micros) {
+    max_pull_blocked_micros = blocked_micros;
+  }
+  portEXIT_CRITICAL(&lock);
+  return received;
+}
+
+void QueueInstrumentation::record_send(
+    bool succeeded, UBaseType_t occupancy, uint32_t blocked_micros) {
+  if (succeeded) {
+    ++sent_count;
+    if (peak_occupancy < occupancy) {
+      peak_occupancy = occupancy;
+    }
+  } else {
+    ++failed_send_count;
+  }
+  send_blocked_micros += blocked_micros;
+  if (max_send_blocked_micros < blocked_micros) {
+    max_send_blocked_micros = blocked_micros;
+  }
+}
+
+void QueueInstrumentation::reset(void) {
+  portENTER_CRITICAL(&lock);
+  peak_occupancy = 0;
+  sent_count = 0;
+  received_count = 0;
+  failed_send_count = 0;
+  send_blocked_micros = 0;
+  max_send_blocked_micros = 0;
+  pull_blocked_micros = 0;
+  max_pull_blocked_micros = 0;
+  reset_at_micros = esp_timer_get_time();
+  portEXIT_CRITICAL(&lock);
+}
+
+bool QueueInstrumentation::send(
+    QueueHandle_t queue, const void *message, TickType_t timeout) {
+  bool sent = xQueueSendToBack(queue, message, 0) == pdTRUE;
+  uint32_t blocked_micros = 0;
+  if (!sent && timeout) {
+    int64_t start = esp_timer_get_time();
+    sent = xQueueSendToBack(queue, message, timeout) == pdTRUE;
+    blocked_micros = static_cast<uint32_t>(esp_timer_get_time() - start);
+  }
+  UBaseType_t occupancy = sent ? uxQueueMessagesWaiting(queue) : 0;
+  portENTER_CRITICAL(&lock);
+  record_send(sent, occupancy, blocked_micros);
+  portEXIT_CRITICAL(&lock);
+  return sent;
+}
+
+bool QueueInstrumentation::send_from_isr(
+    QueueHandle_t queue, const void *message) {
+  BaseType_t higher_priority_task_woken = pdFALSE;
+  bool sent = xQueueSendToBackFromISR(
+      queue, message, &higher_priority_task_woken) == pdTRUE;
+  UBaseType_t occupancy = sent ? uxQueueMessagesWaitingFromISR(queue) : 0;
+  portENTER_CRITICAL_ISR(&lock);
+  record_send(sent, occupancy, 0);
+  portEXIT_CRITICAL_ISR(&lock);
+  if (higher_priority_task_woken) {
+    portYIELD_FROM_ISR();
+  }
+  return sent;
+}
+
+void QueueInstrumentation::snapshot(QueueStatistics *snapshot) {
+  copy_statistics(snapshot);
+}
+
+void QueueInstrumentation::start(void) {
+  reset();
+  QueueRegistry.add(this);
+}
+
+#endif /* RTOSAID_QUEUE_STATISTICS */
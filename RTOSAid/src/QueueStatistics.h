@@ -0,0 +1,166 @@
+/*
+ * QueueStatistics.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Optional queue instrumentation. When RTOSAID_QUEUE_STATISTICS is
+ * turned on (see RTOSAidConfig.h), every BasePullQueue and BasePullQueueH
+ * records
+ *
+ * * its peak occupancy (high-water mark),
+ * * the number of messages sent and received,
+ * * the number of sends that failed or timed out, and
+ * * the cumulative and maximum time spent blocked in send and in pull.
+ *
+ * Queues register themselves with the QueueRegistry when they begin(),
+ * so an application can dump every queue's statistics with a single
+ * call. Use the statistics to right size queue_length and to find
+ * stalled consumers. The registry, like the rest of this file's code,
+ * exists only while the option is on.
+ *
+ * To keep the fast path fast, sends and pulls first try without waiting.
+ * Only a call that must wait is timed.
+ */
+
+#ifndef SRC_QUEUESTATISTICS_H_
+#define SRC_QUEUESTATISTICS_H_
+
+#include "Arduino.h"
+
+#include "InstrumentationRegistryT.h"
+#include "RTOSAidConfig.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+
+/**
+ * A point in time snapshot of a queue's statistics.
+ */
+struct QueueStatistics {
+  const char *name;                  // Queue name, possibly NULL
+  UBaseType_t capacity;              // Queue length in messages
+  UBaseType_t peak_occupancy;        // Most messages ever waiting
+  uint32_t sent_count;               // Successful sends
+  uint32_t received_count;           // Successful pulls
+  uint32_t failed_send_count;        // Sends that failed or timed out
+  uint64_t send_blocked_micros;      // Total time blocked in send
+  uint32_t max_send_blocked_micros;  // Longest time blocked in send
+  uint64_t pull_blocked_micros;      // Total time blocked in pull
+  uint32_t max_pull_blocked_micros;  // Longest time blocked in pull
+  uint32_t messages_per_second;      // Receive rate since the last reset
+  int64_t elapsed_micros;            // Time since the last reset
+};
+
+/**
+ * Statistics gatherer embedded in an instrumented queue. The queue
+ * routes its FreeRTOS queue calls through an instance, which times and
+ * counts them. Updates are guarded by a spinlock, so instances can be
+ * used from tasks and ISRs alike.
+ */
+class QueueInstrumentation final {
+  template <class I, class S> friend class InstrumentationRegistryT;
+
+  const char *name;
+  const UBaseType_t capacity;
+  portMUX_TYPE lock;
+  UBaseType_t peak_occupancy;
+  uint32_t sent_count;
+  uint32_t received_count;
+  uint32_t failed_send_count;
+  uint64_t send_blocked_micros;
+  uint32_t max_send_blocked_micros;
+  uint64_t pull_blocked_micros;
+  uint32_t max_pull_blocked_micros;
+  int64_t reset_at_micros;
+  QueueInstrumentation *next;
+  bool registered;
+
+  QueueInstrumentation(const QueueInstrumentation&) = delete;
+  QueueInstrumentation& operator=(const QueueInstrumentation&) = delete;
+
+  void copy_statistics(QueueStatistics *snapshot);
+
+  static void print_statistics(Print& out, const QueueStatistics& snapshot);
+
+  void record_send(
+      bool succeeded, UBaseType_t occupancy, uint32_t blocked_micros);
+
+public:
+  QueueInstrumentation(UBaseType_t capacity);
+
+  /**
+   * Removes this instance from the registry if it is registered.
+   */
+  ~QueueInstrumentation();
+
+  /**
+   * Pulls a message from the specified queue, timing any wait.
+   */
+  bool receive(QueueHandle_t queue, void *message, TickType_t timeout);
+
+  /**
+   * Discards all statistics gathered so far.
+   */
+  void reset(void);
+
+  /**
+   * Sends a message to the specified queue, timing any wait.
+   */
+  bool send(QueueHandle_t queue, const void *message, TickType_t timeout);
+
+  /**
+   * Sends a message to the specified queue from an ISR, yielding if a
+   * higher priority task is awakened.
+   */
+  bool send_from_isr(QueueHandle_t queue, const void *message);
+
+  /**
+   * Sets the name that identifies the queue in reports. The name must
+   * outlive the queue.
+   */
+  inline void set_name(const char *name) {
+    this->name = name;
+  }
+
+  /**
+   * Copies the current statistics into *snapshot.
+   */
+  void snapshot(QueueStatistics *snapshot);
+
+  /**
+   * Resets the statistics and registers this instance with the
+   * QueueRegistry. Instrumented queues invoke this from begin().
+   */
+  void start(void);
+};
+
+/**
+ * The set of all started, instrumented queues. Use QueueRegistry, the
+ * library's singleton instance, rather than creating one. See
+ * InstrumentationRegistryT.h.
+ */
+typedef InstrumentationRegistryT<QueueInstrumentation, QueueStatistics>
+    QueueInstrumentationRegistry;
+
+#if RTOSAID_QUEUE_STATISTICS
+extern QueueInstrumentationRegistry QueueRegistry;
+#endif
+
+#endif /* SRC_QUEUESTATISTICS_H_ */
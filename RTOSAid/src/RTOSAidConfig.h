@@ -0,0 +1,76 @@
+/*
+ * RTOSAidConfig.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Compile-time RTOSAid options. Each option defaults to off (0). To turn
+ * one on, define it as 1 in your build flags, e.g.
+ *
+ *     -DRTOSAID_QUEUE_STATISTICS=1
+ *
+ * Options that are off compile to nothing, so they cost neither time nor
+ * memory.
+ */
+
+#ifndef SRC_RTOSAIDCONFIG_H_
+#define SRC_RTOSAIDCONFIG_H_
+
+/*
+ * Gather occupancy, failure, and blocking statistics in BasePullQueue and
+ * BasePullQueueH. See QueueStatistics.h.
+ */
+#ifndef RTOSAID_QUEUE_STATISTICS
+#define RTOSAID_QUEUE_STATISTICS 0
+#endif
+
+/*
+ * Gather wakeup, blocking, and stack statistics in BaseTaskWithAction.
+ * See TaskStatistics.h.
+ */
+#ifndef RTOSAID_TASK_STATISTICS
+#define RTOSAID_TASK_STATISTICS 0
+#endif
+
+/*
+ * Record the peak stack usage of every BaseTaskWithAction and recommend
+ * stack sizes. See StackProfiler.h.
+ */
+#ifndef RTOSAID_STACK_PROFILING
+#define RTOSAID_STACK_PROFILING 0
+#endif
+
+/*
+ * Gather lock counts, contention, and wait and hold time histograms in
+ * Mutex and MutexH. See MutexStatistics.h.
+ */
+#ifndef RTOSAID_MUTEX_STATISTICS
+#define RTOSAID_MUTEX_STATISTICS 0
+#endif
+
+/*
+ * Check that named Mutex and MutexH locks are always taken in a
+ * consistent order, reporting lock order cycles that could deadlock. A
+ * debugging aid. See LockOrderChecker.h.
+ */
+#ifndef RTOSAID_LOCK_ORDER_CHECKING
+#define RTOSAID_LOCK_ORDER_CHECKING 0
+#endif
+
+#endif /* SRC_RTOSAIDCONFIG_H_ */
@@ -0,0 +1,46 @@
+/*
+ * ReadLock.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ReadLock.h"
+
+#include "ReadWriteMutex.h"
+
+ReadLock::ReadLock(
+    ReadWriteMutex &mutex) :
+      mutex(mutex) {
+  while (!(lock_successful = mutex.lock_for_reading(portMAX_DELAY))) {}
+}
+
+ReadLock::ReadLock(
+    ReadWriteMutex &mutex,
+    uint32_t wait_time_in_millis) :
+      mutex(mutex) {
+  lock_successful =
+      mutex.lock_for_reading(pdMS_TO_TICKS(wait_time_in_millis));
+}
+
+ReadLock::~ReadLock() {
+  if (lock_successful) {
+    mutex.unlock_for_reading();
+  }
+}
@@ -0,0 +1,153 @@
+/*
+ * ReadWriteMutex.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "ReadWriteMutex.h"
+
+#include <cstring>
+
+ReadWriteMutex::ReadWriteMutex(void) :
+    state(NULL),
+    readers_gate(NULL),
+    writer_gate(NULL),
+    active_readers(0),
+    waiting_readers(0),
+    waiting_writers(0),
+    writer_active(false) {
+  std::memset(&state_buffer, 0, sizeof(state_buffer));
+  std::memset(&readers_buffer, 0, sizeof(readers_buffer));
+  std::memset(&writer_buffer, 0, sizeof(writer_buffer));
+}
+
+ReadWriteMutex::~ReadWriteMutex() {
+  if (writer_gate) {
+    vSemaphoreDelete(writer_gate);
+  }
+  if (readers_gate) {
+    vSemaphoreDelete(readers_gate);
+  }
+  if (state) {
+    vSemaphoreDelete(state);
+  }
+}
+
+void ReadWriteMutex::admit_waiting_readers(void) {
+  active_readers += waiting_readers;
+  for (; waiting_readers; --waiting_readers) {
+    xSemaphoreGive(readers_gate);
+  }
+}
+
+bool ReadWriteMutex::begin(void) {
+  if (!state) {
+    state = xSemaphoreCreateMutexStatic(&state_buffer);
+  }
+  if (!readers_gate) {
+    readers_gate = xSemaphoreCreateCountingStatic(
+        UINT16_MAX, 0, &readers_buffer);
+  }
+  if (!writer_gate) {
+    writer_gate = xSemaphoreCreateBinaryStatic(&writer_buffer);
+  }
+  return valid();
+}
+
+bool ReadWriteMutex::lock_for_reading(TickType_t timeout) {
+  xSemaphoreTake(state, portMAX_DELAY);
+  bool locked = !writer_active && !waiting_writers;
+  if (locked) {
+    ++active_readers;
+  } else {
+    ++waiting_readers;
+  }
+  xSemaphoreGive(state);
+  return locked || pass_gate(readers_gate, &waiting_readers, timeout);
+}
+
+bool ReadWriteMutex::lock_for_writing(TickType_t timeout) {
+  xSemaphoreTake(state, portMAX_DELAY);
+  bool locked = !writer_active && !active_readers;
+  if (locked) {
+    writer_active = true;
+  } else {
+    ++waiting_writers;
+  }
+  xSemaphoreGive(state);
+  if (locked) {
+    return true;
+  }
+  locked = pass_gate(writer_gate, &waiting_writers, timeout);
+  if (!locked) {
+    // Readers that queued behind this writer might now be free to go.
+    xSemaphoreTake(state, portMAX_DELAY);
+    if (!writer_active && !waiting_writers) {
+      admit_waiting_readers();
+    }
+    xSemaphoreGive(state);
+  }
+  return locked;
+}
+
+bool ReadWriteMutex::pass_gate(
+    SemaphoreHandle_t gate, uint32_t *waiting, TickType_t timeout) {
+  if (xSemaphoreTake(gate, timeout) == pdTRUE) {
+    return true;
+  }
+  // The gate might have opened after the wait timed out. Tokens are
+  // given with the state lock held, so this check is conclusive.
+  xSemaphoreTake(state, portMAX_DELAY);
+  bool passed = xSemaphoreTake(gate, 0) == pdTRUE;
+  if (!passed) {
+    --*waiting;
+  }
+  xSemaphoreGive(state);
+  return passed;
+}
+
+uint32_t ReadWriteMutex::reader_count(void) {
+  xSemaphoreTake(state, portMAX_DELAY);
+  uint32_t result = active_readers;
+  xSemaphoreGive(state);
+  return result;
+}
+
+void ReadWriteMutex::unlock_for_reading(void) {
+  xSemaphoreTake(state, portMAX_DELAY);
+  if (!--active_readers && waiting_writers) {
+    --waiting_writers;
+    writer_active = true;
+    xSemaphoreGive(writer_gate);
+  }
+  xSemaphoreGive(state);
+}
+
+void ReadWriteMutex::unlock_for_writing(void) {
+  xSemaphoreTake(state, portMAX_DELAY);
+  if (waiting_writers) {
+    --waiting_writers;
+    xSemaphoreGive(writer_gate);
+  } else {
+    writer_active = false;
+    admit_waiting_readers();
+  }
+  xSemaphoreGive(state);
+}
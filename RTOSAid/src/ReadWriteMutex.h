@@ -0,0 +1,147 @@
+/*
+ * ReadWriteMutex.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A reader-writer lock. Any number of tasks can hold it for reading at the
+ * same time, or a single task can hold it for writing. Use it to protect
+ * data that is read far more often than it is written, such as a
+ * configuration or routing table, so readers do not serialize.
+ *
+ * The lock prefers writers: once a writer is waiting, new readers wait
+ * until it has finished. A steady stream of readers therefore cannot
+ * starve a writer. When a writer releases the lock, a waiting writer goes
+ * next; when none is waiting, all waiting readers go together. Ownership
+ * passes directly to the tasks that were waiting, so a task that arrives
+ * later cannot barge in ahead of them.
+ *
+ * As with Mutex, the lock is only acquired and released through guards.
+ * ReadLock acquires it for reading and WriteLock for writing. Guards MUST
+ * be automatic variables.
+ *
+ *   static ReadWriteMutex table_mutex;
+ *
+ *   uint32_t lookup(uint32_t key) {
+ *     ReadLock lock(table_mutex);
+ *     ... read the table ...
+ *   }
+ *
+ *   void update(uint32_t key, uint32_t value) {
+ *     WriteLock lock(table_mutex);
+ *     ... write the table ...
+ *   }
+ *
+ * Restrictions:
+ *
+ * 1. A task MUST NOT lock a ReadWriteMutex more than once, whether for
+ *    reading or for writing. Nested locking deadlocks.
+ * 2. Readers do not inherit a waiting writer's priority.
+ * 3. ISRs cannot use the lock.
+ *
+ * Storage is allocated within the instance, so begin() never touches the
+ * heap.
+ */
+
+#ifndef SRC_READWRITEMUTEX_H_
+#define SRC_READWRITEMUTEX_H_
+
+#include "Arduino.h"
+
+#include "ReadLock.h"
+#include "WriteLock.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+class ReadWriteMutex final {
+  friend class ReadLock;
+  friend class WriteLock;
+
+  // Guards the following counts; held only briefly.
+  StaticSemaphore_t state_buffer;
+  SemaphoreHandle_t state;
+
+  // Waiting readers take this. Each token admits one reader that was
+  // counted into active_readers on its behalf.
+  StaticSemaphore_t readers_buffer;
+  SemaphoreHandle_t readers_gate;
+
+  // A waiting writer takes this, which means that it owns the lock.
+  StaticSemaphore_t writer_buffer;
+  SemaphoreHandle_t writer_gate;
+
+  uint32_t active_readers;
+  uint32_t waiting_readers;
+  uint32_t waiting_writers;
+  bool writer_active;
+
+  ReadWriteMutex(const ReadWriteMutex&) = delete;
+  ReadWriteMutex& operator=(const ReadWriteMutex&) = delete;
+
+  /**
+   * Admits every waiting reader. The caller must hold the state lock.
+   */
+  void admit_waiting_readers(void);
+
+  /**
+   * Waits for a gate to be opened for the caller. On timeout, the caller
+   * gives up its place among the waiters unless the gate opened in the
+   * meantime.
+   *
+   * Returns: true if the gate opened, i.e. if the caller owns the lock.
+   */
+  bool pass_gate(
+      SemaphoreHandle_t gate, uint32_t *waiting, TickType_t timeout);
+
+  /**
+   * Lock methods, reserved for ReadLock and WriteLock.
+   */
+  bool lock_for_reading(TickType_t timeout);
+  bool lock_for_writing(TickType_t timeout);
+  void unlock_for_reading(void);
+  void unlock_for_writing(void);
+
+public:
+  ReadWriteMutex(void);
+  ~ReadWriteMutex();
+
+  /**
+   * Creates the underlying semaphores. Be sure to invoke this method,
+   * typically in setup(), before locking the mutex.
+   *
+   * Returns: true if the mutex is ready to use, false otherwise.
+   */
+  bool begin(void);
+
+  /**
+   * Returns: the number of tasks that hold the lock for reading. The
+   *          value is a snapshot and may be stale.
+   */
+  uint32_t reader_count(void);
+
+  /**
+   * Returns: true if and only if begin() has succeeded.
+   */
+  inline bool valid(void) const {
+    return state && readers_gate && writer_gate;
+  }
+};
+
+#endif /* SRC_READWRITEMUTEX_H_ */
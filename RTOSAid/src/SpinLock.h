@@ -0,0 +1,82 @@
+/*
+ * SpinLock.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A spinlock for protecting a few words of shared state from tasks on
+ * either core and from interrupt service routines (ISRs). Holding a
+ * SpinLock masks interrupts on the holder's core and keeps the other
+ * core spinning, so critical sections MUST be a handful of instructions
+ * long: no blocking calls, no printing, no allocation. A
+ * Mutex is the right choice for anything longer.
+ *
+ * Like Mutex, a SpinLock is only taken through a guard, CriticalSection,
+ * which releases it when it goes out of scope.
+ *
+ *   static SpinLock counters_lock;
+ *   static uint32_t sent;
+ *   static uint32_t received;
+ *
+ *   void IRAM_ATTR on_receive(void) {
+ *     CriticalSection critical_section(counters_lock);
+ *     ++received;
+ *   }
+ *
+ * To share a single enumeration value, prefer AtomicStateT, which does
+ * not need a lock at all.
+ */
+
+#ifndef SRC_SPINLOCK_H_
+#define SRC_SPINLOCK_H_
+
+#include "Arduino.h"
+
+#include "freertos/FreeRTOS.h"
+
+class SpinLock final {
+  friend class CriticalSection;
+
+  portMUX_TYPE mux;
+
+  SpinLock(const SpinLock&) = delete;
+  SpinLock& operator=(const SpinLock&) = delete;
+
+  /**
+   * Lock and unlock methods, reserved for CriticalSection. They work in
+   * both task and ISR context.
+   */
+  inline void lock(void) {
+    portENTER_CRITICAL_SAFE(&mux);
+  }
+
+  inline void unlock(void) {
+    portEXIT_CRITICAL_SAFE(&mux);
+  }
+
+public:
+  /**
+   * Creates an unlocked instance. Unlike Mutex, a SpinLock is ready to
+   * use on construction and needs no begin().
+   */
+  SpinLock(void);
+  ~SpinLock();
+};
+
+#endif /* SRC_SPINLOCK_H_ */
@@ -0,0 +1,269 @@
+/*
+ * SpscRingT.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A lock-free, single producer, single consumer (SPSC) FIFO ring buffer
+ * that carries messages from one task or interrupt service routine (ISR)
+ * to one consumer task. It is a low overhead alternative to PullQueueT
+ * for high rate ISR to task traffic. Sending a message copies it into a
+ * slot and publishes it with a release store; no kernel critical section
+ * is taken. The producer wakes the consumer with a task notification
+ * only when the ring goes from empty to non-empty, so a consumer that
+ * keeps up pays for one wakeup per burst, not one per message.
+ *
+ * Restrictions:
+ *
+ * 1. Exactly one producer (a task or an ISR, not both) and exactly one
+ *    consumer task may use an instance.
+ * 2. The capacity, N, must be a power of two. The ring holds N messages.
+ * 3. A blocked consumer waits on its task notification, so the consumer
+ *    MUST NOT use its task notification for anything else while it
+ *    waits on the ring (e.g. TaskAction::wait_for_notification()).
+ * 4. T must be trivially copyable.
+ *
+ * Storage is allocated within the instance, so declare rings statically
+ * or as class fields.
+ */
+
+#ifndef SRC_SPSCRINGT_H_
+#define SRC_SPSCRINGT_H_
+
+#include "Arduino.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <atomic>
+#include <type_traits>
+
+/*
+ * Head and tail are placed in separate cache lines so that the producer
+ * and consumer, which usually run on different cores, do not contend
+ * for the same line.
+ */
+#define SPSC_RING_CACHE_LINE_SIZE 32
+
+template <class T, size_t N> class SpscRingT final {
+  static_assert(
+      2 <= N && (N & (N - 1)) == 0,
+      "SpscRingT capacity must be a power of two.");
+  static_assert(
+      std::is_trivially_copyable<T>::value,
+      "SpscRingT messages must be trivially copyable.");
+
+  static const uint32_t INDEX_MASK = N - 1;
+
+  // Next slot to read, written only by the consumer.
+  alignas(SPSC_RING_CACHE_LINE_SIZE) std::atomic<uint32_t> head;
+
+  // Next slot to write, written only by the producer.
+  alignas(SPSC_RING_CACHE_LINE_SIZE) std::atomic<uint32_t> tail;
+
+  // The consumer task, set when the consumer first blocks.
+  alignas(SPSC_RING_CACHE_LINE_SIZE) std::atomic<TaskHandle_t> consumer;
+
+  T slots[N];
+
+  SpscRingT(const SpscRingT&) = delete;
+  SpscRingT(SpscRingT&&) = delete;
+  SpscRingT& operator=(const SpscRingT&) = delete;
+  SpscRingT& operator=(SpscRingT&&) = delete;
+
+  /**
+   * Copies the oldest message out of the ring, if there is one, loading
+   * the tail with the specified memory order.
+   *
+   * Returns: true if a message was removed, false if the ring was empty.
+   */
+  inline bool dequeue(T *message, std::memory_order tail_order) {
+    uint32_t current_head = head.load(std::memory_order_relaxed);
+    if (current_head == tail.load(tail_order)) {
+      return false;
+    }
+    *message = slots[current_head & INDEX_MASK];
+    head.store(current_head + 1, std::memory_order_seq_cst);
+    return true;
+  }
+
+  /**
+   * Copies a message into the ring and sets *was_empty to true if the
+   * ring was empty before the message was added, i.e. if the consumer
+   * might be waiting.
+   *
+   * Returns: true if the message was added, false if the ring was full.
+   */
+  inline bool enqueue(const T *message, bool *was_empty) {
+    uint32_t current_tail = tail.load(std::memory_order_relaxed);
+    if (current_tail - head.load(std::memory_order_acquire) == N) {
+      return false;
+    }
+    slots[current_tail & INDEX_MASK] = *message;
+    // Sequentially consistent so that the head load below cannot be
+    // ordered before the tail store; see pull_message().
+    tail.store(current_tail + 1, std::memory_order_seq_cst);
+    *was_empty = head.load(std::memory_order_seq_cst) == current_tail;
+    return true;
+  }
+
+public:
+  inline SpscRingT(void) :
+      head(0),
+      tail(0),
+      consumer(NULL) {
+  }
+
+  ~SpscRingT() {}
+
+  /**
+   * Returns: the maximum number of messages that the ring can hold.
+   */
+  static constexpr size_t capacity(void) {
+    return N;
+  }
+
+  /**
+   * Returns: the number of messages that can be sent before the ring
+   *          becomes full. The value is a snapshot and may be stale.
+   */
+  inline size_t available_message_storage(void) const {
+    return N - waiting_message_count();
+  }
+
+  /**
+   * Returns: the number of messages waiting in the ring. The value is a
+   *          snapshot and may be stale.
+   */
+  inline size_t waiting_message_count(void) const {
+    return tail.load(std::memory_order_acquire)
+        - head.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Attempt to retrieve and remove the oldest message without waiting.
+   * For use ONLY by the consumer task.
+   *
+   * Parameters:
+   *
+   * Name     Contents
+   * -------- ----------------------------------------------------------------
+   * message  The retrieved message, if found. Contents are not specified if
+   *          a message was not pulled.
+   *
+   * Returns: true if a message was pulled, false if the ring was empty.
+   */
+  inline bool try_pull_message(T *message) {
+    return dequeue(message, std::memory_order_acquire);
+  }
+
+  /**
+   * Retrieve and remove the oldest message, waiting the specified time for
+   * one to arrive. For use ONLY by the consumer task.
+   *
+   * Parameters:
+   *
+   * Name        Contents
+   * ----------  --------------------------------------------------------------
+   * message     The retrieved message, if found. Contents are not specified if
+   *             a message was not pulled.
+   * max_wait_ms The maximum number of milliseconds to wait. If the wait time
+   *             is zero, the call returns immediately.
+   *
+   * Returns: true if a message was pulled, false otherwise
+   */
+  bool pull_message(T *message, uint32_t max_wait_ms) {
+    if (try_pull_message(message)) {
+      return true;
+    }
+    consumer.store(xTaskGetCurrentTaskHandle(), std::memory_order_seq_cst);
+    TickType_t wait_ticks = max_wait_ms == portMAX_DELAY
+        ? portMAX_DELAY
+        : pdMS_TO_TICKS(max_wait_ms);
+    TickType_t start = xTaskGetTickCount();
+    for (;;) {
+      // The sequentially consistent tail load, paired with the producer's
+      // sequentially consistent tail store and head load, guarantees that
+      // either we see the new message or the producer sees an empty ring
+      // (and our handle) and notifies us.
+      if (dequeue(message, std::memory_order_seq_cst)) {
+        return true;
+      }
+      TickType_t elapsed = xTaskGetTickCount() - start;
+      if (wait_ticks != portMAX_DELAY && wait_ticks <= elapsed) {
+        return false;
+      }
+      ulTaskNotifyTake(
+          pdTRUE,
+          wait_ticks == portMAX_DELAY ? portMAX_DELAY : wait_ticks - elapsed);
+    }
+  }
+
+  /**
+   * Retrieve and remove the oldest message, waiting as long as it takes
+   * for one to arrive. For use ONLY by the consumer task.
+   *
+   * Returns: true
+   */
+  inline bool pull_message(T *message) {
+    return pull_message(message, portMAX_DELAY);
+  }
+
+  /**
+   * Add a message to the ring's tail. Never blocks. For use ONLY by the
+   * producer task. ISRs MUST invoke send_message_from_ISR() instead.
+   *
+   * Returns: true if the message was added, false if the ring was full.
+   */
+  inline bool send_message(const T * const message) {
+    bool was_empty = false;
+    bool result = enqueue(message, &was_empty);
+    if (was_empty) {
+      TaskHandle_t waiting = consumer.load(std::memory_order_seq_cst);
+      if (waiting) {
+        xTaskNotifyGive(waiting);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Add a message to the ring's tail from an interrupt service routine
+   * (ISR), yielding if a higher priority task is awakened.
+   *
+   * Returns: true if the message was added, false if the ring was full.
+   */
+  inline bool IRAM_ATTR send_message_from_ISR(const T * const message) {
+    bool was_empty = false;
+    bool result = enqueue(message, &was_empty);
+    if (was_empty) {
+      TaskHandle_t waiting = consumer.load(std::memory_order_seq_cst);
+      if (waiting) {
+        BaseType_t higher_priority_task_woken = pdFALSE;
+        vTaskNotifyGiveFromISR(waiting, &higher_priority_task_woken);
+        if (higher_priority_task_woken) {
+          portYIELD_FROM_ISR();
+        }
+      }
+    }
+    return result;
+  }
+};
+
+#endif /* SRC_SPSCRINGT_H_ */
@@ -0,0 +1,212 @@
+/*
+ * StackProfiler.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "StackProfiler.h"
+
+#include <cstring>
+
+#if RTOSAID_STACK_PROFILING
+
+StackProfiler StackProfiles;
+
+StackProfiler::StackProfiler(void) :
+    entry_count(0),
+    dropped_count(0),
+    mutex(xSemaphoreCreateMutexStatic(&mutex_buffer)) {
+  std::memset(entries, 0, sizeof(entries));
+}
+
+size_t StackProfiler::count(void) {
+  lock();
+  size_t result = entry_count;
+  unlock();
+  return result;
+}
+
+StackProfiler::Entry *StackProfiler::find_idle(const char *name) {
+  for (size_t i = 0; i < entry_count; ++i) {
+    if (!entries[i].live_task && !strcmp(entries[i].profile.name, name)) {
+      return &entries[i];
+    }
+  }
+  return NULL;
+}
+
+StackProfiler::Entry *StackProfiler::find_live(TaskHandle_t task_handle) {
+  for (size_t i = 0; i < entry_count; ++i) {
+    if (entries[i].live_task == task_handle) {
+      return &entries[i];
+    }
+  }
+  return NULL;
+}
+
+void StackProfiler::lock(void) {
+  xSemaphoreTake(mutex, portMAX_DELAY);
+}
+
+void StackProfiler::paint(void *stack, size_t stack_size) {
+  std::memset(stack, STACK_FILL_BYTE, stack_size);
+}
+
+void StackProfiler::print_recommendations(
+    Print& out, uint32_t margin_percent) {
+  StackProfile task_profile;
+  size_t configured_total = 0;
+  size_t recommended_total = 0;
+  out.printf("Stack recommendations with a %lu%% margin:\n",
+      static_cast<unsigned long>(margin_percent));
+  for (size_t index = 0; profile(index, &task_profile); ++index) {
+    size_t recommended = recommended_stack_size(task_profile, margin_percent);
+    configured_total += task_profile.stack_size;
+    recommended_total += recommended;
+    out.printf(
+        "  %s: peak %u of %u bytes over %lu starts, recommend %u\n",
+        task_profile.name,
+        static_cast<unsigned>(task_profile.peak_used),
+        static_cast<unsigned>(task_profile.stack_size),
+        static_cast<unsigned long>(task_profile.start_count),
+        static_cast<unsigned>(recommended));
+  }
+  out.printf(
+      "Configured %u bytes, recommended %u bytes, saving %d bytes.\n",
+      static_cast<unsigned>(configured_total),
+      static_cast<unsigned>(recommended_total),
+      static_cast<int>(configured_total) - static_cast<int>(recommended_total));
+  if (dropped_count) {
+    out.printf("%lu tasks were not profiled; raise MAX_PROFILES.\n",
+        static_cast<unsigned long>(dropped_count));
+  }
+}
+
+bool StackProfiler::profile(size_t index, StackProfile *profile) {
+  bool found = false;
+  lock();
+  if (index < entry_count) {
+    sample(entries[index]);
+    *profile = entries[index].profile;
+    found = true;
+  }
+  unlock();
+  return found;
+}
+
+size_t StackProfiler::recommended_stack_size(
+    const StackProfile& profile, uint32_t margin_percent) {
+  uint64_t with_margin =
+      (static_cast<uint64_t>(profile.peak_used) * (100 + margin_percent)
+          + 99) / 100;
+  return static_cast<size_t>(
+      (with_margin + STACK_SIZE_GRANULARITY - 1)
+      / STACK_SIZE_GRANULARITY * STACK_SIZE_GRANULARITY);
+}
+
+void StackProfiler::reset(void) {
+  lock();
+  size_t kept = 0;
+  for (size_t i = 0; i < entry_count; ++i) {
+    if (entries[i].live_task) {
+      entries[kept] = entries[i];
+      entries[kept].profile.peak_used = 0;
+      entries[kept].profile.start_count = 1;
+      ++kept;
+    }
+  }
+  entry_count = kept;
+  dropped_count = 0;
+  unlock();
+}
+
+void StackProfiler::sample(Entry& entry) {
+  if (!entry.live_task) {
+    return;
+  }
+
+  // The stack is never painted again while the task runs, so the
+  // measurement reflects usage since the task started, even after a
+  // reset().
+  size_t stack_size = entry.profile.stack_size;
+  size_t free_bytes = entry.stack
+      ? unused_bytes(entry.stack, stack_size)
+      : uxTaskGetStackHighWaterMark(entry.live_task);
+  size_t used = free_bytes < stack_size ? stack_size - free_bytes : 0;
+  if (entry.profile.peak_used < used) {
+    entry.profile.peak_used = used;
+  }
+}
+
+void StackProfiler::task_started(
+    const char *name,
+    size_t stack_size,
+    TaskHandle_t task_handle,
+    const void *stack,
+    const bool *armed) {
+  lock();
+  if (!*armed) {
+    unlock();
+    return;
+  }
+  Entry *entry = find_idle(name);
+  if (!entry && entry_count < MAX_PROFILES) {
+    entry = &entries[entry_count++];
+    entry->profile.name = name;
+    entry->profile.peak_used = 0;
+    entry->profile.start_count = 0;
+  }
+  if (entry) {
+    entry->profile.stack_size = stack_size;
+    ++entry->profile.start_count;
+    entry->live_task = task_handle;
+    entry->stack = static_cast<const uint8_t *>(stack);
+  } else {
+    ++dropped_count;
+  }
+  unlock();
+}
+
+void StackProfiler::task_stopping(TaskHandle_t task_handle, bool *armed) {
+  lock();
+  *armed = false;
+  Entry *entry = task_handle ? find_live(task_handle) : NULL;
+  if (entry) {
+    sample(*entry);
+    entry->live_task = NULL;
+    entry->stack = NULL;
+  }
+  unlock();
+}
+
+void StackProfiler::unlock(void) {
+  xSemaphoreGive(mutex);
+}
+
+size_t StackProfiler::unused_bytes(const void *stack, size_t stack_size) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(stack);
+  size_t unused = 0;
+  while (unused < stack_size && bytes[unused] == STACK_FILL_BYTE) {
+    ++unused;
+  }
+  return unused;
+}
+
+#endif /* RTOSAID_STACK_PROFILING */
@@ -0,0 +1,261 @@
+/*
+ * StackProfiler.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Optional stack profiling. When RTOSAID_STACK_PROFILING is turned on (see
+ * RTOSAidConfig.h), every task derived from BaseTaskWithAction records the
+ * most stack it has ever used under its name, across any number of starts
+ * and stops, and the StackProfiles registry recommends a stack size for
+ * each task.
+ *
+ * Tasks that run on a caller-provided stack, TaskWithAction and
+ * TaskWithArenaStack, paint the stack with STACK_FILL_BYTE before they
+ * start, and the profiler measures the deepest point that the task
+ * overwrote by scanning the stack itself. TaskWithActionH cannot reach
+ * its stack before FreeRTOS creates the task, so the profiler relies on
+ * FreeRTOS, which paints new stacks with the same byte, and on
+ * uxTaskGetStackHighWaterMark(). The profiler samples a task when it
+ * stops and whenever a report is requested, so a report reflects the
+ * deepest usage seen during the run. Usage that the run never exercised,
+ * e.g. a rarely taken error path, is not seen, so exercise the firmware
+ * thoroughly before trusting the recommendations.
+ *
+ * Tasks register themselves when they start running and unregister
+ * before they are deleted. Both, and every sample, take the profiler's
+ * mutex, so the profiler never scans the stack of a deleted task. Do not
+ * invoke the profiler from an ISR. StackProfiles and the profiler's code
+ * exist only while the option is on.
+ *
+ * Typical use, after the firmware has run its workload:
+ *
+ *   StackProfiles.print_recommendations(Serial, 25);  // 25% margin
+ */
+
+#ifndef SRC_STACKPROFILER_H_
+#define SRC_STACKPROFILER_H_
+
+#include "Arduino.h"
+
+#include "RTOSAidConfig.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+/**
+ * The stack usage recorded for one task name.
+ */
+struct StackProfile {
+  const char *name;                  // Task name
+  size_t stack_size;                 // Configured stack size in bytes
+  size_t peak_used;                  // Most stack ever used, in bytes
+  uint32_t start_count;              // Number of times the task started
+};
+
+class StackProfiler final {
+public:
+  static const size_t MAX_PROFILES = 32;
+
+  // Recommendations are rounded up to a multiple of this many bytes.
+  static const size_t STACK_SIZE_GRANULARITY = 256;
+
+  // The byte that fills unused stack, the same one that FreeRTOS uses.
+  static const uint8_t STACK_FILL_BYTE = 0xa5;
+
+private:
+  struct Entry {
+    StackProfile profile;
+    TaskHandle_t live_task;          // NULL when the task is not running
+    const uint8_t *stack;            // Painted stack, or NULL if unknown
+  };
+
+  Entry entries[MAX_PROFILES];
+  size_t entry_count;
+  uint32_t dropped_count;
+  StaticSemaphore_t mutex_buffer;
+  SemaphoreHandle_t mutex;
+
+  StackProfiler(const StackProfiler&) = delete;
+  StackProfiler& operator=(const StackProfiler&) = delete;
+
+  /**
+   * Returns: the entry that profiles the specified running task, or NULL
+   *          if there is none. The caller must hold the mutex.
+   */
+  Entry *find_live(TaskHandle_t task_handle);
+
+  /**
+   * Returns: an entry for the named task that no running task is using,
+   *          or NULL if there is none. The caller must hold the mutex.
+   */
+  Entry *find_idle(const char *name);
+
+  void lock(void);
+
+  /**
+   * Samples the stack usage of the live task in the specified entry, if
+   * any. The caller must hold the mutex, which keeps the task alive.
+   */
+  void sample(Entry& entry);
+
+  void unlock(void);
+
+public:
+  StackProfiler(void);
+
+  /**
+   * Returns: the number of tasks that were not profiled because
+   *          MAX_PROFILES profiles were already in use.
+   */
+  inline uint32_t dropped(void) const {
+    return dropped_count;
+  }
+
+  /**
+   * Returns: the number of profiles.
+   */
+  size_t count(void);
+
+  /**
+   * Fills a stack with STACK_FILL_BYTE so that its usage can be measured.
+   * The stack MUST NOT be in use.
+   *
+   * Parameters:
+   *
+   * Name            Contents
+   * --------------- --------------------------------------------------------
+   * stack           The stack's lowest address
+   * stack_size      Stack size in bytes
+   */
+  static void paint(void *stack, size_t stack_size);
+
+  /**
+   * Prints the profile and recommended stack size of every profiled
+   * task, along with the total number of bytes the recommendations save.
+   *
+   * Parameters:
+   *
+   * Name            Contents
+   * --------------- --------------------------------------------------------
+   * out             Receives the report, typically Serial
+   * margin_percent  Safety margin added to the peak usage, as a percentage
+   */
+  void print_recommendations(Print& out, uint32_t margin_percent = 25);
+
+  /**
+   * Retrieves a task's stack profile, sampling the task first if it is
+   * running.
+   *
+   * Parameters:
+   *
+   * Name            Contents
+   * --------------- --------------------------------------------------------
+   * index           Profile index, 0 .. count() - 1
+   * profile         Receives the profile
+   *
+   * Returns: true if *profile was filled in, false if index is too large.
+   */
+  bool profile(size_t index, StackProfile *profile);
+
+  /**
+   * Computes a recommended stack size from a profile.
+   *
+   * Parameters:
+   *
+   * Name            Contents
+   * --------------- --------------------------------------------------------
+   * profile         The task's profile
+   * margin_percent  Safety margin added to the peak usage, as a percentage
+   *
+   * Returns: the peak usage plus the margin, rounded up to a multiple of
+   *          STACK_SIZE_GRANULARITY bytes.
+   */
+  static size_t recommended_stack_size(
+      const StackProfile& profile, uint32_t margin_percent);
+
+  /**
+   * Discards all profiles, keeping track of running tasks.
+   */
+  void reset(void);
+
+  /**
+   * Records that a task has started. Invoked by BaseTaskWithAction on
+   * the task itself. A task that shares its name with a running task
+   * gets a profile of its own.
+   *
+   * Parameters:
+   *
+   * Name            Contents
+   * --------------- --------------------------------------------------------
+   * name            Task name, which must outlive the profiler
+   * stack_size      Stack size in bytes
+   * task_handle     The running task
+   * stack           The task's painted stack, or NULL if the profiler
+   *                 must rely on uxTaskGetStackHighWaterMark()
+   * armed           The task is recorded only if *armed is true. The
+   *                 caller sets it before it creates the task, and
+   *                 task_stopping() clears it, so a task that is stopped
+   *                 before it gets to run is never recorded.
+   */
+  void task_started(
+      const char *name,
+      size_t stack_size,
+      TaskHandle_t task_handle,
+      const void *stack,
+      const bool *armed);
+
+  /**
+   * Samples a task's stack usage before it stops. Invoked by
+   * BaseTaskWithAction before it deletes the task.
+   *
+   * Parameters:
+   *
+   * Name            Contents
+   * --------------- --------------------------------------------------------
+   * task_handle     The stopping task
+   * armed           Cleared; see task_started()
+   */
+  void task_stopping(TaskHandle_t task_handle, bool *armed);
+
+  /**
+   * Measures how much of a painted stack has never been used.
+   *
+   * Parameters:
+   *
+   * Name            Contents
+   * --------------- --------------------------------------------------------
+   * stack           The stack's lowest address
+   * stack_size      Stack size in bytes
+   *
+   * Returns: the number of bytes at the bottom of the stack that still
+   *          hold STACK_FILL_BYTE. Stacks grow down on the ESP32.
+   */
+  static size_t unused_bytes(const void *stack, size_t stack_size);
+};
+
+#if RTOSAID_STACK_PROFILING
+/**
+ * The stack profiles of all tasks.
+ */
+extern StackProfiler StackProfiles;
+#endif
+
+#endif /* SRC_STACKPROFILER_H_ */
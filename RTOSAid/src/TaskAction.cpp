@@ -32,6 +32,18 @@ TaskAction::TaskAction() :
 TaskAction::~TaskAction() {
 }
 
+bool TaskAction::cancelled(void) {
+  return containing_task->cancellation.cancelled();
+}
+
+CancellationToken& TaskAction::cancellation_token(void) {
+  return containing_task->cancellation;
+}
+
+bool TaskAction::join(uint32_t millis) {
+  return containing_task->join(millis);
+}
+
 void TaskAction::notify() {
   containing_task->notify();
 }
@@ -40,6 +52,14 @@ void TaskAction::notify_from_isr() {
   return containing_task->notify_from_isr();
 }
 
+void TaskAction::notify_bits(uint32_t bits) {
+  containing_task->notify_bits(bits);
+}
+
+void TaskAction::notify_bits_from_isr(uint32_t bits) {
+  containing_task->notify_bits_from_isr(bits);
+}
+
 void TaskAction::delay_millis(uint32_t millis) {
   containing_task->delay_millis(millis);
 }
@@ -60,6 +80,10 @@ uint32_t TaskAction::wait_for_notification(uint32_t millis) {
   return containing_task->wait_for_notification(millis);
 }
 
+uint32_t TaskAction::wait_for_bits(uint32_t mask, uint32_t millis) {
+  return containing_task->wait_for_bits(mask, millis);
+}
+
 void TaskAction::yield(void) {
   containing_task->yield();
 }
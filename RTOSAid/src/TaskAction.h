@@ -32,6 +32,8 @@
 
 #include "Arduino.h"
 
+#include "CancellationToken.h"
+
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
@@ -47,6 +49,32 @@ class TaskAction {
 protected:
   TaskAction(void);
 
+  /**
+   * Returns: true if the containing task has been asked to stop via
+   *          cancel(). Actions should check this regularly and return
+   *          from run() when it becomes true.
+   */
+  bool cancelled(void);
+
+  /**
+   * Returns: the containing task's cancellation token.
+   */
+  CancellationToken& cancellation_token(void);
+
+  /**
+   * Returns: the task that runs this action, or NULL if there is none.
+   */
+  inline BaseTaskWithAction *owning_task(void) {
+    return containing_task;
+  }
+
+  /**
+   * Waits for the containing task to finish. Invoke from other tasks
+   * only, e.g. in a method that stops the action. See
+   * BaseTaskWithAction::join().
+   */
+  bool join(uint32_t millis_to_wait=portMAX_DELAY);
+
   /**
    * Virtual destructor to ensure that the Action class can support dynamic
    * casting.
@@ -75,6 +103,18 @@ protected:
    */
   void IRAM_ATTR notify_from_isr();
 
+  /**
+   * Sets notification bits from application code. See
+   * BaseTaskWithAction::notify_bits().
+   */
+  void notify_bits(uint32_t bits);
+
+  /**
+   * Sets notification bits from an interrupt service routine (ISR).
+   * Application code must invoke notify_bits() instead.
+   */
+  void IRAM_ATTR notify_bits_from_isr(uint32_t bits);
+
   /**
    * Resumes this task. Should be called when the task has been suspended.
    */
@@ -128,6 +168,16 @@ protected:
    */
   virtual uint32_t wait_for_notification(uint32_t millis_to_wait=portMAX_DELAY);
 
+  /**
+   * Suspend the task until any of the specified notification bits is set
+   * or until the specified delay elapses. The implementation forwards the
+   * request to the containing TaskWithAction. See
+   * BaseTaskWithAction::wait_for_bits() for details.
+   *
+   * Returns the bits in mask that were set, or 0 if the wait timed out.
+   */
+  uint32_t wait_for_bits(uint32_t mask, uint32_t millis_to_wait=portMAX_DELAY);
+
   /**
    * Yield to any higher priority tasks that are ready to run. Note that
    * FreeRTOS implements cooperative multitasking, which means that it
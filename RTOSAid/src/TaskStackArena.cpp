@@ -0,0 +1,132 @@
+/*
+ * TaskStackArena.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TaskStackArena.h"
+
+#include <cstring>
+
+static inline size_t round_up_to_alignment(size_t value) {
+  return (value + TaskStackArena::STACK_ALIGNMENT - 1)
+      & ~(TaskStackArena::STACK_ALIGNMENT - 1);
+}
+
+TaskStackArena::TaskStackArena(void *region, size_t region_size) :
+    unreserved(static_cast<uint8_t *>(region)),
+    region_end(static_cast<uint8_t *>(region) + region_size),
+    size_class_count(0),
+    lock(portMUX_INITIALIZER_UNLOCKED) {
+  uintptr_t start = reinterpret_cast<uintptr_t>(region);
+  size_t skipped = round_up_to_alignment(start) - start;
+  unreserved = skipped < region_size ? unreserved + skipped : region_end;
+  std::memset(size_classes, 0, sizeof(size_classes));
+}
+
+TaskStackArena::~TaskStackArena() {
+}
+
+void *TaskStackArena::acquire(size_t stack_size) {
+  void *stack = NULL;
+  portENTER_CRITICAL(&lock);
+  for (size_t i = 0; !stack && i < size_class_count; ++i) {
+    SizeClass& size_class = size_classes[i];
+    uint32_t all_stacks = size_class.stack_count < 32
+        ? (1UL << size_class.stack_count) - 1
+        : UINT32_MAX;
+    uint32_t free_stacks = all_stacks & ~size_class.in_use;
+    if (stack_size <= size_class.stack_size && free_stacks) {
+      size_t index = __builtin_ctz(free_stacks);
+      size_class.in_use |= 1UL << index;
+      stack = size_class.first_stack + index * size_class.stack_size;
+    }
+  }
+  portEXIT_CRITICAL(&lock);
+  return stack;
+}
+
+bool TaskStackArena::add_size_class(size_t stack_size, size_t stack_count) {
+  stack_size = round_up_to_alignment(stack_size);
+  if (!stack_size || !stack_count || MAX_STACKS_PER_CLASS < stack_count) {
+    return false;
+  }
+
+  bool added = false;
+  portENTER_CRITICAL(&lock);
+  size_t position = 0;
+  while (position < size_class_count
+      && size_classes[position].stack_size < stack_size) {
+    ++position;
+  }
+  bool duplicate = position < size_class_count
+      && size_classes[position].stack_size == stack_size;
+  if (!duplicate
+      && size_class_count < MAX_SIZE_CLASSES
+      && stack_size * stack_count <= unreserved_bytes()) {
+    for (size_t i = size_class_count; position < i; --i) {
+      size_classes[i] = size_classes[i - 1];
+    }
+    size_classes[position].first_stack = unreserved;
+    size_classes[position].stack_size = stack_size;
+    size_classes[position].stack_count = stack_count;
+    size_classes[position].in_use = 0;
+    unreserved += stack_size * stack_count;
+    ++size_class_count;
+    added = true;
+  }
+  portEXIT_CRITICAL(&lock);
+  return added;
+}
+
+size_t TaskStackArena::available(size_t stack_size) {
+  size_t count = 0;
+  portENTER_CRITICAL(&lock);
+  for (size_t i = 0; i < size_class_count; ++i) {
+    const SizeClass& size_class = size_classes[i];
+    if (stack_size <= size_class.stack_size) {
+      count += size_class.stack_count - __builtin_popcount(size_class.in_use);
+    }
+  }
+  portEXIT_CRITICAL(&lock);
+  return count;
+}
+
+bool TaskStackArena::release(void *stack) {
+  const uint8_t *address = static_cast<const uint8_t *>(stack);
+  bool released = false;
+  portENTER_CRITICAL(&lock);
+  for (size_t i = 0; !released && i < size_class_count; ++i) {
+    SizeClass& size_class = size_classes[i];
+    const uint8_t *end =
+        size_class.first_stack + size_class.stack_size * size_class.stack_count;
+    if (size_class.first_stack <= address && address < end) {
+      size_t offset = address - size_class.first_stack;
+      uint32_t bit = 1UL << (offset / size_class.stack_size);
+      released = offset % size_class.stack_size == 0
+          && (size_class.in_use & bit);
+      if (released) {
+        size_class.in_use &= ~bit;
+      }
+    }
+  }
+  portEXIT_CRITICAL(&lock);
+  return released;
+}
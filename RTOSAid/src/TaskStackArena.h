@@ -0,0 +1,155 @@
+/*
+ * TaskStackArena.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Hands out task stacks from a caller-provided region of memory that is
+ * reserved for the purpose, so that tasks can be created, stopped and
+ * recreated without touching the heap. Over weeks of uptime, the heap
+ * allocations made by xTaskCreate() when tasks start, and their release
+ * when tasks stop, can fragment the heap until large allocations fail.
+ *
+ * The region is carved into size classes, each holding a fixed number of
+ * equally sized stacks. A request is granted from the smallest class whose
+ * stacks are large enough and that has a free stack. Acquiring and
+ * releasing a stack take constant time and are thread-safe.
+ *
+ * Typical use:
+ *
+ *   static uint8_t stack_region[3 * 4096 + 2 * 8192];
+ *   static TaskStackArena stacks(stack_region, sizeof(stack_region));
+ *
+ *   void setup() {
+ *     stacks.add_size_class(4096, 3);
+ *     stacks.add_size_class(8192, 2);
+ *     ...
+ *   }
+ *
+ * TaskWithArenaStack runs a TaskAction on a stack from an arena.
+ */
+
+#ifndef SRC_TASKSTACKARENA_H_
+#define SRC_TASKSTACKARENA_H_
+
+#include "Arduino.h"
+
+#include "freertos/FreeRTOS.h"
+
+class TaskStackArena final {
+public:
+  static const size_t MAX_SIZE_CLASSES = 8;
+  static const size_t MAX_STACKS_PER_CLASS = 32;
+
+  // Stacks start on, and their sizes are rounded up to, this boundary.
+  static const size_t STACK_ALIGNMENT = 16;
+
+private:
+  struct SizeClass {
+    uint8_t *first_stack;
+    size_t stack_size;
+    size_t stack_count;
+    uint32_t in_use;  // Bit n is set when stack n is acquired
+  };
+
+  uint8_t *unreserved;
+  uint8_t *const region_end;
+  SizeClass size_classes[MAX_SIZE_CLASSES];  // Smallest stacks first
+  size_t size_class_count;
+  portMUX_TYPE lock;
+
+  TaskStackArena(const TaskStackArena&) = delete;
+  TaskStackArena& operator=(const TaskStackArena&) = delete;
+
+public:
+
+  /**
+   * Creates a TaskStackArena that has no size classes. Invoke
+   * add_size_class() to carve the region into stacks.
+   *
+   * Parameters:
+   *
+   * Name          Contents
+   * ------------- ----------------------------------------------------------
+   * region        Storage for the stacks, which must outlive the arena. The
+   *               arena skips any leading bytes that are not aligned to
+   *               STACK_ALIGNMENT.
+   * region_size   Size of the region in bytes
+   */
+  TaskStackArena(void *region, size_t region_size);
+
+  ~TaskStackArena();
+
+  /**
+   * Acquires a stack that holds at least the specified number of bytes.
+   * Stacks come from the smallest size class that is large enough and
+   * that has a stack available.
+   *
+   * Parameters:
+   *
+   * Name          Contents
+   * ------------- ----------------------------------------------------------
+   * stack_size    Required stack size in bytes
+   *
+   * Returns: the stack, or NULL if no stack large enough is available.
+   */
+  void *acquire(size_t stack_size);
+
+  /**
+   * Adds a size class, reserving its stacks from the region. Size classes
+   * should be added before any stacks are acquired, typically in setup().
+   *
+   * Parameters:
+   *
+   * Name          Contents
+   * ------------- ----------------------------------------------------------
+   * stack_size    Size of each stack in bytes, rounded up to a multiple of
+   *               STACK_ALIGNMENT
+   * stack_count   Number of stacks in the class, 1 .. MAX_STACKS_PER_CLASS
+   *
+   * Returns: true if the class was added, false if the parameters are
+   *          invalid, MAX_SIZE_CLASSES classes already exist, a class
+   *          with the same stack size exists, or the region lacks room.
+   */
+  bool add_size_class(size_t stack_size, size_t stack_count);
+
+  /**
+   * Returns: the number of stacks that could satisfy a request for the
+   *          specified size. The value is a snapshot and may be stale.
+   */
+  size_t available(size_t stack_size);
+
+  /**
+   * Returns a stack to the arena. The stack MUST NOT be in use.
+   *
+   * Returns: true if the stack was released, false if it was not
+   *          acquired from this arena.
+   */
+  bool release(void *stack);
+
+  /**
+   * Returns: the number of bytes in the region that no size class has
+   *          reserved.
+   */
+  inline size_t unreserved_bytes(void) const {
+    return region_end - unreserved;
+  }
+};
+
+#endif /* SRC_TASKSTACKARENA_H_ */
@@ -0,0 +1,166 @@
+/*
+ * TaskStatistics.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TaskStatistics.h"
+
+#include "esp_idf_version.h"
+#include "esp_timer.h"
+
+#if RTOSAID_TASK_STATISTICS
+
+TaskInstrumentationRegistry TaskRegistry;
+
+TaskInstrumentation::TaskInstrumentation(
+    const char *name, UBaseType_t priority, size_t stack_size) :
+    name(name),
+    priority(priority),
+    stack_size(stack_size),
+    lock(portMUX_INITIALIZER_UNLOCKED),
+    task_handle(NULL),
+    next(NULL),
+    registered(false),
+    armed(false) {
+  reset();
+}
+
+TaskInstrumentation::~TaskInstrumentation() {
+  stop();
+}
+
+void TaskInstrumentation::arm(void) {
+  armed = true;
+}
+
+void TaskInstrumentation::copy_statistics(TaskStatistics *snapshot) {
+  int64_t now = esp_timer_get_time();
+  portENTER_CRITICAL(&lock);
+  snapshot->name = name;
+  snapshot->priority = priority;
+  snapshot->stack_size = stack_size;
+  snapshot->wakeup_count = wakeup_count;
+  snapshot->timeout_count = timeout_count;
+  snapshot->blocked_micros = blocked_micros;
+  snapshot->max_blocked_micros = max_blocked_micros;
+  snapshot->elapsed_micros = now - reset_at_micros;
+  portEXIT_CRITICAL(&lock);
+  snapshot->active_micros =
+      snapshot->elapsed_micros - static_cast<int64_t>(snapshot->blocked_micros);
+
+  // Measuring the high-water mark scans the stack, so do it with
+  // interrupts enabled. The registry's mutex keeps the task from being
+  // deleted in the meantime.
+  snapshot->stack_high_water_mark = task_handle
+      ? uxTaskGetStackHighWaterMark(task_handle)
+      : 0;
+#if configGENERATE_RUN_TIME_STATS && ESP_IDF_VERSION_MAJOR >= 5
+  snapshot->cpu_micros = task_handle ? ulTaskGetRunTimeCounter(task_handle) : 0;
+#else
+  snapshot->cpu_micros = 0;
+#endif
+}
+
+void TaskInstrumentation::print_statistics(
+    Print& out, const TaskStatistics& snapshot) {
+  out.printf(
+      "%s: priority %u, stack %u free of %u, wakeups %lu "
+      "(%lu timed out), active %lld us, blocked %llu us (max %lu), "
+      "cpu %llu us\n",
+      snapshot.name,
+      static_cast<unsigned>(snapshot.priority),
+      static_cast<unsigned>(snapshot.stack_high_water_mark),
+      static_cast<unsigned>(snapshot.stack_size),
+      static_cast<unsigned long>(snapshot.wakeup_count),
+      static_cast<unsigned long>(snapshot.timeout_count),
+      static_cast<long long>(snapshot.active_micros),
+      static_cast<unsigned long long>(snapshot.blocked_micros),
+      static_cast<unsigned long>(snapshot.max_blocked_micros),
+      static_cast<unsigned long long>(snapshot.cpu_micros));
+}
+
+void TaskInstrumentation::record_block(int64_t start_micros) {
+  uint32_t blocked = static_cast<uint32_t>(esp_timer_get_time() - start_micros);
+  blocked_micros += blocked;
+  if (max_blocked_micros < blocked) {
+    max_blocked_micros = blocked;
+  }
+}
+
+void TaskInstrumentation::record_delay(int64_t start_micros) {
+  portENTER_CRITICAL(&lock);
+  record_block(start_micros);
+  portEXIT_CRITICAL(&lock);
+}
+
+void TaskInstrumentation::record_wait(int64_t start_micros, bool notified) {
+  portENTER_CRITICAL(&lock);
+  record_block(start_micros);
+  ++wakeup_count;
+  if (!notified) {
+    ++timeout_count;
+  }
+  portEXIT_CRITICAL(&lock);
+}
+
+void TaskInstrumentation::reset(void) {
+  portENTER_CRITICAL(&lock);
+  wakeup_count = 0;
+  timeout_count = 0;
+  blocked_micros = 0;
+  max_blocked_micros = 0;
+  reset_at_micros = esp_timer_get_time();
+  portEXIT_CRITICAL(&lock);
+}
+
+void TaskInstrumentation::snapshot(TaskStatistics *snapshot) {
+  // The registry's lock keeps the task alive while its stack is scanned.
+  TaskRegistry.lock();
+  copy_statistics(snapshot);
+  TaskRegistry.unlock();
+}
+
+void TaskInstrumentation::start(TaskHandle_t task_handle) {
+  reset();
+  TaskRegistry.lock();
+  if (armed) {
+    this->task_handle = task_handle;
+    TaskRegistry.add(this);
+  }
+  TaskRegistry.unlock();
+}
+
+void TaskInstrumentation::stop(void) {
+  TaskRegistry.lock();
+  armed = false;
+  task_handle = NULL;
+  TaskRegistry.remove(this);
+  TaskRegistry.unlock();
+}
+
+uint32_t TaskInstrumentation::wait_for_notification(TickType_t timeout) {
+  int64_t start = esp_timer_get_time();
+  uint32_t notification_count = ulTaskNotifyTake(true, timeout);
+  record_wait(start, notification_count);
+  return notification_count;
+}
+
+#endif /* RTOSAID_TASK_STATISTICS */
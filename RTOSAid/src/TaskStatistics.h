@@ -0,0 +1,197 @@
+/*
+ * TaskStatistics.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Optional task instrumentation. When RTOSAID_TASK_STATISTICS is turned
+ * on (see RTOSAidConfig.h), every TaskWithAction and TaskWithActionH
+ * records
+ *
+ * * the number of times it woke from wait_for_notification() or
+ *   wait_for_bits(), and how many of those wakeups were timeouts,
+ * * the cumulative and maximum time spent blocked in
+ *   wait_for_notification(), wait_for_bits(), and delay_millis(),
+ * * the time spent in run() when not blocked as above, and
+ * * its stack high-water mark, i.e. the least free stack space ever seen.
+ *
+ * Note that the active time includes time that the task spends ready to
+ * run but preempted, and time spent blocked elsewhere, e.g. pulling from
+ * a queue. When the FreeRTOS run time statistics are available, the
+ * statistics also include the CPU time that FreeRTOS charged to the task.
+ *
+ * Tasks register themselves with the TaskRegistry when they start and
+ * unregister when they stop, so an application can dump the statistics
+ * of every live task with a single call. TaskRegistry is only defined
+ * while the option is on.
+ */
+
+#ifndef SRC_TASKSTATISTICS_H_
+#define SRC_TASKSTATISTICS_H_
+
+#include "Arduino.h"
+
+#include "InstrumentationRegistryT.h"
+#include "RTOSAidConfig.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+/**
+ * A point in time snapshot of a task's statistics.
+ */
+struct TaskStatistics {
+  const char *name;                  // Task name
+  UBaseType_t priority;              // Task priority
+  size_t stack_size;                 // Stack size in bytes
+  uint32_t stack_high_water_mark;    // Least free stack ever, in bytes
+  uint32_t wakeup_count;             // Returns from wait_for_notification()
+  uint32_t timeout_count;            // Wakeups without a notification
+  uint64_t blocked_micros;           // Total time blocked in waits and delays
+  uint32_t max_blocked_micros;       // Longest single wait or delay
+  int64_t active_micros;             // Elapsed time less blocked time
+  uint64_t cpu_micros;               // FreeRTOS run time, 0 if unavailable
+  int64_t elapsed_micros;            // Time since the last reset
+};
+
+/**
+ * Statistics gatherer embedded in an instrumented task. The task times
+ * its waits and delays through an instance. Updates are guarded by a
+ * spinlock, so other tasks can take snapshots safely.
+ */
+class TaskInstrumentation final {
+  template <class I, class S> friend class InstrumentationRegistryT;
+
+  const char *name;
+  const UBaseType_t priority;
+  const size_t stack_size;
+  portMUX_TYPE lock;
+  TaskHandle_t task_handle;  // Guarded by the registry's mutex
+  uint32_t wakeup_count;
+  uint32_t timeout_count;
+  uint64_t blocked_micros;
+  uint32_t max_blocked_micros;
+  int64_t reset_at_micros;
+  TaskInstrumentation *next;
+  bool registered;
+  bool armed;  // start() may register the task
+
+  TaskInstrumentation(const TaskInstrumentation&) = delete;
+  TaskInstrumentation& operator=(const TaskInstrumentation&) = delete;
+
+  /**
+   * Copies the current statistics into *snapshot. The caller must hold
+   * the registry's mutex.
+   */
+  void copy_statistics(TaskStatistics *snapshot);
+
+  static void print_statistics(Print& out, const TaskStatistics& snapshot);
+
+  void record_block(int64_t start_micros);
+
+public:
+  TaskInstrumentation(
+      const char *name, UBaseType_t priority, size_t stack_size);
+
+  /**
+   * Removes this instance from the registry if it is registered.
+   */
+  ~TaskInstrumentation();
+
+  /**
+   * Discards all statistics gathered so far.
+   */
+  void reset(void);
+
+  /**
+   * Allows the next start() to register this instance. Instrumented
+   * tasks invoke this before they create their FreeRTOS task, so that a
+   * task that is stopped before it gets to run is never registered.
+   */
+  void arm(void);
+
+  /**
+   * Copies the current statistics into *snapshot.
+   */
+  void snapshot(TaskStatistics *snapshot);
+
+  /**
+   * Records a delay that the task performed itself.
+   *
+   * Parameters:
+   *
+   * Name          Contents
+   * ------------- ------------------------------------------------------------
+   * start_micros  When the delay started, from esp_timer_get_time()
+   */
+  void record_delay(int64_t start_micros);
+
+  /**
+   * Records a wait that the task performed itself.
+   *
+   * Parameters:
+   *
+   * Name          Contents
+   * ------------- ------------------------------------------------------------
+   * start_micros  When the wait started, from esp_timer_get_time()
+   * notified      true if a notification ended the wait, false if it
+   *               timed out
+   */
+  void record_wait(int64_t start_micros, bool notified);
+
+  /**
+   * Resets the statistics and registers this instance with the
+   * TaskRegistry unless stop() was invoked since arm(). Instrumented
+   * tasks invoke this from the task itself, as the first thing it does,
+   * so the handle is always that of a live task.
+   */
+  void start(TaskHandle_t task_handle);
+
+  /**
+   * Unregisters this instance. Instrumented tasks invoke this before
+   * their FreeRTOS task is deleted. Returns after any snapshot in
+   * progress, so the task can be deleted safely.
+   */
+  void stop(void);
+
+  /**
+   * Waits for a notification, timing the wait and counting the wakeup.
+   */
+  uint32_t wait_for_notification(TickType_t timeout);
+};
+
+/**
+ * The set of all running, instrumented tasks. Use TaskRegistry, the
+ * library's singleton instance, rather than creating one. See
+ * InstrumentationRegistryT.h.
+ *
+ * Measuring a task's stack high-water mark scans its stack, so
+ * snapshots hold the registry's mutex while they scan. Tasks unregister
+ * before they are deleted, which waits for the mutex, so a snapshot
+ * never scans the stack of a deleted task.
+ */
+typedef InstrumentationRegistryT<TaskInstrumentation, TaskStatistics>
+    TaskInstrumentationRegistry;
+
+#if RTOSAID_TASK_STATISTICS
+extern TaskInstrumentationRegistry TaskRegistry;
+#endif
+
+#endif /* SRC_TASKSTATISTICS_H_ */
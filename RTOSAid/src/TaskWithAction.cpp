@@ -32,12 +32,14 @@ TaskWithAction::TaskWithAction(
     uint16_t priority,
     TaskAction *action,
     void *stack,
-    size_t stack_size) :
+    size_t stack_size,
+    BaseType_t core) :
     BaseTaskWithAction(
         action,
         name,
         priority,
-        stack_size),
+        stack_size,
+        core),
   stack(static_cast<StackType_t *>(stack)) //,
 {
   memset(&task_buffer, 0, sizeof(task_buffer));
@@ -47,12 +49,14 @@ TaskWithAction::~TaskWithAction() {
 }
 
 bool TaskWithAction::start(void) {
-  return set_task_handle(xTaskCreateStatic(
+  prepare_to_start(stack);
+  return set_task_handle(xTaskCreateStaticPinnedToCore(
       run_task_loop,
       task_name(),
       task_stack_size(),
       this,
       task_priority(),
       stack,
-      &task_buffer));
+      &task_buffer,
+      task_core()));
 }
@@ -87,6 +87,9 @@ public:
    *                must publicly inherit Action.
    * stack          Stack storage for the task
    * stack_size     Number of bytes allocated for stack storage
+   * core           The core that runs the task, 0 or 1 on a dual core
+   *                ESP32, or tskNO_AFFINITY, the default, to let the
+   *                scheduler run the task on any core.
    *
    * Lets we have an Action called action (see, e.g. PeriodicPulseAction). We
    * would wrap it in a TaskWithAction as follows:
@@ -108,7 +111,8 @@ public:
       uint16_t priority,
       TaskAction *action,
       void *stack,
-      size_t stack_size);
+      size_t stack_size,
+      BaseType_t core = tskNO_AFFINITY);
 
   /**
    * Destructor -- runs when this TaskWithAction is deleted. As a defensive
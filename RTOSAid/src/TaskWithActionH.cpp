@@ -27,26 +27,29 @@ TaskWithActionH::TaskWithActionH(
     const char *name,
     const UBaseType_t priority,
     TaskAction *action,
-    const size_t stack_size) :
+    const size_t stack_size,
+    const BaseType_t core) :
       BaseTaskWithAction(
           action,
           name,
           priority,
-          stack_size) {
+          stack_size,
+          core) {
 }
 
 TaskWithActionH::~TaskWithActionH() {
 }
 
 bool TaskWithActionH::start(void) {
+  prepare_to_start();
   TaskHandle_t task_handle = NULL;
-  BaseType_t create_status = xTaskCreate(
+  BaseType_t create_status = xTaskCreatePinnedToCore(
       run_task_loop,
       task_name(),
       task_stack_size(),
       this,
       task_priority(),
-      &task_handle);
-  set_task_handle(task_handle);
-  return create_status == pdPASS;
+      &task_handle,
+      task_core());
+  return create_status == pdPASS && set_task_handle(task_handle);
 }
@@ -35,11 +35,28 @@
 
 class TaskWithActionH : public BaseTaskWithAction {
 public:
+  /**
+   * Creates and configures a TaskWithActionH instance. Note that the newly
+   * created task will NOT be running. Invoke start() to run the task.
+   *
+   * Parameters
+   *
+   * Name           Contents
+   * -------------- -------------------------------------------------------
+   * name           Task name to display in error messages.
+   * priority       Task priority, see TaskWithAction
+   * action         Contains the code for the task to run.
+   * stack_size     Number of bytes of stack storage to allocate
+   * core           The core that runs the task, 0 or 1 on a dual core
+   *                ESP32, or tskNO_AFFINITY, the default, to let the
+   *                scheduler run the task on any core.
+   */
   TaskWithActionH(
       const char *name,
       const UBaseType_t priority,
       TaskAction *action,
-      const size_t stack_size);
+      const size_t stack_size,
+      const BaseType_t core = tskNO_AFFINITY);
   virtual ~TaskWithActionH();
 
   /**
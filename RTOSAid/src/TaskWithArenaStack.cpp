@@ -0,0 +1,92 @@
+/*
+ * TaskWithArenaStack.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TaskWithArenaStack.h"
+
+#include <cstring>
+
+TaskWithArenaStack::TaskWithArenaStack(
+    const char *name,
+    const UBaseType_t priority,
+    TaskAction *action,
+    TaskStackArena& arena,
+    const size_t stack_size,
+    const BaseType_t core) :
+      BaseTaskWithAction(
+          action,
+          name,
+          priority,
+          stack_size,
+          core),
+      arena(arena),
+      stack(NULL),
+      finished_task(NULL) {
+  std::memset(&task_buffer, 0, sizeof(task_buffer));
+}
+
+TaskWithArenaStack::~TaskWithArenaStack() {
+  stop();
+  delete_finished_task();
+  arena.release(stack);
+}
+
+void TaskWithArenaStack::delete_finished_task(void) {
+  TaskHandle_t task = finished_task.exchange(NULL);
+  if (task) {
+    // The task parks itself right after it retires. Let it finish
+    // parking, since a task that is not running on either core is
+    // deleted on the spot.
+    while (eTaskGetState(task) != eSuspended) {
+      vTaskDelay(1);
+    }
+    vTaskDelete(task);
+  }
+}
+
+void TaskWithArenaStack::finish_task(void) {
+  finished_task.store(xTaskGetCurrentTaskHandle());
+  retire_task();
+  for (;;) {
+    vTaskSuspend(NULL);
+  }
+}
+
+bool TaskWithArenaStack::start(void) {
+  delete_finished_task();
+  if (!stack) {
+    stack = arena.acquire(task_stack_size());
+  }
+  if (!stack) {
+    return false;
+  }
+  prepare_to_start(stack);
+  return set_task_handle(xTaskCreateStaticPinnedToCore(
+      run_task_loop,
+      task_name(),
+      task_stack_size(),
+      this,
+      task_priority(),
+      static_cast<StackType_t *>(stack),
+      &task_buffer,
+      task_core()));
+}
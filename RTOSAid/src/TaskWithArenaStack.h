@@ -0,0 +1,111 @@
+/*
+ * TaskWithArenaStack.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A task that runs a TaskAction on a stack acquired from a TaskStackArena.
+ * The task acquires its stack when it first starts and keeps it, along with
+ * its task control block, until the TaskWithArenaStack is destroyed, so a
+ * task that is stopped and restarted any number of times makes no heap
+ * allocations.
+ *
+ * When the action's run() returns, the finished task suspends itself
+ * rather than deleting itself. FreeRTOS defers the clean up of a task that
+ * deletes itself to the idle task, and reusing the task's memory before
+ * that happens would corrupt the scheduler. The parked task is deleted,
+ * which takes effect immediately, by the next start() or by the
+ * destructor.
+ *
+ * Stop a TaskWithArenaStack with cancel() and join() rather than stop()
+ * when possible. If stop() deletes the task while it runs on another core,
+ * FreeRTOS defers the clean up as described above.
+ */
+
+#ifndef SRC_TASKWITHARENASTACK_H_
+#define SRC_TASKWITHARENASTACK_H_
+
+#include "Arduino.h"
+#include "BaseTaskWithAction.h"
+#include "TaskAction.h"
+#include "TaskStackArena.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include <atomic>
+
+class TaskWithArenaStack final : public BaseTaskWithAction {
+  TaskStackArena& arena;
+  void *stack;
+  std::atomic<TaskHandle_t> finished_task;  // Parked, awaiting deletion
+  StaticTask_t task_buffer;
+
+  /**
+   * Deletes the parked, finished task, if any, waiting for it to park
+   * if necessary.
+   */
+  void delete_finished_task(void);
+
+protected:
+  virtual void finish_task(void) override;
+
+public:
+
+  /**
+   * Creates and configures a TaskWithArenaStack instance. Note that the
+   * newly created task will NOT be running. Invoke start() to run the task.
+   *
+   * Parameters
+   *
+   * Name           Contents
+   * -------------- -------------------------------------------------------
+   * name           Task name to display in error messages.
+   * priority       Task priority, see TaskWithAction
+   * action         Contains the code for the task to run.
+   * arena          Provides the task's stack
+   * stack_size     Number of bytes of stack storage to acquire
+   * core           The core that runs the task, 0 or 1 on a dual core
+   *                ESP32, or tskNO_AFFINITY, the default, to let the
+   *                scheduler run the task on any core.
+   */
+  TaskWithArenaStack(
+      const char *name,
+      const UBaseType_t priority,
+      TaskAction *action,
+      TaskStackArena& arena,
+      const size_t stack_size,
+      const BaseType_t core = tskNO_AFFINITY);
+
+  /**
+   * Stops the task if it is running, then returns its stack to the arena.
+   */
+  virtual ~TaskWithArenaStack();
+
+  /**
+   * Starts the task, acquiring a stack from the arena if the task does
+   * not already hold one.
+   *
+   * Returns the true if the task started and false if it failed to start,
+   * including when the arena has no suitable stack available.
+   */
+  virtual bool start(void) override;
+};
+
+#endif /* SRC_TASKWITHARENASTACK_H_ */
@@ -0,0 +1,140 @@
+/*
+ * TimerCoalescer.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TimerCoalescer.h"
+
+#include "CriticalSection.h"
+
+#include <string.h>
+
+std::atomic<TimerCoalescer *> TimerCoalescer::shared_coalescer(NULL);
+
+TimerCoalescer::TimerCoalescer(void) :
+    wakeup_count(0),
+    last_expiration_tick(0) {
+  memset(wakeups, 0, sizeof(wakeups));
+  memset(&statistics, 0, sizeof(statistics));
+}
+
+TimerCoalescer::~TimerCoalescer() {
+}
+
+TickType_t TimerCoalescer::coalesce(
+    TickType_t timeout_ticks, TickType_t slack_ticks) {
+  TickType_t now = xTaskGetTickCount();
+  TickType_t earliest = now + timeout_ticks;
+  CriticalSection critical_section(lock);
+  prune(now);
+
+  // Join the soonest wakeup in the window, if there is one.
+  size_t chosen = wakeup_count;
+  for (size_t i = 0; i < wakeup_count; ++i) {
+    if (static_cast<TickType_t>(wakeups[i] - earliest) <= slack_ticks
+        && (chosen == wakeup_count
+            || static_cast<TickType_t>(wakeups[i] - now)
+                < static_cast<TickType_t>(wakeups[chosen] - now))) {
+      chosen = i;
+    }
+  }
+  if (chosen < wakeup_count) {
+    ++statistics.coalesced_starts;
+    return wakeups[chosen] - now;
+  }
+
+  // Otherwise, choose the multiple of the largest power of two that the
+  // window must contain. Any window of slack_ticks + 1 ticks contains a
+  // multiple of every power of two up to that width.
+  TickType_t width = slack_ticks + 1;
+  TickType_t alignment = width
+      ? static_cast<TickType_t>(1) << (31 - __builtin_clz(width))
+      : static_cast<TickType_t>(1) << 31;
+  TickType_t wakeup = (earliest + slack_ticks) & ~(alignment - 1);
+
+  if (wakeup_count < MAX_WAKEUPS) {
+    wakeups[wakeup_count++] = wakeup;
+  } else {
+    // Replace the most distant wakeup, the one least likely to be
+    // joined soon.
+    size_t furthest = 0;
+    for (size_t i = 1; i < wakeup_count; ++i) {
+      if (static_cast<TickType_t>(wakeups[furthest] - now)
+          < static_cast<TickType_t>(wakeups[i] - now)) {
+        furthest = i;
+      }
+    }
+    wakeups[furthest] = wakeup;
+  }
+  ++statistics.aligned_starts;
+  return wakeup - now;
+}
+
+void TimerCoalescer::print(Print& out) {
+  TimerCoalescingStatistics copy;
+  snapshot(&copy);
+  out.printf(
+      "Timer coalescing: %lu expirations, %lu wakeups, %lu saved, "
+      "%lu coalesced and %lu aligned starts.\n",
+      static_cast<unsigned long>(copy.expirations),
+      static_cast<unsigned long>(copy.wakeups),
+      static_cast<unsigned long>(copy.wakeups_saved()),
+      static_cast<unsigned long>(copy.coalesced_starts),
+      static_cast<unsigned long>(copy.aligned_starts));
+}
+
+void TimerCoalescer::prune(TickType_t now) {
+  size_t kept = 0;
+  for (size_t i = 0; i < wakeup_count; ++i) {
+    // Ticks up to and including now have passed. Wakeups lie within
+    // half the tick range of now, so the signed difference tells.
+    if (0 < static_cast<int32_t>(wakeups[i] - now)) {
+      wakeups[kept++] = wakeups[i];
+    }
+  }
+  wakeup_count = kept;
+}
+
+void TimerCoalescer::record_expiration(void) {
+  TickType_t now = xTaskGetTickCount();
+  CriticalSection critical_section(lock);
+  if (!statistics.expirations || now != last_expiration_tick) {
+    ++statistics.wakeups;
+  }
+  last_expiration_tick = now;
+  ++statistics.expirations;
+}
+
+void TimerCoalescer::reset(void) {
+  CriticalSection critical_section(lock);
+  memset(&statistics, 0, sizeof(statistics));
+}
+
+TimerCoalescer& TimerCoalescer::shared(void) {
+  static TimerCoalescer coalescer;
+  shared_coalescer.store(&coalescer, std::memory_order_release);
+  return coalescer;
+}
+
+void TimerCoalescer::snapshot(TimerCoalescingStatistics *snapshot) {
+  CriticalSection critical_section(lock);
+  *snapshot = statistics;
+}
@@ -0,0 +1,166 @@
+/*
+ * TimerCoalescer.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Timer coalescing for OneShotTimerH. Many timeouts, such as watchdogs,
+ * retry back-offs, and LED patterns, can fire a little late without harm,
+ * yet each one wakes the FreeRTOS timer service on a tick of its own. A
+ * timer started with slack may fire up to that many ticks late, and the
+ * coalescer uses the freedom to move it onto a tick that another timer
+ * already wakes the timer service for. When no such tick falls within
+ * the window, the coalescer picks the tick in the window that is a
+ * multiple of the largest possible power of two, so that timers started
+ * independently with similar slack gravitate to the same ticks.
+ *
+ * A coalesced timer never fires early. OneShotTimerH starts it relative
+ * to the tick on which it sends the start command, so it fires within
+ * its slack window unless the starting task is preempted across a tick
+ * between choosing the tick and sending the command.
+ *
+ * The coalescer also counts OneShotTimerH expirations and the distinct
+ * ticks they fire on. Timers that fire on the same tick are handled in a
+ * single timer service wakeup, so the difference is the number of
+ * wakeups saved. The counts include every OneShotTimerH, whether or not
+ * it was started with slack, so compare them with and without slack to
+ * see the reduction.
+ *
+ * OneShotTimerH uses the shared coalescer, which is constructed on first
+ * use, so applications that never start a timer with slack pay nothing
+ * for it. Counting begins when it is constructed: by the first start
+ * with slack, or by the application's first call to shared().
+ *
+ *     watchdog.start_ms(5000, 0, 10);  // 5 seconds, up to 10 ms late
+ *     ...
+ *     TimerCoalescingStatistics statistics;
+ *     TimerCoalescer::shared().snapshot(&statistics);
+ */
+
+#ifndef SRC_TIMERCOALESCER_H_
+#define SRC_TIMERCOALESCER_H_
+
+#include "Arduino.h"
+
+#include "SpinLock.h"
+
+#include "freertos/FreeRTOS.h"
+
+#include <atomic>
+
+struct TimerCoalescingStatistics {
+  uint32_t expirations;       // OneShotTimerH expirations
+  uint32_t wakeups;           // Distinct ticks on which they fired
+  uint32_t coalesced_starts;  // Starts moved onto an already chosen tick
+  uint32_t aligned_starts;    // Starts moved onto a newly chosen tick
+
+  /**
+   * Returns: the number of expirations that shared a wakeup with an
+   *          earlier one.
+   */
+  inline uint32_t wakeups_saved(void) const {
+    return expirations - wakeups;
+  }
+};
+
+class TimerCoalescer final {
+public:
+  // The number of upcoming wakeup ticks that the coalescer remembers.
+  static const size_t MAX_WAKEUPS = 16;
+
+private:
+  // The shared coalescer once it has been constructed, else NULL.
+  static std::atomic<TimerCoalescer *> shared_coalescer;
+
+  SpinLock lock;
+
+  // Ticks chosen for slack timers that have not yet passed. A stopped
+  // timer's tick stays until it passes, which costs nothing but a
+  // missed opportunity.
+  TickType_t wakeups[MAX_WAKEUPS];
+  size_t wakeup_count;
+
+  TickType_t last_expiration_tick;
+  TimerCoalescingStatistics statistics;
+
+  TimerCoalescer(const TimerCoalescer&) = delete;
+  TimerCoalescer& operator=(const TimerCoalescer&) = delete;
+
+  /**
+   * Forgets wakeup ticks that have passed. The caller must hold the
+   * lock.
+   */
+  void prune(TickType_t now);
+
+public:
+  TimerCoalescer(void);
+  ~TimerCoalescer();
+
+  /**
+   * Chooses when a timer with slack should fire.
+   *
+   * Parameters:
+   *
+   * Name          Contents
+   * ------------- ------------------------------------------------------------
+   * timeout_ticks The requested timeout in ticks
+   * slack_ticks   How many ticks late the timer may fire
+   *
+   * Returns: the timeout to start the timer with, which lies in
+   *          [timeout_ticks, timeout_ticks + slack_ticks].
+   */
+  TickType_t coalesce(TickType_t timeout_ticks, TickType_t slack_ticks);
+
+  /**
+   * Prints the statistics on a single line.
+   */
+  void print(Print& out);
+
+  /**
+   * Counts an expiration. OneShotTimerH invokes this from the timer
+   * service task whenever it fires.
+   */
+  void record_expiration(void);
+
+  /**
+   * Zeros the statistics.
+   */
+  void reset(void);
+
+  /**
+   * Returns: the coalescer that OneShotTimerH uses, constructing it on
+   *          first use. Do not invoke from an ISR.
+   */
+  static TimerCoalescer& shared(void);
+
+  /**
+   * Returns: the shared coalescer, or NULL if it has not been
+   *          constructed.
+   */
+  static inline TimerCoalescer *shared_if_constructed(void) {
+    return shared_coalescer.load(std::memory_order_acquire);
+  }
+
+  /**
+   * Copies the statistics.
+   */
+  void snapshot(TimerCoalescingStatistics *snapshot);
+};
+
+#endif /* SRC_TIMERCOALESCER_H_ */
@@ -0,0 +1,241 @@
+/*
+ * TimingWheel.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "TimingWheel.h"
+
+#include "CriticalSection.h"
+
+#include <string.h>
+
+TimingWheel::TimingWheel(uint32_t tick_ms) :
+    PeriodicTaskAction(tick_ms),
+    tick_ms(period() * portTICK_PERIOD_MS),
+    cascading(NULL),
+    expiring(NULL),
+    firing(NULL),
+    advancing_task(NULL),
+    current(0),
+    pending_count(0),
+    fired_count(0) {
+  memset(slots, 0, sizeof(slots));
+}
+
+TimingWheel::~TimingWheel() {
+  // Detach any pending timers so that they do not refer to the wheel.
+  CriticalSection critical_section(lock);
+  for (size_t level = 0; level < LEVELS; ++level) {
+    for (size_t slot = 0; slot < SLOTS; ++slot) {
+      while (WheelTimer *timer = slots[level][slot]) {
+        unlink(*timer);
+      }
+    }
+  }
+}
+
+void TimingWheel::advance(void) {
+  // Only this task changes current, so it may read it without the lock.
+  size_t index = current & SLOT_MASK;
+  {
+    CriticalSection critical_section(lock);
+    advancing_task = xTaskGetCurrentTaskHandle();
+  }
+
+  // When level 0 wraps, bring down the next slot of the level above,
+  // and so on up while those levels wrap as well.
+  if (!index) {
+    for (size_t level = 1; level < LEVELS; ++level) {
+      size_t slot = (current >> (SLOT_BITS * level)) & SLOT_MASK;
+      cascade(level, slot);
+      if (slot) {
+        break;
+      }
+    }
+  }
+
+  {
+    // Everything in the current level 0 slot is due now.
+    CriticalSection critical_section(lock);
+    expiring = slots[0][index];
+    slots[0][index] = NULL;
+    if (expiring) {
+      expiring->link = &expiring;
+    }
+    ++current;
+  }
+
+  // Fire without holding the lock, so that callbacks can start and stop
+  // timers. Take the timers one at a time, as a callback might stop one
+  // that has not fired yet. The firing timer stays attached to the wheel
+  // so that its destructor can wait for the callback to return.
+  for (;;) {
+    WheelTimer *timer = NULL;
+    {
+      CriticalSection critical_section(lock);
+      timer = expiring;
+      if (timer) {
+        firing = timer;
+        unlink(*timer);
+        --pending_count;
+        ++fired_count;
+      }
+    }
+    if (!timer) {
+      break;
+    }
+    timer->on_expiration.apply();
+    {
+      // The callback may have restarted the timer, or destroyed it, in
+      // which case detach() cleared firing.
+      CriticalSection critical_section(lock);
+      if (firing && !firing->link) {
+        firing->wheel = NULL;
+      }
+      firing = NULL;
+    }
+  }
+}
+
+void TimingWheel::cascade(size_t level, size_t slot) {
+  {
+    CriticalSection critical_section(lock);
+    cascading = slots[level][slot];
+    slots[level][slot] = NULL;
+    if (cascading) {
+      cascading->link = &cascading;
+    }
+  }
+  bool more = true;
+  while (more) {
+    CriticalSection critical_section(lock);
+    for (size_t moved = 0; cascading && moved < CASCADE_CHUNK; ++moved) {
+      WheelTimer *timer = cascading;
+      cascading = timer->next;
+      if (cascading) {
+        cascading->link = &cascading;
+      }
+      insert(*timer);
+    }
+    more = cascading;
+  }
+}
+
+void TimingWheel::detach(WheelTimer& timer) {
+  for (;;) {
+    {
+      CriticalSection critical_section(lock);
+      if (unlink(timer)) {
+        --pending_count;
+      }
+      if (firing != &timer) {
+        return;
+      }
+      if (advancing_task == xTaskGetCurrentTaskHandle()) {
+        // Destroyed by a callback. advance() must not touch it again.
+        timer.wheel = NULL;
+        firing = NULL;
+        return;
+      }
+    }
+    vTaskDelay(1);
+  }
+}
+
+void TimingWheel::insert(WheelTimer& timer) {
+  uint32_t delta = timer.expiry - current;
+  uint32_t position = timer.expiry;
+  if (SPAN <= delta) {
+    // Out of range. Park the timer in the farthest top level slot, from
+    // which it is redistributed until its expiry comes in range.
+    position = current + SPAN - 1;
+    delta = SPAN - 1;
+  }
+  size_t level = 0;
+  while (SLOTS << (SLOT_BITS * level) <= delta) {
+    ++level;
+  }
+  link(timer, &slots[level][(position >> (SLOT_BITS * level)) & SLOT_MASK]);
+}
+
+void TimingWheel::link(WheelTimer& timer, WheelTimer **head) {
+  timer.next = *head;
+  if (timer.next) {
+    timer.next->link = &timer.next;
+  }
+  timer.link = head;
+  *head = &timer;
+}
+
+bool TimingWheel::reset(WheelTimer& timer) {
+  CriticalSection critical_section(lock);
+  bool was_pending = timer.link;
+  if (timer.duration != WheelTimer::NEVER_STARTED) {
+    schedule(timer, timer.duration);
+  }
+  return was_pending;
+}
+
+void TimingWheel::schedule(WheelTimer& timer, uint32_t ticks) {
+  if (!unlink(timer)) {
+    ++pending_count;
+  }
+  timer.wheel = this;
+  timer.duration = ticks;
+  timer.expiry = current + ticks;
+  insert(timer);
+}
+
+bool TimingWheel::start_ticks(WheelTimer& timer, uint32_t ticks) {
+  CriticalSection critical_section(lock);
+  bool was_pending = timer.link;
+  schedule(timer, ticks);
+  return was_pending;
+}
+
+bool TimingWheel::stop(WheelTimer& timer) {
+  CriticalSection critical_section(lock);
+  bool was_pending = unlink(timer);
+  if (was_pending) {
+    --pending_count;
+  }
+  return was_pending;
+}
+
+void TimingWheel::tick(void) {
+  advance();
+}
+
+bool TimingWheel::unlink(WheelTimer& timer) {
+  if (!timer.link) {
+    return false;
+  }
+  *timer.link = timer.next;
+  if (timer.next) {
+    timer.next->link = timer.link;
+  }
+  timer.next = NULL;
+  timer.link = NULL;
+  if (firing != &timer) {
+    timer.wheel = NULL;
+  }
+  return true;
+}
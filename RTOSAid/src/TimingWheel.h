@@ -0,0 +1,245 @@
+/*
+ * TimingWheel.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A hierarchical timing wheel, a timer service that runs thousands of
+ * software timers on a single task driven by a single periodic tick.
+ * Every OneShotTimerH and FreeRunningTimerH is a FreeRTOS software timer,
+ * so every start, reset, and stop posts a command to the timer daemon,
+ * which keeps its timers on a sorted list. A TimingWheel starts, resets,
+ * and stops a WheelTimer in constant time by linking it into a slot,
+ * with no queue, no allocation, and no sorting.
+ *
+ * The wheel has LEVELS levels of SLOTS slots. Level 0 holds timers due
+ * within the next SLOTS ticks, one slot per tick. Each level above holds
+ * timers SLOTS times further out, one slot per SLOTS^level ticks. Each
+ * time level 0 wraps, the next slot of the level above is redistributed
+ * to the levels below it, so a timer moves down at most LEVELS - 1 times
+ * before it fires. With 64 slots and 4 levels, the wheel spans 2^24
+ * ticks, about 4.6 hours at 1 millisecond per tick. Longer timers are
+ * parked at the top level and redistributed until they come in range.
+ *
+ * TimingWheel is a PeriodicTaskAction: run it in a TaskWithAction, and
+ * it advances one wheel tick per period, catching up if it falls behind.
+ * Timer callbacks run on that task, without the wheel's lock held, so a
+ * callback may start, reset, or stop any timer, including its own.
+ * Start, reset, and stop are thread-safe and may be invoked from ISRs.
+ * Cancelling the wheel's task stops the wheel. Pending timers stay
+ * pending, and fire once the task is started again.
+ *
+ *   static TimingWheel wheel(1);  // 1 millisecond ticks
+ *   static TaskWithAction wheel_task(
+ *       "Wheel", 10, &wheel, wheel_stack, sizeof(wheel_stack));
+ *
+ *   ConnectionTimeout on_timeout(connection);
+ *   WheelTimer timeout(on_timeout);
+ *   wheel.start_ms(timeout, 30000);
+ *   ...
+ *   wheel.reset(timeout);  // Traffic arrived, restart the countdown
+ *
+ * Timers fire on the first wheel tick at or after their deadline, so
+ * resolution is one tick. A timer started for 0 ticks fires on the next
+ * tick.
+ */
+
+#ifndef SRC_TIMINGWHEEL_H_
+#define SRC_TIMINGWHEEL_H_
+
+#include "Arduino.h"
+
+#include "PeriodicTaskAction.h"
+#include "SpinLock.h"
+#include "WheelTimer.h"
+
+class TimingWheel : public PeriodicTaskAction {
+  friend class WheelTimer;
+
+public:
+  static const size_t SLOT_BITS = 6;
+  static const size_t SLOTS = 1 << SLOT_BITS;
+  static const size_t LEVELS = 4;
+
+  // The longest duration that needs no redistribution beyond the top
+  // level, in wheel ticks.
+  static const uint32_t SPAN = 1UL << (SLOT_BITS * LEVELS);
+
+private:
+  static const uint32_t SLOT_MASK = SLOTS - 1;
+
+  // The most timers redistributed per critical section.
+  static const size_t CASCADE_CHUNK = 16;
+
+  const uint32_t tick_ms;
+  SpinLock lock;
+  WheelTimer *slots[LEVELS][SLOTS];
+
+  // Timers removed from a slot that are being redistributed or fired.
+  // stop() can still unlink them.
+  WheelTimer *cascading;
+  WheelTimer *expiring;
+
+  // The timer whose callback is running, if any, and the task running
+  // advance(). A timer destroyed while its callback runs clears firing.
+  WheelTimer *firing;
+  TaskHandle_t advancing_task;
+
+  uint32_t current;  // The next wheel tick to process
+  uint32_t pending_count;
+  uint32_t fired_count;
+
+  TimingWheel(const TimingWheel&) = delete;
+  TimingWheel& operator=(const TimingWheel&) = delete;
+
+  /**
+   * Removes every timer from a slot above level 0 and links each into
+   * the level that now fits it. Takes the lock for at most CASCADE_CHUNK
+   * timers at a time, so a crowded slot does not hold off other tasks
+   * and interrupts. The caller must not hold the lock.
+   */
+  void cascade(size_t level, size_t slot);
+
+  /**
+   * Detaches a timer that is being destroyed: stops it, and waits for
+   * its callback to return if it is running on another task.
+   */
+  void detach(WheelTimer& timer);
+
+  /**
+   * Links a timer into the slot that fits its expiry. The caller must
+   * hold the lock.
+   */
+  void insert(WheelTimer& timer);
+
+  /**
+   * Links a timer at the head of a list. The caller must hold the lock.
+   */
+  static void link(WheelTimer& timer, WheelTimer **head);
+
+  /**
+   * Starts or restarts a timer. The caller must hold the lock.
+   */
+  void schedule(WheelTimer& timer, uint32_t ticks);
+
+  /**
+   * Unlinks a timer if it is linked, and detaches it from the wheel
+   * unless its callback is running. The caller must hold the lock.
+   *
+   * Returns: true if the timer was linked.
+   */
+  bool unlink(WheelTimer& timer);
+
+protected:
+  /**
+   * Advances the wheel once per period.
+   */
+  virtual void tick(void);
+
+public:
+  /**
+   * Creates a wheel
+   *
+   * Parameters:
+   *
+   * Name     Contents
+   * -------- -----------------------------------------------------------------
+   * tick_ms  Wheel tick in milliseconds, which must be a whole number of
+   *          scheduler ticks. It is the timers' resolution.
+   */
+  TimingWheel(uint32_t tick_ms = 1);
+  virtual ~TimingWheel();
+
+  /**
+   * Processes the next wheel tick, firing every timer that is due. The
+   * wheel's task does this once per period. Applications that drive the
+   * wheel themselves, or tests, can invoke it directly, but only from
+   * one task at a time.
+   */
+  void advance(void);
+
+  /**
+   * Returns: the number of timers that have fired.
+   */
+  inline uint32_t fired(void) const {
+    return fired_count;
+  }
+
+  /**
+   * Returns: the number of wheel ticks processed.
+   */
+  inline uint32_t now(void) const {
+    return current;
+  }
+
+  /**
+   * Returns: the number of pending timers.
+   */
+  inline uint32_t pending(void) const {
+    return pending_count;
+  }
+
+  /**
+   * Restarts a timer with the duration it was last started with, whether
+   * or not it is pending. A timer that was never started is left stopped.
+   *
+   * Returns: true if the timer was pending.
+   */
+  bool reset(WheelTimer& timer);
+
+  /**
+   * Starts a timer, restarting it if it is pending.
+   *
+   * Parameters:
+   *
+   * Name     Contents
+   * -------- -----------------------------------------------------------------
+   * timer    The timer to start
+   * ms       Duration in milliseconds, rounded up to whole wheel ticks
+   *
+   * Returns: true if the timer was pending.
+   */
+  inline bool start_ms(WheelTimer& timer, uint32_t ms) {
+    return start_ticks(timer, (ms + tick_ms - 1) / tick_ms);
+  }
+
+  /**
+   * Starts a timer, restarting it if it is pending.
+   *
+   * Parameters:
+   *
+   * Name     Contents
+   * -------- -----------------------------------------------------------------
+   * timer    The timer to start
+   * ticks    Duration in wheel ticks, less than 2^31
+   *
+   * Returns: true if the timer was pending.
+   */
+  bool start_ticks(WheelTimer& timer, uint32_t ticks);
+
+  /**
+   * Stops a timer, which then does not fire. Does nothing if the timer
+   * is not pending.
+   *
+   * Returns: true if the timer was pending.
+   */
+  bool stop(WheelTimer& timer);
+};
+
+#endif /* SRC_TIMINGWHEEL_H_ */
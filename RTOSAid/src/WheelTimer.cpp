@@ -0,0 +1,45 @@
+/*
+ * WheelTimer.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "WheelTimer.h"
+
+#include "TimingWheel.h"
+
+WheelTimer::WheelTimer(VoidFunction& on_expiration) :
+    on_expiration(on_expiration),
+    wheel(NULL),
+    next(NULL),
+    link(NULL),
+    expiry(0),
+    duration(NEVER_STARTED) {
+}
+
+WheelTimer::~WheelTimer() {
+  // Only this timer's wheel sets wheel, and only it clears a non-NULL
+  // wheel, which it does under its own lock. A non-NULL value can only
+  // be stale in the sense that detach() finds nothing left to do.
+  TimingWheel *current_wheel = wheel;
+  if (current_wheel) {
+    current_wheel->detach(*this);
+  }
+}
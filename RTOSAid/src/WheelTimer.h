@@ -0,0 +1,101 @@
+/*
+ * WheelTimer.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A software timer managed by a TimingWheel. A WheelTimer is a small
+ * node, 24 bytes on the ESP32, that binds a VoidFunction to a wheel
+ * position. It owns no FreeRTOS resources, so an application can keep
+ * one per connection or per CAN ID by the thousand. Start, reset, and
+ * stop it through its TimingWheel.
+ *
+ * A timer may be destroyed while pending; its destructor stops it. If
+ * the timer's callback is running on the wheel's task, the destructor
+ * waits for it to return, unless the destructor runs on the wheel's
+ * task itself, e.g. in the callback. A wheel may be destroyed while
+ * timers are pending on it, which are then stopped, but not while a
+ * timer pending on it is being destroyed. Use a timer with one wheel at
+ * a time.
+ */
+
+#ifndef SRC_WHEELTIMER_H_
+#define SRC_WHEELTIMER_H_
+
+#include "Arduino.h"
+
+#include "VoidFunction.h"
+
+class TimingWheel;
+
+class WheelTimer final {
+  friend class TimingWheel;
+
+  VoidFunction& on_expiration;
+
+  // The wheel that the timer is pending on or whose task is running its
+  // callback, NULL otherwise. Guarded by that wheel's spinlock.
+  TimingWheel *wheel;
+
+  // List links. link points to whatever points to this timer, either a
+  // wheel slot or the previous timer's next field, and is NULL when the
+  // timer is not pending. Guarded by the wheel's spinlock.
+  WheelTimer *next;
+  WheelTimer **link;
+
+  uint32_t expiry;    // Wheel tick at which the timer fires
+  uint32_t duration;  // Most recent duration in wheel ticks, for reset()
+
+  // The duration of a timer that was never started. Durations are less
+  // than 2^31 ticks, so no started timer has it.
+  static const uint32_t NEVER_STARTED = 0xffffffffUL;
+
+  WheelTimer(const WheelTimer&) = delete;
+  WheelTimer& operator=(const WheelTimer&) = delete;
+
+public:
+  /**
+   * Creates a stopped timer
+   *
+   * Parameters:
+   *
+   * Name          Contents
+   * ------------- ------------------------------------------------------------
+   * on_expiration Invoked by the wheel's task when the timer fires. It
+   *               MUST return promptly, as it delays every other timer on
+   *               the wheel.
+   */
+  WheelTimer(VoidFunction& on_expiration);
+
+  /**
+   * Stops the timer if it is pending, and waits for its callback to
+   * return if the wheel's task is running it.
+   */
+  ~WheelTimer();
+
+  /**
+   * Returns: true if the timer is started and has not yet fired or been
+   *          stopped. The value is a snapshot and may be stale.
+   */
+  inline bool pending(void) const {
+    return link;
+  }
+};
+
+#endif /* SRC_WHEELTIMER_H_ */
@@ -0,0 +1,238 @@
+/*
+ * WorkStealingExecutor.cpp
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "WorkStealingExecutor.h"
+
+#include <new>
+
+static const char *worker_names[] = {
+  "StealWorker0",
+  "StealWorker1",
+};
+
+static_assert(
+    WorkStealingExecutor::WORKER_COUNT
+        <= sizeof(worker_names) / sizeof(worker_names[0]),
+    "Add worker names for the additional cores.");
+
+WorkStealingDeque::WorkStealingDeque(void) :
+    capacity(0),
+    front(0),
+    count(0),
+    lock(portMUX_INITIALIZER_UNLOCKED) {
+}
+
+bool WorkStealingDeque::begin(size_t capacity) {
+  slots.reset(new (std::nothrow) VoidFunction *[capacity]);
+  this->capacity = slots ? capacity : 0;
+  front = 0;
+  count = 0;
+  return slots != nullptr;
+}
+
+VoidFunction *WorkStealingDeque::pop_back(void) {
+  VoidFunction *job = NULL;
+  portENTER_CRITICAL(&lock);
+  if (count) {
+    --count;
+    job = slots[(front + count) % capacity];
+  }
+  portEXIT_CRITICAL(&lock);
+  return job;
+}
+
+bool WorkStealingDeque::push_back(VoidFunction *job) {
+  bool pushed = false;
+  portENTER_CRITICAL(&lock);
+  if (count < capacity) {
+    slots[(front + count) % capacity] = job;
+    ++count;
+    pushed = true;
+  }
+  portEXIT_CRITICAL(&lock);
+  return pushed;
+}
+
+size_t WorkStealingDeque::size(void) {
+  portENTER_CRITICAL(&lock);
+  size_t result = count;
+  portEXIT_CRITICAL(&lock);
+  return result;
+}
+
+VoidFunction *WorkStealingDeque::steal_front(void) {
+  VoidFunction *job = NULL;
+  portENTER_CRITICAL(&lock);
+  if (count) {
+    job = slots[front];
+    front = (front + 1) % capacity;
+    --count;
+  }
+  portEXIT_CRITICAL(&lock);
+  return job;
+}
+
+WorkStealingWorkerAction::WorkStealingWorkerAction(
+    WorkStealingExecutor& executor, size_t index) :
+      executor(executor),
+      index(index),
+      idle(false),
+      executed_count(0),
+      stolen_count(0) {
+}
+
+WorkStealingWorkerAction::~WorkStealingWorkerAction() {
+}
+
+void WorkStealingWorkerAction::run(void) {
+  while (!cancelled()) {
+    VoidFunction *job = deque.pop_back();
+    if (!job && (job = executor.steal(index))) {
+      stolen_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (job) {
+      job->apply();
+      executed_count.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    // Announce idleness before the final check so that a submitter that
+    // misses the check is guaranteed to see the flag and notify us.
+    idle.store(true);
+    if (!deque.size() && !executor.work_available(index)) {
+      wait_for_notification();
+    }
+    idle.store(false);
+  }
+}
+
+WorkStealingExecutor::WorkStealingExecutor(
+    UBaseType_t priority,
+    size_t stack_size,
+    size_t deque_capacity) :
+      priority(priority),
+      stack_size(stack_size),
+      deque_capacity(deque_capacity),
+      started(false) {
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+  stop_workers();
+}
+
+bool WorkStealingExecutor::begin(void) {
+  if (started.load()) {
+    return false;
+  }
+  for (size_t i = 0; i < WORKER_COUNT; ++i) {
+    actions[i] = std::make_unique<WorkStealingWorkerAction>(*this, i);
+    if (!actions[i]->deque.begin(deque_capacity)) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < WORKER_COUNT; ++i) {
+    workers[i] = std::make_unique<TaskWithActionH>(
+        worker_names[i],
+        priority,
+        actions[i].get(),
+        stack_size,
+        static_cast<BaseType_t>(i));
+    if (!workers[i]->start()) {
+      stop_workers();
+      return false;
+    }
+  }
+  started.store(true);
+  return true;
+}
+
+uint32_t WorkStealingExecutor::executed_count(size_t worker) const {
+  return actions[worker]
+      ? actions[worker]->executed_count.load(std::memory_order_relaxed)
+      : 0;
+}
+
+size_t WorkStealingExecutor::pending_job_count(void) {
+  size_t result = 0;
+  for (size_t i = 0; i < WORKER_COUNT; ++i) {
+    if (actions[i]) {
+      result += actions[i]->deque.size();
+    }
+  }
+  return result;
+}
+
+VoidFunction *WorkStealingExecutor::steal(size_t thief) {
+  VoidFunction *job = NULL;
+  for (size_t i = 1; !job && i < WORKER_COUNT; ++i) {
+    job = actions[(thief + i) % WORKER_COUNT]->deque.steal_front();
+  }
+  return job;
+}
+
+uint32_t WorkStealingExecutor::stolen_count(size_t worker) const {
+  return actions[worker]
+      ? actions[worker]->stolen_count.load(std::memory_order_relaxed)
+      : 0;
+}
+
+void WorkStealingExecutor::stop_workers(void) {
+  started.store(false);
+  for (size_t i = 0; i < WORKER_COUNT; ++i) {
+    if (workers[i]) {
+      workers[i]->cancel();
+      workers[i]->join();
+      workers[i].reset();
+    }
+  }
+}
+
+bool WorkStealingExecutor::submit(VoidFunction *job) {
+  if (!started.load()) {
+    return false;
+  }
+  size_t home = static_cast<size_t>(xPortGetCoreID()) % WORKER_COUNT;
+  size_t target = home;
+  bool submitted = actions[home]->deque.push_back(job);
+  for (size_t i = 1; !submitted && i < WORKER_COUNT; ++i) {
+    target = (home + i) % WORKER_COUNT;
+    submitted = actions[target]->deque.push_back(job);
+  }
+  if (submitted) {
+    workers[target]->notify();
+    for (size_t i = 0; i < WORKER_COUNT; ++i) {
+      if (i != target && actions[i]->idle.load()) {
+        workers[i]->notify();
+      }
+    }
+  }
+  return submitted;
+}
+
+bool WorkStealingExecutor::work_available(size_t excluded) {
+  bool result = false;
+  for (size_t i = 0; !result && i < WORKER_COUNT; ++i) {
+    result = i != excluded && actions[i]->deque.size();
+  }
+  return result;
+}
@@ -0,0 +1,239 @@
+/*
+ * WorkStealingExecutor.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Runs short jobs on all of the ESP32's cores without creating a task per
+ * job. The executor starts one worker task per core, each pinned to its
+ * core and each with its own double ended queue (deque) of pending jobs.
+ * Jobs, VoidFunction instances, are submitted to the deque of the
+ * submitting task's core. A worker runs jobs from the back of its own
+ * deque and, when that is empty, steals jobs from the front of the other
+ * workers' deques, so work spreads across cores even when all of it is
+ * submitted from one of them. Idle workers wait for a task notification
+ * and consume no CPU.
+ *
+ * Deques are guarded by spinlocks held for a few instructions. Jobs MUST
+ * return promptly, and MUST NOT block for long, as a blocked job stalls
+ * its worker. The executor does not guarantee execution order.
+ *
+ * Typical use:
+ *
+ *   static WorkStealingExecutor executor(5, 4096, 16);
+ *
+ *   void setup() {
+ *     executor.begin();
+ *     ...
+ *   }
+ *
+ *   ...
+ *   executor.submit(&some_job);  // some_job is a VoidFunction
+ */
+
+#ifndef SRC_WORKSTEALINGEXECUTOR_H_
+#define SRC_WORKSTEALINGEXECUTOR_H_
+
+#include "Arduino.h"
+
+#include "TaskAction.h"
+#include "TaskWithActionH.h"
+#include "VoidFunction.h"
+
+#include <atomic>
+#include <memory>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+class WorkStealingExecutor;
+
+/**
+ * A bounded, spinlock-guarded deque of pending jobs. The owning worker
+ * pushes and pops at the back; other workers steal from the front.
+ */
+class WorkStealingDeque final {
+  std::unique_ptr<VoidFunction *[]> slots;
+  size_t capacity;
+  size_t front;
+  size_t count;
+  portMUX_TYPE lock;
+
+public:
+  WorkStealingDeque(void);
+
+  /**
+   * Allocates storage for the specified number of jobs.
+   *
+   * Returns: true if storage was allocated, false otherwise.
+   */
+  bool begin(size_t capacity);
+
+  /**
+   * Removes the most recently added job.
+   *
+   * Returns: the job, or NULL if the deque is empty.
+   */
+  VoidFunction *pop_back(void);
+
+  /**
+   * Adds a job at the back of the deque.
+   *
+   * Returns: true if the job was added, false if the deque is full.
+   */
+  bool push_back(VoidFunction *job);
+
+  /**
+   * Returns: the number of pending jobs.
+   */
+  size_t size(void);
+
+  /**
+   * Removes the least recently added job.
+   *
+   * Returns: the job, or NULL if the deque is empty.
+   */
+  VoidFunction *steal_front(void);
+};
+
+/**
+ * The logic that a worker task runs.
+ */
+class WorkStealingWorkerAction final : public TaskAction {
+  friend class WorkStealingExecutor;
+
+  WorkStealingExecutor& executor;
+  const size_t index;
+  WorkStealingDeque deque;
+  std::atomic<bool> idle;
+  std::atomic<uint32_t> executed_count;
+  std::atomic<uint32_t> stolen_count;
+
+public:
+  WorkStealingWorkerAction(WorkStealingExecutor& executor, size_t index);
+  virtual ~WorkStealingWorkerAction();
+
+  virtual void run(void);
+};
+
+class WorkStealingExecutor final {
+  friend class WorkStealingWorkerAction;
+
+public:
+  static const size_t WORKER_COUNT = portNUM_PROCESSORS;
+
+private:
+  const UBaseType_t priority;
+  const size_t stack_size;
+  const size_t deque_capacity;
+
+  // Workers are declared after their actions so that they are destroyed,
+  // and their tasks deleted, first.
+  std::unique_ptr<WorkStealingWorkerAction> actions[WORKER_COUNT];
+  std::unique_ptr<TaskWithActionH> workers[WORKER_COUNT];
+
+  // Set once every worker has started, cleared before any is stopped.
+  std::atomic<bool> started;
+
+  /**
+   * Steals a job from a worker other than the specified thief.
+   *
+   * Returns: the stolen job, or NULL if there is nothing to steal.
+   */
+  VoidFunction *steal(size_t thief);
+
+  /**
+   * Cancels, joins, and releases whichever workers exist.
+   */
+  void stop_workers(void);
+
+  /**
+   * Returns: true if any worker other than the specified one has
+   *          pending jobs.
+   */
+  bool work_available(size_t excluded);
+
+public:
+  /**
+   * Constructor
+   *
+   * Parameters:
+   *
+   * Name            Contents
+   * --------------- --------------------------------------------------------
+   * priority        Worker task priority
+   * stack_size      Worker task stack size in bytes. Jobs run on the worker
+   *                 stacks, so size them for the most demanding job.
+   * deque_capacity  The maximum number of pending jobs per worker
+   */
+  WorkStealingExecutor(
+      UBaseType_t priority,
+      size_t stack_size,
+      size_t deque_capacity);
+
+  /**
+   * Cancels the workers and waits for each to finish its current job.
+   * Pending jobs are discarded. Must not run concurrently with submit().
+   */
+  ~WorkStealingExecutor();
+
+  /**
+   * Allocates the deques and starts one worker task per core. If any
+   * worker fails to start, the workers that did start are stopped, and
+   * begin() may be invoked again.
+   *
+   * Returns: true if all workers started, false otherwise.
+   */
+  bool begin(void);
+
+  /**
+   * Returns: the number of jobs that the specified worker has run.
+   */
+  uint32_t executed_count(size_t worker) const;
+
+  /**
+   * Returns: the number of jobs waiting to run.
+   */
+  size_t pending_job_count(void);
+
+  /**
+   * Returns: the number of jobs that the specified worker has stolen
+   *          from other workers.
+   */
+  uint32_t stolen_count(size_t worker) const;
+
+  /**
+   * Submits a job for execution. The job goes to the worker that runs
+   * on the caller's core, or to another worker if that worker's deque
+   * is full. The job will run once.
+   *
+   * Parameters:
+   *
+   * Name  Contents
+   * ----- -------------------------------------------------------------------
+   * job   The job to run, which must remain valid until it has run.
+   *       Submit a job again to run it again.
+   *
+   * Returns: true if the job was accepted, false if every deque is full
+   *          or if the executor has not started.
+   */
+  bool submit(VoidFunction *job);
+};
+
+#endif /* SRC_WORKSTEALINGEXECUTOR_H_ */
@@ -0,0 +1,118 @@
+/*
+ * WriteLock.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Locks a ReadWriteMutex for writing, with the target mutex specified at
+ * construction. The user has the option of waiting forever or to specify a
+ * timeout interval. A WriteLock holds the mutex exclusively: no other
+ * WriteLock or ReadLock can hold it at the same time.
+ *
+ * As with MutexLock, instances MUST be automatic variables, meaning that
+ * they MUST NOT be created via the new operator or be declared as class
+ * fields, so that the lock is released when the instance goes out of scope.
+ * Applications MUST NOT inherit from this class, which is why it's declared
+ * final.
+ *
+ * Note that importing ReadWriteMutex.h also imports this file.
+ */
+
+#ifndef SRC_WRITELOCK_H_
+#define SRC_WRITELOCK_H_
+
+#include "Arduino.h"
+
+class ReadWriteMutex;
+
+#include <new>
+
+class WriteLock final {
+  ReadWriteMutex &mutex;
+  bool lock_successful;
+
+  WriteLock(WriteLock *) = delete;
+  WriteLock(const WriteLock *) = delete;
+  WriteLock(WriteLock&) = delete;
+  WriteLock(const WriteLock&) = delete;
+  WriteLock(WriteLock&&) = delete;
+  WriteLock(const WriteLock&&) = delete;
+  WriteLock& operator=(WriteLock&) = delete;
+  WriteLock& operator=(const WriteLock&) = delete;
+
+  /**
+   * Hiding the new and delete operators prevents allocation on the heap.
+   * See MutexLock.
+   */
+  void* operator new  (std::size_t count) { return NULL; }
+  void* operator new[](std::size_t count) { return NULL; }
+  void* operator new  (
+      std::size_t count, const std::nothrow_t& tag) { return NULL; }
+  void* operator new[](
+      std::size_t count, const std::nothrow_t& tag) { return NULL; }
+
+  void operator delete  (void* ptr) {}
+  void operator delete[](void* ptr) {}
+  void operator delete  (void* ptr, const std::nothrow_t& tag) {}
+  void operator delete[](void* ptr, const std::nothrow_t& tag) {}
+  void operator delete  (void* ptr, std::size_t sz) {}
+  void operator delete[](void* ptr, std::size_t sz) {}
+
+public:
+  /**
+   * Locks the specified ReadWriteMutex for writing, waiting as long as it
+   * takes.
+   *
+   * Parameters:
+   *
+   * Name   Contents
+   * ------ -----------------------------------------------------------------
+   * mutex  The ReadWriteMutex to lock
+   */
+  WriteLock(ReadWriteMutex &mutex);
+
+  /**
+   * Locks the specified ReadWriteMutex for writing. Since locking can
+   * time out, users should ensure that succeeded() returns true before
+   * proceeding.
+   *
+   * Parameters:
+   *
+   * Name                 Contents
+   * -------------------- ---------------------------------------------------
+   * mutex                The ReadWriteMutex to lock
+   * wait_time_in_millis  The maximum number of milliseconds to wait to
+   *                      lock the specified mutex. If the lock cannot be
+   *                      acquired before the specified deadline, the
+   *                      lock attempt fails.
+   */
+  WriteLock(ReadWriteMutex &mutex, uint32_t wait_time_in_millis);
+
+  /**
+   * Unlocks the mutex. Does nothing if the lock failed.
+   */
+  ~WriteLock();
+
+  /**
+   * Returns true if and only if the mutex was locked successfully.
+   */
+  inline bool succeeded() { return lock_successful; }
+};
+
+#endif /* SRC_WRITELOCK_H_ */
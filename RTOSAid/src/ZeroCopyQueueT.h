@@ -0,0 +1,164 @@
+/*
+ * ZeroCopyQueueT.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: Eric Mintz
+ *
+ * Copyright (C) 2026 Eric Mintz
+ * All Rights Reserved
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * A FIFO queue that carries large messages between tasks without copying
+ * them. Messages live in blocks drawn from an embedded BlockPool; only
+ * block pointers pass through the underlying PullQueueT, so the cost of
+ * sending and receiving a message does not depend on its size.
+ *
+ * Typical use:
+ *
+ * 1. The producer invokes allocate() to obtain a block, fills it in
+ *    place, and invokes send_message() or send_message_from_ISR().
+ * 2. The consumer invokes pull_message() to receive the block, uses
+ *    it, and invokes release() to return it to the pool.
+ *
+ * The queue can hold as many messages as the pool has blocks, so sending
+ * an allocated block can only fail if the queue has not been started.
+ * A producer that does not send an allocated block must release it.
+ */
+
+#ifndef SRC_ZEROCOPYQUEUET_H_
+#define SRC_ZEROCOPYQUEUET_H_
+
+#include "Arduino.h"
+
+#include "BlockPool.h"
+#include "PullQueueT.h"
+
+template <class T, size_t N> class ZeroCopyQueueT final {
+  BlockPool<T, N> pool;
+  T *queue_storage[N];
+  PullQueueT<T *> queue;
+
+public:
+  ZeroCopyQueueT(void) :
+      queue(queue_storage, N) {
+  }
+
+  ~ZeroCopyQueueT() {}
+
+  /**
+   * Allocates a block for a message. Safe to invoke from tasks and ISRs.
+   *
+   * Returns: an uninitialized block, or NULL if all blocks are in use.
+   */
+  inline T *allocate(void) {
+    return pool.allocate();
+  }
+
+  /**
+   * Returns: the number of blocks that can be allocated.
+   */
+  inline size_t available_blocks(void) const {
+    return pool.available();
+  }
+
+  /**
+   * Start the queue and make it available to transport messages.
+   *
+   * Returns: true if the queue started successfully, false otherwise.
+   */
+  inline bool begin(void) {
+    return queue.begin();
+  }
+
+  /**
+   * Receives the oldest message, waiting the maximum allowable time for
+   * one to arrive. The caller owns the received block and MUST release()
+   * it when done.
+   *
+   * Parameters:
+   *
+   * Name     Contents
+   * -------- ----------------------------------------------------------------
+   * block    Receives the message block, if one arrived.
+   *
+   * Returns: true if a message arrived, false otherwise
+   */
+  inline bool pull_message(T **block) {
+    return queue.pull_message(block);
+  }
+
+  /**
+   * Receives the oldest message, waiting the specified time for one to
+   * arrive. The caller owns the received block and MUST release() it when
+   * done.
+   *
+   * Parameters:
+   *
+   * Name        Contents
+   * ----------  --------------------------------------------------------------
+   * block       Receives the message block, if one arrived.
+   * max_wait_ms The maximum number of milliseconds to wait.
+   *
+   * Returns: true if a message arrived, false otherwise
+   */
+  inline bool pull_message(T **block, uint32_t max_wait_ms) {
+    return queue.pull_message(block, max_wait_ms);
+  }
+
+  /**
+   * Returns a received (or allocated but unsent) block to the pool. Safe to
+   * invoke from tasks and ISRs.
+   */
+  inline void release(T *block) {
+    pool.release(block);
+  }
+
+  /**
+   * Sends an allocated block to the consumer. The sender MUST NOT touch
+   * the block afterward.
+   *
+   * Returns: true if the block was sent, false otherwise.
+   */
+  inline bool send_message(T *block) {
+    return queue.send_message(&block);
+  }
+
+  /**
+   * Sends an allocated block from an interrupt service routine (ISR),
+   * yielding if a higher priority task is awakened. The ISR MUST NOT
+   * touch the block afterward.
+   *
+   * Returns: true if the block was sent, false otherwise.
+   */
+  inline bool send_message_from_ISR(T *block) {
+    return queue.send_message_from_ISR(&block);
+  }
+
+  /**
+   * Returns true if the queue is valid and can be used or false otherwise.
+   */
+  inline bool valid(void) const {
+    return queue.valid();
+  }
+
+  /**
+   * Returns the number of waiting messages if the queue is valid.
+   */
+  inline UBaseType_t waiting_message_count(void) const {
+    return queue.waiting_message_count();
+  }
+};
+
+#endif /* SRC_ZEROCOPYQUEUET_H_ */